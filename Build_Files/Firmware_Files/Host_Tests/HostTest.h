@@ -0,0 +1,104 @@
+/*
+* File: HostTest.h
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks, trace loading and the firmware globals shared by the host tests.
+// Include once per test program, before the firmware headers under test.
+
+#ifndef _HOST_TEST_H
+#define _HOST_TEST_H
+
+#include <Arduino.h>
+#include <vector>
+#include "LSConfig.h"
+#include "LSUtils.h"
+#include "LSBusLock.h"
+
+// Globals the firmware headers expect from Willow_Firmware.ino
+int g_operatingMode = CONF_OPERATING_MODE_MOUSE;
+LSBusLock g_i2cBusLock;
+
+static int g_hostCheckCount = 0;
+static int g_hostFailCount = 0;
+
+// Record a check. Failures are printed with their location and the program exits non-zero from hostTestResult().
+#define HOST_CHECK(condition) hostCheck((condition), #condition, __FILE__, __LINE__)
+
+// Record a check of two values within tolerance
+#define HOST_CHECK_NEAR(value, expected, tolerance) \
+  hostCheckNear((double)(value), (double)(expected), (double)(tolerance), #value, __FILE__, __LINE__)
+
+inline bool hostCheck(bool condition, const char* text, const char* file, int line) {
+  g_hostCheckCount++;
+  if (!condition) {
+    g_hostFailCount++;
+    printf("FAIL %s:%d: %s\n", file, line, text);
+  }
+  return condition;
+}
+
+inline bool hostCheckNear(double value, double expected, double tolerance, const char* text, const char* file, int line) {
+  g_hostCheckCount++;
+  if (!(fabs(value - expected) <= tolerance)) {
+    g_hostFailCount++;
+    printf("FAIL %s:%d: %s = %g, expected %g +/- %g\n", file, line, text, value, expected, tolerance);
+    return false;
+  }
+  return true;
+}
+
+// Print the summary and get the exit code of the test program
+inline int hostTestResult(const char* testName) {
+  printf("%s: %d checks, %d failed\n", testName, g_hostCheckCount, g_hostFailCount);
+  return (g_hostFailCount == 0) ? 0 : 1;
+}
+
+// One raw sensor reading of a trace
+typedef struct {
+  unsigned long sampleTime;             // micros() when the reading was taken
+  pointFloatType point;                 // Raw x and y (mT)
+  float temperature;                    // Sensor temperature (C)
+} hostTraceSample;
+
+// Load a trace file with one "time_us,x_mT,y_mT,temperature_C" reading per line. Lines starting with # are comments.
+// Returns false if the file can't be read or has no readings.
+inline bool hostLoadTrace(const char* fileName, std::vector<hostTraceSample>& trace) {
+  FILE* traceFile = fopen(fileName, "r");
+  if (traceFile == NULL) {
+    return false;
+  }
+  trace.clear();
+  char line[128];
+  while (fgets(line, sizeof(line), traceFile) != NULL) {
+    hostTraceSample sample;
+    if (line[0] == '#') {
+      continue;
+    }
+    if (sscanf(line, "%lu,%f,%f,%f", &sample.sampleTime, &sample.point.x, &sample.point.y, &sample.temperature) == 4) {
+      trace.push_back(sample);
+    }
+  }
+  fclose(traceFile);
+  return !trace.empty();
+}
+
+// Deterministic pseudo random value in [-1, 1] (same generator as the on-device tests)
+inline float hostRandom(unsigned long* seed) {
+  *seed = (*seed * 1103515245UL) + 12345UL;
+  return ((float)((*seed >> 16) & 0xFFFF) / 32767.5f) - 1.0f;
+}
+
+#endif
@@ -0,0 +1,182 @@
+/*
+* File: Arduino.h
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Minimal Arduino, FreeRTOS and nRF52840 register shim so the firmware headers compile on Linux.
+// Time is simulated: micros() and millis() return g_hostMicros, and delay() advances it.
+// Peripheral registers are plain structs that the tests can inspect or set.
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+
+using std::abs;
+using std::min;
+using std::max;
+using std::round;
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+//***TIME***//
+extern unsigned long g_hostMicros;       // Simulated micros(), defined in HostShims.cpp
+
+inline unsigned long micros() { return g_hostMicros; }
+inline unsigned long millis() { return g_hostMicros / 1000UL; }
+inline void delay(unsigned long ms) { g_hostMicros += ms * 1000UL; }
+inline void delayMicroseconds(unsigned int us) { g_hostMicros += us; }
+
+//***SERIAL***//
+class String : public std::string {
+  public:
+    String() {}
+    String(const char* s) : std::string(s) {}
+    String(const std::string& s) : std::string(s) {}
+    String(int value) : std::string(std::to_string(value)) {}
+};
+
+class HostSerial {
+  public:
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    template<class T> void print(T) {}
+    template<class T> void print(T, int) {}
+    template<class T> void println(T) {}
+    template<class T> void println(T, int) {}
+    void println() {}
+    explicit operator bool() const { return true; }
+};
+extern HostSerial Serial;
+
+#define USB_DEBUG 0
+
+//***GPIO***//
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+extern int g_hostPinLevel[64];          // Level read by digitalRead(), set by digitalWrite() or the test
+extern int g_hostPinToggles[64];        // Number of level changes written to each pin
+extern bool g_hostPinHeldLow[64];       // A device holds the (open drain) line low, set by the test
+inline void digitalWrite(uint32_t pin, uint32_t level) {
+  if (g_hostPinLevel[pin] != (int)level) {
+    g_hostPinToggles[pin]++;
+  }
+  g_hostPinLevel[pin] = level;
+}
+inline void pinMode(uint32_t pin, uint32_t mode) {
+  if (mode == INPUT_PULLUP) {           // Released line pulled high
+    digitalWrite(pin, HIGH);
+  }
+}
+inline int digitalRead(uint32_t pin) { return g_hostPinHeldLow[pin] ? LOW : g_hostPinLevel[pin]; }
+
+//***FREERTOS***//
+typedef void* SemaphoreHandle_t;
+typedef void* TaskHandle_t;
+typedef long BaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define pdMS_TO_TICKS(ms) (ms)
+#define TASK_PRIO_LOW 1
+#define TASK_PRIO_NORMAL 2
+#define TASK_PRIO_HIGH 3
+#define portYIELD_FROM_ISR(woken) (void)(woken)
+
+extern int g_hostSemaphoreCount;        // Semaphores and mutexes created
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { static int mutex[16]; return &mutex[g_hostSemaphoreCount++ % 16]; }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { static int binary[16]; return &binary[g_hostSemaphoreCount++ % 16]; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t, BaseType_t*) { return pdTRUE; }
+inline BaseType_t xTaskCreate(void (*)(void*), const char*, uint32_t, void*, int, TaskHandle_t* handle) { static int task; *handle = &task; return pdPASS; }
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 1; }
+inline void xTaskNotifyGive(TaskHandle_t) {}
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*) {}
+
+//***NRF52840 REGISTERS***//
+struct HostTimerRegisters {
+  volatile uint32_t TASKS_START, TASKS_STOP, TASKS_CLEAR, MODE, BITMODE, PRESCALER, CC[6], SHORTS, INTENSET, INTENCLR, EVENTS_COMPARE[6];
+};
+struct HostTwimRegisters {
+  volatile uint32_t ENABLE, FREQUENCY, ADDRESS, SHORTS, INTENSET, INTENCLR, ERRORSRC, EVENTS_STOPPED, EVENTS_ERROR, TASKS_STARTRX, TASKS_STOP;
+  struct { volatile uint32_t SCL, SDA; } PSEL;
+  struct { volatile uint32_t PTR, MAXCNT, AMOUNT; } RXD;
+};
+struct HostCoreDebugRegisters { volatile uint32_t DEMCR; };
+struct HostDwtRegisters { volatile uint32_t CTRL, CYCCNT; };
+
+extern HostTimerRegisters g_hostTimer4;
+extern HostTwimRegisters g_hostTwim0, g_hostTwim1;
+extern HostCoreDebugRegisters g_hostCoreDebug;
+extern HostDwtRegisters g_hostDwt;
+
+#define NRF_TIMER4 (&g_hostTimer4)
+#define NRF_TWIM0 (&g_hostTwim0)
+#define NRF_TWIM1 (&g_hostTwim1)
+#define CoreDebug (&g_hostCoreDebug)
+#define DWT (&g_hostDwt)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+#define DWT_CTRL_CYCCNTENA_Msk 1UL
+#define F_CPU 64000000UL
+extern uint32_t SystemCoreClock;
+
+#define TIMER4_IRQn 0
+#define SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn 1
+#define TIMER_MODE_MODE_Timer 0
+#define TIMER_BITMODE_BITMODE_32Bit 3
+#define TIMER_SHORTS_COMPARE0_CLEAR_Msk 1
+#define TIMER_INTENSET_COMPARE0_Msk (1UL << 16)
+#define TIMER_INTENCLR_COMPARE0_Msk (1UL << 16)
+#define TWIM_ENABLE_ENABLE_Disabled 0
+#define TWIM_ENABLE_ENABLE_Enabled 6
+#define TWIM_FREQUENCY_FREQUENCY_K100 0x01980000UL
+#define TWIM_FREQUENCY_FREQUENCY_K250 0x04000000UL
+#define TWIM_FREQUENCY_FREQUENCY_K400 0x06400000UL
+#define TWIM_SHORTS_LASTRX_STOP_Msk (1UL << 12)
+#define TWIM_INTENSET_STOPPED_Msk (1UL << 1)
+#define TWIM_INTENSET_ERROR_Msk (1UL << 9)
+#define TWIM_INTENCLR_STOPPED_Msk (1UL << 1)
+#define TWIM_INTENCLR_ERROR_Msk (1UL << 9)
+#define WIRE_INTERFACES_COUNT 1
+
+inline void NVIC_SetPriority(int, uint32_t) {}
+inline void NVIC_ClearPendingIRQ(int) {}
+inline void NVIC_EnableIRQ(int) {}
+inline void NVIC_DisableIRQ(int) {}
+
+extern uint32_t g_ADigitalPinMap[];
+#define PIN_WIRE_SDA 22
+#define PIN_WIRE_SCL 23
+
+#endif
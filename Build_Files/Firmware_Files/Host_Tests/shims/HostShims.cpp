@@ -0,0 +1,36 @@
+/*
+* File: HostShims.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Storage for the state simulated by Arduino.h
+
+#include "Arduino.h"
+
+unsigned long g_hostMicros = 0;
+HostSerial Serial;
+int g_hostPinLevel[64] = {0};
+int g_hostPinToggles[64] = {0};
+bool g_hostPinHeldLow[64] = {false};
+int g_hostSemaphoreCount = 0;
+
+HostTimerRegisters g_hostTimer4;
+HostTwimRegisters g_hostTwim0;
+HostTwimRegisters g_hostTwim1;
+HostCoreDebugRegisters g_hostCoreDebug;
+HostDwtRegisters g_hostDwt;
+uint32_t SystemCoreClock = F_CPU;
+
+uint32_t g_ADigitalPinMap[64] = {0};
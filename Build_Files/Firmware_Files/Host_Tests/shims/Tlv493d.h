@@ -0,0 +1,55 @@
+/*
+* File: Tlv493d.h
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Stub of the Infineon Tlv493d library. updateData() returns the reading and status set by the test,
+// so recorded readings and sensor faults can be fed through LSJoystick::readSensor().
+
+#ifndef _HOST_TLV493D_H
+#define _HOST_TLV493D_H
+
+#define I2CADDR_TLV493D 0x5E
+
+typedef enum Tlv493d_Error {
+  TLV493D_NO_ERROR = 0,
+  TLV493D_BUS_ERROR = 1,
+  TLV493D_FRAME_ERROR = 2
+} Tlv493d_Error_t;
+
+class Tlv493d {
+  public:
+    enum AccessMode_e { POWERDOWNMODE = 0, FASTMODE, LOWPOWERMODE, ULTRALOWPOWERMODE, MASTERCONTROLLEDMODE };
+
+    void begin() { beginCount++; }
+    bool setAccessMode(AccessMode_e) { return true; }
+    Tlv493d_Error_t updateData() { updateCount++; return status; }
+    float getX() { return x; }
+    float getY() { return y; }
+    float getZ() { return z; }
+    float getTemp() { return temperature; }
+
+    void setReading(float readingX, float readingY) { x = readingX; y = readingY; }
+
+    float x = 0.0;                       // Reading returned to the firmware (mT)
+    float y = 0.0;
+    float z = 20.0;
+    float temperature = 25.0;            // (C)
+    Tlv493d_Error_t status = TLV493D_NO_ERROR;
+    int beginCount = 0;                  // Number of begin() calls (sensor resets)
+    int updateCount = 0;                 // Number of updateData() calls
+};
+
+#endif
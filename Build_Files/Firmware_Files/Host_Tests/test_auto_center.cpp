@@ -0,0 +1,183 @@
+/*
+* File: test_auto_center.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks the idle center correction (CONF_JOY_AUTO_CENTER): it corrects at the same pace at any sample rate,
+// follows a resting center without changing the calibration, ignores a finger resting inside the deadzone
+// and works with the temperature model during a warm-up without correcting the same drift twice.
+
+#include "HostTest.h"
+#define private public                   // The temperature readings are published by readSensor()
+#include "LSJoystick.h"
+#undef private
+
+#define CENTER_X 0.5                     // Calibrated center (mT)
+#define CENTER_Y -0.5
+#define CENTER_CORNER 14.0
+#define CENTER_OFFSET_X 0.4              // Resting center moved after calibration (mT)
+#define CENTER_OFFSET_Y -0.3
+#define CENTER_TOUCH_NOISE 0.6           // Largest movement of a finger resting on the joystick (mT)
+#define CENTER_DRIFT_X 0.1               // Simulated center drift (mT per C)
+#define CENTER_DRIFT_Y -0.05
+#define CENTER_WARMUP_TIME 300           // Time to warm up by CENTER_WARMUP_DELTA (s)
+#define CENTER_WARMUP_DELTA 10.0         // (C)
+#define CENTER_ERROR_MAX 0.08            // Largest distance of the corrected center from the resting center in the warm-up (mT)
+
+//***LOAD CALIBRATION FUNCTION***//
+// Function   : loadCalibration
+//
+// Description: Start a joystick with a square calibration around the test center
+//
+// Parameters : js : LSJoystick& : Joystick to set up
+//
+// Return     : void
+//****************************************//
+void loadCalibration(LSJoystick& js) {
+  js.begin();
+  js.setInputMax(0, {CENTER_X, CENTER_Y});
+  js.setInputMax(1, {CENTER_X - CENTER_CORNER, CENTER_Y + CENTER_CORNER});
+  js.setInputMax(2, {CENTER_X + CENTER_CORNER, CENTER_Y + CENTER_CORNER});
+  js.setInputMax(3, {CENTER_X + CENTER_CORNER, CENTER_Y - CENTER_CORNER});
+  js.setInputMax(4, {CENTER_X - CENTER_CORNER, CENTER_Y - CENTER_CORNER});
+  js.setMinimumRadius();
+}
+
+//***REST FUNCTION***//
+// Function   : rest
+//
+// Description: Feed readings of a joystick resting at the moved center
+//
+// Parameters : js : LSJoystick& : Joystick under test
+//              sampleInterval : unsigned long : Time between readings (us)
+//              restTime : unsigned long : Time to rest (us)
+//              touchNoise : float : Largest random movement added to each reading (mT, 0 = untouched)
+//
+// Return     : void
+//****************************************//
+void rest(LSJoystick& js, unsigned long sampleInterval, unsigned long restTime, float touchNoise) {
+  unsigned long noiseSeed = 11;
+  for (unsigned long restIndex = 0; restIndex < restTime / sampleInterval; restIndex++) {
+    g_hostMicros += sampleInterval;
+    js.update({(float)(CENTER_X + CENTER_OFFSET_X + touchNoise * hostRandom(&noiseSeed)),
+               (float)(CENTER_Y + CENTER_OFFSET_Y + touchNoise * hostRandom(&noiseSeed))}, g_hostMicros);
+  }
+}
+
+//***TEST SAMPLE RATE FUNCTION***//
+// Function   : testSampleRate
+//
+// Description: The same rest at 50 Hz and at the firmware rate gives the same correction, one window per JOY_AUTO_CENTER_WINDOW_TIME
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testSampleRate() {
+  const unsigned long restTime = JOY_AUTO_CENTER_IDLE_TIME + 5 * JOY_AUTO_CENTER_WINDOW_TIME + 500000UL;
+  const unsigned long sampleIntervals[] = {1000000UL / 50, 1000000UL / CONF_JOY_SAMPLE_RATE};
+  pointFloatType shift[2];
+  for (int rateIndex = 0; rateIndex < 2; rateIndex++) {
+    LSJoystick js;
+    loadCalibration(js);
+    rest(js, sampleIntervals[rateIndex], restTime, 0.0);
+    shift[rateIndex] = js.getAutoCenterShift();
+  }
+
+  // Five windows at the idle start: each corrects JOY_AUTO_CENTER_GAIN of what is left
+  float expectedX = CENTER_OFFSET_X * (1.0 - pow(1.0 - JOY_AUTO_CENTER_GAIN, 5));
+  printf("sample rate: shift x %.3f at 50 Hz, %.3f at %d Hz, expected %.3f\n", shift[0].x, shift[1].x, CONF_JOY_SAMPLE_RATE, expectedX);
+  HOST_CHECK_NEAR(shift[0].x, expectedX, 0.01);
+  HOST_CHECK_NEAR(shift[1].x, expectedX, 0.01);
+  HOST_CHECK_NEAR(shift[0].y, shift[1].y, 0.01);
+}
+
+//***TEST RESTING CENTER FUNCTION***//
+// Function   : testRestingCenter
+//
+// Description: The corrected center follows a resting joystick while the calibration is kept, and a measured center replaces
+//              the correction. A finger resting on the joystick inside the deadzone is not learned.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testRestingCenter() {
+  LSJoystick js;
+  loadCalibration(js);
+  rest(js, 1000000UL / CONF_JOY_SAMPLE_RATE, 60000000UL, 0.0);
+  pointFloatType center = js.getCompensatedCenter();
+  HOST_CHECK_NEAR(center.x, CENTER_X + CENTER_OFFSET_X, 0.01);
+  HOST_CHECK_NEAR(center.y, CENTER_Y + CENTER_OFFSET_Y, 0.01);
+  HOST_CHECK(js.getInputCenter().x == CENTER_X && js.getInputCenter().y == CENTER_Y);
+
+  js.setInputMax(0, {CENTER_X + CENTER_OFFSET_X, CENTER_Y + CENTER_OFFSET_Y});
+  HOST_CHECK(js.getAutoCenterShift().x == 0.0 && js.getAutoCenterShift().y == 0.0);
+
+  LSJoystick touchedJs;
+  loadCalibration(touchedJs);
+  rest(touchedJs, 1000000UL / CONF_JOY_SAMPLE_RATE, 60000000UL, CENTER_TOUCH_NOISE);
+  HOST_CHECK(touchedJs.getAutoCenterShift().x == 0.0 && touchedJs.getAutoCenterShift().y == 0.0);
+}
+
+//***TEST WARM UP FUNCTION***//
+// Function   : testWarmUp
+//
+// Description: A resting joystick warms up while its center drifts. The temperature model learns the full drift from the
+//              calibrated center, and the corrected center stays on the resting center: the idle correction hands over
+//              what the learned slope explains instead of correcting it a second time.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testWarmUp() {
+  LSJoystick js;
+  loadCalibration(js);
+  unsigned long sampleInterval = 1000000UL / CONF_JOY_SAMPLE_RATE;
+  unsigned long startTime = g_hostMicros;
+  float centerErrorMax = 0.0;
+  for (unsigned long sampleIndex = 0; sampleIndex < CENTER_WARMUP_TIME * 1000000UL / sampleInterval; sampleIndex++) {
+    g_hostMicros += sampleInterval;
+    float temperatureChange = CENTER_WARMUP_DELTA * (g_hostMicros - startTime) / (CENTER_WARMUP_TIME * 1000000.0);
+    if (sampleIndex % (JOY_TEMP_READ_PERIOD / sampleInterval) == 0) {
+      js._sensorTemperature = JOY_SENSOR_TEMP_REFERENCE + temperatureChange;
+      js._temperatureReadCount++;
+    }
+    pointFloatType restPoint;
+    restPoint.x = CENTER_X + CENTER_DRIFT_X * temperatureChange;
+    restPoint.y = CENTER_Y + CENTER_DRIFT_Y * temperatureChange;
+    js.update(restPoint, g_hostMicros);
+
+    pointFloatType center = js.getCompensatedCenter();
+    centerErrorMax = max(centerErrorMax, max(fabsf(center.x - restPoint.x), fabsf(center.y - restPoint.y)));
+  }
+
+  pointFloatType slope = js.getTemperatureSlope();
+  pointFloatType shift = js.getAutoCenterShift();
+  printf("warm-up: slope %.3f|%.3f mT/C, shift %.3f|%.3f mT, largest center error %.3f mT\n", slope.x, slope.y, shift.x, shift.y, centerErrorMax);
+  HOST_CHECK_NEAR(slope.x, CENTER_DRIFT_X, 0.02);
+  HOST_CHECK_NEAR(slope.y, CENTER_DRIFT_Y, 0.02);
+  HOST_CHECK(centerErrorMax <= CENTER_ERROR_MAX);                          // Corrected twice it overshoots by about 0.13 mT
+  HOST_CHECK(fabsf(shift.x) < 0.1 && fabsf(shift.y) < 0.1);                // The slope explains the drift
+}
+
+int main() {
+  testSampleRate();
+  testRestingCenter();
+  testWarmUp();
+
+  return hostTestResult("test_auto_center");
+}
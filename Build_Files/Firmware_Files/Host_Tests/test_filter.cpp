@@ -0,0 +1,115 @@
+/*
+* File: test_filter.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Replays synthetic readings with fixed sample timing through the joystick pipeline and measures the
+// smoothing filter with the default settings:
+// - Rest: the ratio of filtered to raw noise around the center (lower is smoother).
+// - Ramps: the lag of the filtered reading behind ramps of constant speed, in ms.
+// The rest noise ratio has to be at most FILTER_NOISE_RATIO_MAX and the lag at FILTER_FAST_SPEED
+// at most FILTER_LAG_MAX. With the filter off (cutoff 0) the filtered reading follows the input.
+
+#include "HostTest.h"
+#include "LSJoystick.h"
+
+#define FILTER_SAMPLE_INTERVAL 5000      // Time between replayed samples in us (200 Hz)
+#define FILTER_SAMPLE_NUMBER 400         // Number of samples replayed for each speed and for the rest noise
+#define FILTER_FAST_SPEED 130.0          // Full deflection in about 0.1 s (mT/s)
+#define FILTER_LAG_MAX 20.0              // Maximum allowed lag at FILTER_FAST_SPEED in ms
+#define FILTER_NOISE_RATIO_MAX 0.5       // Maximum allowed ratio of filtered to raw noise at rest
+
+LSJoystick js;
+unsigned long sampleTime = 0;
+
+//***MEASURE REST NOISE FUNCTION***//
+// Function   : measureRestNoise
+//
+// Description: Replay noise around the center and compare the filtered to the raw noise.
+//              The first quarter of the samples lets the filter settle.
+//
+// Parameters : void
+//
+// Return     : noiseRatio : float : Filtered rms noise / raw rms noise
+//****************************************//
+float measureRestNoise() {
+  unsigned long noiseSeed = 1;
+  float rawNoiseTotal = 0.0;
+  float filteredNoiseTotal = 0.0;
+
+  js.resetFilter();
+  for (int sampleIndex = 0; sampleIndex < FILTER_SAMPLE_NUMBER; sampleIndex++) {
+    noiseSeed = (noiseSeed * 1103515245UL) + 12345UL;
+    float noise = ((float)((noiseSeed >> 16) & 0xFF) / 255.0 - 0.5) * 0.3;        // +/- 0.15 mT
+    js.update({noise, -noise}, sampleTime);
+    sampleTime += FILTER_SAMPLE_INTERVAL;
+
+    if (sampleIndex >= FILTER_SAMPLE_NUMBER / 4) {
+      rawNoiseTotal += sq(noise);
+      filteredNoiseTotal += sq(js.getXYFiltered().x);
+    }
+  }
+  return (rawNoiseTotal > 0.0) ? sqrt(filteredNoiseTotal / rawNoiseTotal) : 0.0;
+}
+
+//***MEASURE RAMP LAG FUNCTION***//
+// Function   : measureRampLag
+//
+// Description: Replay a ramp at constant speed along x and measure how far the filtered reading is behind it.
+//
+// Parameters : rampSpeed : float : Ramp speed (mT/s)
+//
+// Return     : rampLag : float : Lag behind the ramp at the end (ms)
+//****************************************//
+float measureRampLag(float rampSpeed) {
+  float rampPosition = 0.0;
+  js.resetFilter();
+  for (int sampleIndex = 0; sampleIndex < FILTER_SAMPLE_NUMBER; sampleIndex++) {
+    rampPosition = rampSpeed * sampleIndex * (FILTER_SAMPLE_INTERVAL / 1000000.0);
+    js.update({rampPosition, 0.0}, sampleTime);
+    sampleTime += FILTER_SAMPLE_INTERVAL;
+  }
+  return 1000.0 * (rampPosition - js.getXYFiltered().x) / rampSpeed;
+}
+
+int main() {
+  const float rampSpeeds[] = { 2.0, 20.0, FILTER_FAST_SPEED, 300.0 };   // mT/s
+
+  js.begin();
+  js.setFilterCutoff(CONF_JOY_FILTER_CUTOFF_DEFAULT);
+  js.setFilterBeta(CONF_JOY_FILTER_BETA_DEFAULT);
+
+  float noiseRatio = measureRestNoise();
+  printf("filter cutoff %.2f Hz beta %.2f: rest noise ratio %.3f\n", js.getFilterCutoff(), js.getFilterBeta(), noiseRatio);
+  HOST_CHECK(noiseRatio <= FILTER_NOISE_RATIO_MAX);
+
+  float previousLag = 1e9;
+  for (float rampSpeed : rampSpeeds) {
+    float rampLag = measureRampLag(rampSpeed);
+    printf("  speed %.0f mT/s: lag %.2f ms\n", rampSpeed, rampLag);
+    HOST_CHECK(rampLag >= 0.0 && rampLag <= previousLag);             // Faster movements are followed more closely
+    if (rampSpeed == FILTER_FAST_SPEED) {
+      HOST_CHECK(rampLag <= FILTER_LAG_MAX);
+    }
+    previousLag = rampLag;
+  }
+
+  // Filter off
+  js.setFilterCutoff(CONF_JOY_FILTER_CUTOFF_MIN);
+  HOST_CHECK_NEAR(measureRestNoise(), 1.0, 0.001);
+  HOST_CHECK_NEAR(measureRampLag(FILTER_FAST_SPEED), 0.0, 0.001);
+
+  return hostTestResult("test_filter");
+}
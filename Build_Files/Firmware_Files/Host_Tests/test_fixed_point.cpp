@@ -0,0 +1,163 @@
+/*
+* File: test_fixed_point.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks that the 32 bit fixed-point input and output stages (CONF_JOY_FIXED_POINT_MATH) match the
+// float stages within +/-1 count for several calibrations, with and without a range map, and prints
+// the host time of both versions. Host timing does not say which is faster on the Cortex-M4F.
+
+#include "HostTest.h"
+#define private public                   // The stages under test are private
+#include "LSJoystick.h"
+#undef private
+#include <chrono>
+
+#define FIXED_TOLERANCE 1                // Largest allowed difference from the float stages in counts
+
+LSJoystick js;
+
+// Center x, center y and the four corners relative to the center (mT)
+const float calibrations[][10] = {
+  { 0.5, -0.5, -14.0,  14.0,  14.0,  14.0,  14.0, -14.0, -14.0, -14.0},   // Square
+  { 1.2,  0.4, -10.0,  14.0,  18.0,  12.0,  12.0,  -9.0, -11.0, -10.0},   // Uneven corners
+  {-2.0,  1.0, -25.0,  22.0,  28.0,  26.0,  24.0, -27.0, -23.0, -29.0},   // Strong magnet
+  { 0.0,  0.0,  -3.0,   3.5,   3.2,   3.0,   3.0,  -2.8,  -3.1,  -3.3}    // Weak magnet
+};
+
+//***LOAD CALIBRATION FUNCTION***//
+// Function   : loadCalibration
+//
+// Description: Load a test calibration and mirror the joystick axes like a real board
+//
+// Parameters : calibration : const float* : Center and corners
+//
+// Return     : void
+//****************************************//
+void loadCalibration(const float* calibration) {
+  js.setInputMax(0, {calibration[0], calibration[1]});
+  for (int corner = 1; corner <= 4; corner++) {
+    js.setInputMax(corner, {calibration[0] + calibration[2 * corner], calibration[1] + calibration[2 * corner + 1]});
+  }
+  js.setMinimumRadius();
+  js._joystickXDirection = JOY_DIRECTION_X;
+  js._joystickYDirection = JOY_DIRECTION_Y;
+}
+
+//***CHECK INPUT STAGE FUNCTION***//
+// Function   : checkInputStage
+//
+// Description: Compare processInputReadingFixed with processInputReading on a grid of raw readings
+//
+// Parameters : calibration : const float* : Center and corners
+//
+// Return     : worst : int : Largest difference in counts
+//****************************************//
+int checkInputStage(const float* calibration) {
+  int worst = 0;
+  for (float x = -45.0; x <= 45.0; x += 0.0731) {
+    for (float y = -45.0; y <= 45.0; y += 0.0917) {
+      pointFloatType inputPoint = {calibration[0] + x, calibration[1] + y};
+      pointIntType floatPoint = js.processInputReading(inputPoint);
+      pointIntType fixedPoint = js.processInputReadingFixed(inputPoint);
+      worst = max(worst, max(abs(floatPoint.x - fixedPoint.x), abs(floatPoint.y - fixedPoint.y)));
+    }
+  }
+  return worst;
+}
+
+//***TIME STAGE FUNCTION***//
+// Function   : timeInputStage
+//
+// Description: Host time of one input stage call averaged over a sweep of readings
+//
+// Parameters : fixedPoint : bool : Time the fixed-point version
+//
+// Return     : time : double : Average ns per call
+//****************************************//
+double timeInputStage(bool fixedPoint) {
+  volatile int sink = 0;
+  int callNumber = 0;
+  auto startTime = std::chrono::steady_clock::now();
+  for (int run = 0; run < 20; run++) {
+    for (float angle = 0.0; angle < 2.0 * PI; angle += 0.01) {
+      pointFloatType inputPoint = {0.5f + 12.0f * cosf(angle), -0.5f + 12.0f * sinf(angle)};
+      pointIntType outputPoint = fixedPoint ? js.processInputReadingFixed(inputPoint) : js.processInputReading(inputPoint);
+      sink = sink + outputPoint.x;
+      callNumber++;
+    }
+  }
+  auto endTime = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(endTime - startTime).count() / callNumber;
+}
+
+int main() {
+  js.begin();
+
+  // Input stage with the sector transform, the radius fallback and a range map
+  for (const float* calibration : calibrations) {
+    loadCalibration(calibration);
+    HOST_CHECK(js._sectorValid);
+    HOST_CHECK(checkInputStage(calibration) <= FIXED_TOLERANCE);
+
+    uint8_t rangeMap[JOY_RANGE_MAP_SIZE];
+    float cornerSize = fabs(calibration[2]);
+    for (int bin = 0; bin < JOY_RANGE_MAP_SIZE; bin++) {
+      rangeMap[bin] = constrain((int)round(cornerSize * (1.0 + 0.2 * sin(bin * 0.4)) / JOY_RANGE_MAP_UNIT), 1, 255);
+    }
+    HOST_CHECK(js.setRangeMap(rangeMap));
+    HOST_CHECK(checkInputStage(calibration) <= FIXED_TOLERANCE);
+    js.clearRangeMap();
+
+    js.zeroInputMax(2);                                   // Corner missing, mapped with _inputRadius
+    js.setMinimumRadius();
+    HOST_CHECK(!js._sectorValid);
+    HOST_CHECK(checkInputStage(calibration) <= FIXED_TOLERANCE);
+  }
+
+  // Output stage over the whole input square for several deadzones and response curves
+  const float deadzones[][2] = {{0.05, 0.95}, {0.0, 1.0}, {0.2, 0.8}};
+  const int accelerationLevels[] = {CONF_JOY_ACCELERATION_LEVEL_MIN, 0, CONF_JOY_ACCELERATION_LEVEL_MAX};
+  for (const float* deadzone : deadzones) {
+    for (int accelerationLevel : accelerationLevels) {
+      js.setInnerDeadzone(true, deadzone[0]);
+      js.setOuterDeadzone(true, deadzone[1]);
+      js.setAccelerationLevel(accelerationLevel);
+      int worst = 0;
+      for (int x = -JOY_INPUT_XY_MAX; x <= JOY_INPUT_XY_MAX; x += 3) {
+        for (int y = -JOY_INPUT_XY_MAX; y <= JOY_INPUT_XY_MAX; y += 3) {
+          pointIntType floatPoint = js.processOutputResponse({x, y});
+          pointIntType fixedPoint = js.processOutputResponseFixed({x, y});
+          worst = max(worst, max(abs(floatPoint.x - fixedPoint.x), abs(floatPoint.y - fixedPoint.y)));
+        }
+      }
+      HOST_CHECK(worst <= FIXED_TOLERANCE);
+    }
+  }
+
+  // Integer helpers
+  HOST_CHECK(js.sqrtInt(0) == 0);
+  HOST_CHECK(js.sqrtInt(2147483647UL) == 46340);
+  HOST_CHECK(js.sqrtInt(4294967295UL) == 65535);
+  HOST_CHECK(js.divRoundInt(5, 2) == 3 && js.divRoundInt(-5, 2) == -3 && js.divRoundInt(4, 3) == 1);
+  HOST_CHECK(js.shiftRoundInt(24, 4) == 2 && js.shiftRoundInt(-24, 4) == -1 && js.shiftRoundInt(7, 0) == 7);
+  HOST_CHECK(js.toFixed(1000.0, 8, JOY_FIXED_VALUE_MAX) == JOY_FIXED_VALUE_MAX && js.toFixed(-0.3, 4, JOY_FIXED_VALUE_MAX) == -5);
+  HOST_CHECK(js.getFixedShift(100.0) == 8 && js.getFixedShift(0.1) == JOY_FIXED_POINT_SHIFT);
+
+  loadCalibration(calibrations[0]);
+  printf("input stage host time: float %.1f ns, fixed %.1f ns\n", timeInputStage(false), timeInputStage(true));
+
+  return hostTestResult("test_fixed_point");
+}
@@ -0,0 +1,133 @@
+/*
+* File: test_joystick_replay.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Replays raw magnet traces through LSJoystick::update(point, sampleTime) and reports the per-sample
+// latency, throughput and an FNV-1a checksum of the outputs. The checksum only changes when the
+// pipeline output changes, so it can be compared between builds.
+//
+// Usage: test_joystick_replay trace.csv [trace.csv ...]
+
+#include "HostTest.h"
+#include "LSJoystick.h"
+#include <chrono>
+
+#define REPLAY_RUN_NUMBER 20             // Times each trace is processed for the latency figures
+#define REPLAY_CENTER_X 0.5              // Calibration the traces in traces/ were made with (mT)
+#define REPLAY_CENTER_Y -0.5
+#define REPLAY_CORNER 14.0
+
+//***LOAD REPLAY CALIBRATION FUNCTION***//
+// Function   : loadReplayCalibration
+//
+// Description: Load the fixed calibration and default settings used for every replay
+//
+// Parameters : js : LSJoystick& : Joystick to set up
+//
+// Return     : void
+//****************************************//
+void loadReplayCalibration(LSJoystick& js) {
+  js.setInputMax(0, {REPLAY_CENTER_X, REPLAY_CENTER_Y});
+  js.setInputMax(1, {REPLAY_CENTER_X - REPLAY_CORNER, REPLAY_CENTER_Y + REPLAY_CORNER});
+  js.setInputMax(2, {REPLAY_CENTER_X + REPLAY_CORNER, REPLAY_CENTER_Y + REPLAY_CORNER});
+  js.setInputMax(3, {REPLAY_CENTER_X + REPLAY_CORNER, REPLAY_CENTER_Y - REPLAY_CORNER});
+  js.setInputMax(4, {REPLAY_CENTER_X - REPLAY_CORNER, REPLAY_CENTER_Y - REPLAY_CORNER});
+  js.setMinimumRadius();
+  js.clearRangeMap();
+  js.setInnerDeadzone(true, CONF_JOY_DEADZONE_INNER_DEFAULT);
+  js.setOuterDeadzone(true, CONF_JOY_DEADZONE_OUTER_DEFAULT);
+  js.setOutputRange(CONF_JOY_CURSOR_SPEED_LEVEL_DEFAULT);
+  js.setAccelerationLevel(JOY_ACCELERATION_LEVEL_DEFAULT);
+  js.setFilterCutoff(CONF_JOY_FILTER_CUTOFF_DEFAULT);
+}
+
+//***REPLAY TRACE FUNCTION***//
+// Function   : replayTrace
+//
+// Description: Replay one trace and print its latency, throughput and output checksum.
+//              Every run starts from a new LSJoystick so the filter and center state don't carry over.
+//
+// Parameters : fileName : const char* : Trace file
+//
+// Return     : void
+//****************************************//
+void replayTrace(const char* fileName) {
+  std::vector<hostTraceSample> trace;
+  if (!HOST_CHECK(hostLoadTrace(fileName, trace))) {
+    printf("Could not load %s\n", fileName);
+    return;
+  }
+
+  double sampleTimeMin = 1e9;
+  double sampleTimeMax = 0.0;
+  double sampleTimeTotal = 0.0;
+  unsigned long outputChecksum = 2166136261UL;                            // FNV-1a offset basis
+  unsigned long spikeCount = 0;
+  int outputMax = 0;
+
+  for (int runIndex = 0; runIndex < REPLAY_RUN_NUMBER; runIndex++) {
+    LSJoystick js;
+    js.begin();
+    loadReplayCalibration(js);
+    unsigned long runChecksum = 2166136261UL;
+
+    for (size_t sampleIndex = 0; sampleIndex < trace.size(); sampleIndex++) {
+      g_hostMicros = trace[sampleIndex].sampleTime;
+      auto sampleStart = std::chrono::steady_clock::now();
+      js.update(trace[sampleIndex].point, trace[sampleIndex].sampleTime);
+      auto sampleEnd = std::chrono::steady_clock::now();
+      double sampleTime = std::chrono::duration<double, std::micro>(sampleEnd - sampleStart).count();
+
+      sampleTimeTotal += sampleTime;
+      sampleTimeMin = min(sampleTimeMin, sampleTime);
+      sampleTimeMax = max(sampleTimeMax, sampleTime);
+
+      pointIntType outputPoint = js.getXYOut();
+      outputMax = max(outputMax, max(abs(outputPoint.x), abs(outputPoint.y)));
+      const uint8_t* outputBytes = (const uint8_t*) &outputPoint;
+      for (size_t byteIndex = 0; byteIndex < sizeof(outputPoint); byteIndex++) {
+        runChecksum = ((runChecksum ^ outputBytes[byteIndex]) * 16777619UL) & 0xFFFFFFFFUL;  // FNV-1a prime
+      }
+    }
+
+    if (runIndex == 0) {
+      outputChecksum = runChecksum;
+    }
+    HOST_CHECK(runChecksum == outputChecksum);                             // Replays are deterministic
+    HOST_CHECK(js.getXOut() == 0 && js.getYOut() == 0);                    // Traces end at rest
+    spikeCount = js.getFaultStats().spikeCount;
+  }
+
+  unsigned long sampleNumber = trace.size() * REPLAY_RUN_NUMBER;
+  double sampleTimeAverage = sampleTimeTotal / sampleNumber;
+  HOST_CHECK(outputMax <= CONF_JOY_OUTPUT_XY_MAX);
+
+  printf("%s: samples %lu runs %d\n", fileName, (unsigned long) trace.size(), REPLAY_RUN_NUMBER);
+  printf("  latency min %.3f avg %.3f max %.3f us\n", sampleTimeMin, sampleTimeAverage, sampleTimeMax);
+  printf("  throughput %.0f samples/s\n", 1e6 / sampleTimeAverage);
+  printf("  checksum 0x%08lX  spikes %lu  max output %d\n", outputChecksum, spikeCount, outputMax);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    printf("Usage: %s trace.csv [trace.csv ...]\n", argv[0]);
+    return 1;
+  }
+  for (int argIndex = 1; argIndex < argc; argIndex++) {
+    replayTrace(argv[argIndex]);
+  }
+  return hostTestResult("test_joystick_replay");
+}
@@ -0,0 +1,120 @@
+/*
+* File: test_output_response.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Compares the joystick output response stage (LSJoystick::getOutputResponse) with the polar reference
+// implementation across the full -1024..1024 input grid for several deadzone settings.
+// Every output has to be within RESPONSE_TOLERANCE of the reference.
+
+#include "HostTest.h"
+#include "LSJoystick.h"
+
+#define RESPONSE_GRID_STEP 1             // Step between tested input points (1 = full -1024..1024 grid)
+#define RESPONSE_TOLERANCE 1             // Maximum allowed difference from the reference response in counts
+#define RESPONSE_PRINT_MAX 10            // Number of mismatches printed
+
+LSJoystick js;
+
+//***REFERENCE OUTPUT RESPONSE FUNCTION***//
+// Function   : referenceOutputResponse
+//
+// Description: This function is the polar (atan2, cos, sin) output response stage that was used by
+//              LSJoystick::processOutputResponse before the angle-free implementation.
+//
+// Parameters : inputPoint : pointIntType : Mapped input point (-1024 to 1024)
+//              innerDeadzoneValue : int : Inner deadzone value (0 to JOY_INPUT_XY_MAX)
+//              outerDeadzoneValue : int : Outer deadzone value (0 to JOY_INPUT_XY_MAX)
+//
+// Return     : outputPoint : pointIntType : Reference output point
+//****************************************//
+pointIntType referenceOutputResponse(pointIntType inputPoint, int innerDeadzoneValue, int outerDeadzoneValue) {
+  pointIntType deadzonedPoint = {0, 0};
+  pointIntType outputPoint = {0, 0};
+
+  float inputMagnitude = sqrt(sq(float(inputPoint.x)) + sq(float(inputPoint.y)));
+  float inputAngle = atan2(inputPoint.y, inputPoint.x);
+
+  // Apply deadzone
+  if (inputMagnitude <= innerDeadzoneValue) {
+    deadzonedPoint = {0, 0};
+  } else {
+    int deadzonedMagnitude = JOY_INPUT_XY_MAX;
+    if (inputMagnitude < outerDeadzoneValue) {
+      deadzonedMagnitude = js.mapRoundInt(inputMagnitude, innerDeadzoneValue, outerDeadzoneValue, 0, JOY_INPUT_XY_MAX);
+    }
+    deadzonedPoint.x = round(deadzonedMagnitude * cos(inputAngle));
+    deadzonedPoint.y = round(deadzonedMagnitude * sin(inputAngle));
+  }
+
+  // Apply scaling (the magnitude was truncated to int by mapIntToFloat)
+  int deadzonedPointMagnitude = sqrt(sq(float(deadzonedPoint.x)) + sq(float(deadzonedPoint.y)));
+  float outputMagnitude = float(deadzonedPointMagnitude) * float(CONF_JOY_OUTPUT_XY_MAX) / float(JOY_INPUT_XY_MAX);
+  outputMagnitude = constrain(outputMagnitude, 0, CONF_JOY_OUTPUT_XY_MAX);
+
+  outputPoint.x = round(outputMagnitude * cos(inputAngle));
+  outputPoint.y = round(outputMagnitude * sin(inputAngle));
+
+  return outputPoint;
+}
+
+int main() {
+  // Inner and outer deadzone factors to test
+  const float deadzoneFactors[][2] = {
+    { CONF_JOY_DEADZONE_INNER_DEFAULT, CONF_JOY_DEADZONE_OUTER_DEFAULT },
+    { 0.0, 1.0 },
+    { 0.2, 0.8 },
+    { 0.1, 0.99 }
+  };
+
+  js.begin();
+  js.setAccelerationLevel(JOY_ACCELERATION_LEVEL_DEFAULT);  // The reference has a linear response
+
+  unsigned long failedPoints = 0;
+  unsigned long testedPoints = 0;
+  int maxDifference = 0;
+
+  for (const float* deadzoneFactor : deadzoneFactors) {
+    js.setInnerDeadzone(true, deadzoneFactor[0]);
+    js.setOuterDeadzone(true, deadzoneFactor[1]);
+    int innerDeadzoneValue = round(JOY_INPUT_XY_MAX * deadzoneFactor[0]);
+    int outerDeadzoneValue = round(JOY_INPUT_XY_MAX * deadzoneFactor[1]);
+
+    for (int x = -JOY_INPUT_XY_MAX; x <= JOY_INPUT_XY_MAX; x += RESPONSE_GRID_STEP) {
+      for (int y = -JOY_INPUT_XY_MAX; y <= JOY_INPUT_XY_MAX; y += RESPONSE_GRID_STEP) {
+        pointIntType inputPoint = {x, y};
+        pointIntType outputPoint = js.getOutputResponse(inputPoint);
+        pointIntType referencePoint = referenceOutputResponse(inputPoint, innerDeadzoneValue, outerDeadzoneValue);
+
+        int difference = max(abs(outputPoint.x - referencePoint.x), abs(outputPoint.y - referencePoint.y));
+        maxDifference = max(maxDifference, difference);
+        testedPoints++;
+
+        if (difference > RESPONSE_TOLERANCE) {
+          if (failedPoints < RESPONSE_PRINT_MAX) {
+            printf("Deadzone %.2f|%.2f mismatch at %d|%d output %d|%d reference %d|%d\n", deadzoneFactor[0], deadzoneFactor[1],
+                   x, y, outputPoint.x, outputPoint.y, referencePoint.x, referencePoint.y);
+          }
+          failedPoints++;
+        }
+      }
+    }
+  }
+
+  printf("output response: tested points %lu max difference %d failed points %lu\n", testedPoints, maxDifference, failedPoints);
+  HOST_CHECK(failedPoints == 0);
+
+  return hostTestResult("test_output_response");
+}
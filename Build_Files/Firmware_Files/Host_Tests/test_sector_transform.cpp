@@ -0,0 +1,184 @@
+/*
+* File: test_sector_transform.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks the calibration sector transform (LSJoystick::setSectorTransform) on its own: every corner
+// reaches the diagonal output point, the map is continuous across the sector edges, and the fixed-point
+// transform (findSectorFixed and _sectorTransformFixed) matches the float one within +/-1 count on
+// circles swept in both directions, so the sector of the previous reading is checked from both sides.
+// Corners that don't form four sectors fall back to the input radius.
+
+#include "HostTest.h"
+#define private public                   // The sector transform is private
+#include "LSJoystick.h"
+#undef private
+
+#define SECTOR_TOLERANCE 1               // Largest allowed difference between the float and fixed transforms in counts
+#define SECTOR_ANGLE_STEP 0.001          // Angle step of the swept circles (rad)
+#define SECTOR_EDGE_ANGLE 0.0005         // Angle either side of a corner for the continuity check (rad)
+#define SECTOR_EDGE_STEP_MAX 3           // Largest output step across a sector edge in counts
+
+LSJoystick js;
+
+// Center x, center y and the four corners relative to the center (mT)
+const float calibrations[][10] = {
+  { 0.5, -0.5, -14.0,  14.0,  14.0,  14.0,  14.0, -14.0, -14.0, -14.0},   // Square
+  { 1.2,  0.4, -10.0,  14.0,  18.0,  12.0,  12.0,  -9.0, -11.0, -10.0},   // Uneven corners
+  { 0.0,  0.0,  -8.0,  18.0,  18.0,   8.0,   8.0, -18.0, -18.0,  -8.0},   // Magnet mounted rotated by about 24 degrees
+  {-2.0,  1.0,  -6.0,  25.0,  28.0,   9.0,  24.0, -27.0, -23.0, -29.0},   // Strong, uneven magnet
+  { 0.0,  0.0,  -3.0,   3.5,   3.2,   3.0,   3.0,  -2.8,  -3.1,  -3.3}    // Weak magnet
+};
+
+//***LOAD CALIBRATION FUNCTION***//
+// Function   : loadCalibration
+//
+// Description: Load a test calibration with the joystick axes not mirrored, so outputs compare to the sector targets
+//
+// Parameters : calibration : const float* : Center and corners
+//
+// Return     : void
+//****************************************//
+void loadCalibration(const float* calibration) {
+  js.setInputMax(0, {calibration[0], calibration[1]});
+  for (int corner = 1; corner <= 4; corner++) {
+    js.setInputMax(corner, {calibration[0] + calibration[2 * corner], calibration[1] + calibration[2 * corner + 1]});
+  }
+  js.setMinimumRadius();
+  js._joystickXDirection = 1;
+  js._joystickYDirection = 1;
+}
+
+//***CHECK CORNERS FUNCTION***//
+// Function   : checkCorners
+//
+// Description: Each calibrated corner is mapped to the diagonal output point of its quadrant by both transforms
+//
+// Parameters : calibration : const float* : Center and corners
+//
+// Return     : worst : int : Largest difference from the diagonal output point in counts
+//****************************************//
+int checkCorners(const float* calibration) {
+  int diagonalOutput = round(JOY_INPUT_XY_MAX / sqrt(2.0));
+  int worst = 0;
+  for (int corner = 1; corner <= 4; corner++) {
+    float cornerX = calibration[2 * corner];
+    float cornerY = calibration[2 * corner + 1];
+    pointFloatType inputPoint = {calibration[0] + cornerX, calibration[1] + cornerY};
+    pointIntType targetPoint = {(cornerX >= 0.0) ? diagonalOutput : -diagonalOutput, (cornerY >= 0.0) ? diagonalOutput : -diagonalOutput};
+    pointIntType floatPoint = js.processInputReading(inputPoint);
+    pointIntType fixedPoint = js.processInputReadingFixed(inputPoint);
+    worst = max(worst, max(abs(floatPoint.x - targetPoint.x), abs(floatPoint.y - targetPoint.y)));
+    worst = max(worst, max(abs(fixedPoint.x - targetPoint.x), abs(fixedPoint.y - targetPoint.y)));
+  }
+  return worst;
+}
+
+//***CHECK EDGES FUNCTION***//
+// Function   : checkEdges
+//
+// Description: Readings just either side of each sector edge (the ray through a corner) at half the corner
+//              radius are mapped by neighbouring sectors, and have to give almost the same output.
+//
+// Parameters : calibration : const float* : Center and corners
+//
+// Return     : worst : int : Largest output step across an edge in counts
+//****************************************//
+int checkEdges(const float* calibration) {
+  int worst = 0;
+  for (int corner = 1; corner <= 4; corner++) {
+    float cornerX = calibration[2 * corner];
+    float cornerY = calibration[2 * corner + 1];
+    float cornerAngle = atan2(cornerY, cornerX);
+    float edgeRadius = 0.5 * sqrt(sq(cornerX) + sq(cornerY));
+    pointIntType sidePoint[2];
+    for (int side = 0; side < 2; side++) {
+      float angle = cornerAngle + ((side == 0) ? -SECTOR_EDGE_ANGLE : SECTOR_EDGE_ANGLE);
+      sidePoint[side] = js.processInputReading({calibration[0] + edgeRadius * cosf(angle), calibration[1] + edgeRadius * sinf(angle)});
+    }
+    worst = max(worst, max(abs(sidePoint[0].x - sidePoint[1].x), abs(sidePoint[0].y - sidePoint[1].y)));
+  }
+  return worst;
+}
+
+//***CHECK FIXED TRANSFORM FUNCTION***//
+// Function   : checkFixedTransform
+//
+// Description: Compare the fixed-point transform with the float transform on circles from the center to beyond
+//              the corners, swept counterclockwise and then clockwise.
+//
+// Parameters : calibration : const float* : Center and corners
+//              sectorMismatch : int* : Number of readings where findSectorFixed and findSector disagree
+//
+// Return     : worst : int : Largest difference in counts
+//****************************************//
+int checkFixedTransform(const float* calibration, int* sectorMismatch) {
+  float cornerRadius = 0.0;
+  for (int corner = 1; corner <= 4; corner++) {
+    cornerRadius = max(cornerRadius, (float)sqrt(sq(calibration[2 * corner]) + sq(calibration[2 * corner + 1])));
+  }
+
+  int worst = 0;
+  *sectorMismatch = 0;
+  for (float radiusFactor = 0.05; radiusFactor <= 1.25; radiusFactor += 0.1) {
+    float radius = radiusFactor * cornerRadius;
+    for (int direction = 1; direction >= -1; direction -= 2) {
+      for (float step = 0.0; step < 2.0 * PI; step += SECTOR_ANGLE_STEP) {
+        float angle = direction * step;
+        float centeredX = radius * cosf(angle);
+        float centeredY = radius * sinf(angle);
+        pointFloatType inputPoint = {calibration[0] + centeredX, calibration[1] + centeredY};
+        pointIntType floatPoint = js.processInputReading(inputPoint);
+        pointIntType fixedPoint = js.processInputReadingFixed(inputPoint);
+        worst = max(worst, max(abs(floatPoint.x - fixedPoint.x), abs(floatPoint.y - fixedPoint.y)));
+
+        int sector = js.findSector(centeredX, centeredY);
+        int sectorFixed = js.findSectorFixed(js.toFixed(centeredX, JOY_FIXED_INPUT_SHIFT, JOY_FIXED_INPUT_LIMIT),
+                                             js.toFixed(centeredY, JOY_FIXED_INPUT_SHIFT, JOY_FIXED_INPUT_LIMIT));
+        *sectorMismatch += (sector != sectorFixed) ? 1 : 0;
+      }
+    }
+  }
+  return worst;
+}
+
+int main() {
+  js.begin();
+
+  for (const float* calibration : calibrations) {
+    loadCalibration(calibration);
+    HOST_CHECK(js._sectorValid);
+
+    int sectorMismatch = 0;
+    int cornerWorst = checkCorners(calibration);
+    int edgeWorst = checkEdges(calibration);
+    int fixedWorst = checkFixedTransform(calibration, &sectorMismatch);
+    printf("center %.1f|%.1f: corners %d, edge step %d, fixed difference %d, sector mismatches %d\n",
+           calibration[0], calibration[1], cornerWorst, edgeWorst, fixedWorst, sectorMismatch);
+    HOST_CHECK(cornerWorst <= SECTOR_TOLERANCE);
+    HOST_CHECK(edgeWorst <= SECTOR_EDGE_STEP_MAX);
+    HOST_CHECK(fixedWorst <= SECTOR_TOLERANCE);
+  }
+
+  // Two corners in one quadrant: no sectors, both versions use the input radius
+  const float folded[10] = { 0.0, 0.0, -14.0, 14.0, 14.0, 14.0, 14.0, 2.0, 14.0, -14.0};
+  loadCalibration(folded);
+  HOST_CHECK(!js._sectorValid);
+  HOST_CHECK(js.findSector(1.0, 1.0) == -1 && js.findSectorFixed(16, 16) == -1);
+  int sectorMismatch = 0;
+  HOST_CHECK(checkFixedTransform(folded, &sectorMismatch) <= SECTOR_TOLERANCE);
+
+  return hostTestResult("test_sector_transform");
+}
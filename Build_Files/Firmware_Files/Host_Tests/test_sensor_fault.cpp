@@ -0,0 +1,255 @@
+/*
+* File: test_sensor_fault.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks the raw reading spike filter (Hampel filter) and the sensor fault paths: frames repeated by
+// oversampling, frozen conversions, implausible readings, bus errors, the backed off sensor recovery
+// outside the sampling task and the I2C bus clear. The sensor is the Tlv493d stub in shims/.
+
+#include "HostTest.h"
+#define private public                   // The fault state and the sampling task body are private
+#include "LSJoystick.h"
+#undef private
+
+#define FAULT_SAMPLE_INTERVAL 5000       // Time between sensor reads in us (200 Hz, faster than the conversions)
+
+LSJoystick js;
+
+//***RESET JOYSTICK FUNCTION***//
+// Function   : resetJoystick
+//
+// Description: Start a check with a joystick read through the Tlv493d stub with good frames at the center
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void resetJoystick() {
+  js.begin();
+  js._sensorAsync = false;
+  js._Tlv493dSensor.status = TLV493D_NO_ERROR;
+  js._Tlv493dSensor.setReading(-0.5, 0.5);               // Sensor y is joystick x
+  js._Tlv493dSensor.beginCount = 0;
+  js.setFilterCutoff(CONF_JOY_FILTER_CUTOFF_MIN);     // Filter off, getXYFiltered() is the spike filter output
+  js._sensorFaultRun = 0;
+  js._sensorRecoveryPending = false;
+  js._sensorRecoveryCount = 0;
+  js.resetFaultStats();
+}
+
+//***READ SENSOR FUNCTION***//
+// Function   : readSensor
+//
+// Description: Advance the simulated time by one sample interval and read the sensor through update()
+//
+// Parameters : sampleNumber : int : Number of reads
+//
+// Return     : void
+//****************************************//
+void readSensor(int sampleNumber) {
+  for (int sampleIndex = 0; sampleIndex < sampleNumber; sampleIndex++) {
+    g_hostMicros += FAULT_SAMPLE_INTERVAL;
+    js.update();
+  }
+}
+
+//***TEST SPIKE FILTER FUNCTION***//
+// Function   : testSpikeFilter
+//
+// Description: A one sample glitch is replaced by the window median and counted. A step is passed from its second
+//              sample and a fast flick is passed unchanged, neither is counted.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testSpikeFilter() {
+  resetJoystick();
+  unsigned long sampleTime = g_hostMicros;
+  for (int sampleIndex = 0; sampleIndex < 20; sampleIndex++) {
+    js.update({0.5, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+  }
+
+  // One sample 25 mT glitch
+  js.update({25.5, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+  HOST_CHECK_NEAR(js.getXYFiltered().x, 0.5, 0.001);
+  js.update({0.5, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+  HOST_CHECK(js.getFaultStats().spikeCount == 1);
+
+  // Step to 8.5 mT: held for one sample, then followed
+  for (int sampleIndex = 0; sampleIndex < 10; sampleIndex++) {
+    js.update({0.5, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+  }
+  js.update({8.5, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+  HOST_CHECK_NEAR(js.getXYFiltered().x, 0.5, 0.001);
+  for (int sampleIndex = 0; sampleIndex < 5; sampleIndex++) {
+    js.update({8.5, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+    HOST_CHECK_NEAR(js.getXYFiltered().x, 8.5, 0.001);
+  }
+  HOST_CHECK(js.getFaultStats().spikeCount == 1);
+
+  // Flick to full deflection and back in 50 ms each (280 mT/s)
+  float flickPosition = 8.5;
+  bool flickPassed = true;
+  for (int sampleIndex = 0; sampleIndex < 20; sampleIndex++) {
+    flickPosition += (sampleIndex < 10) ? 1.4 : -1.4;
+    js.update({flickPosition, -0.5}, sampleTime += FAULT_SAMPLE_INTERVAL);
+    flickPassed = flickPassed && fabs(js.getXYFiltered().x - flickPosition) < 0.001;
+  }
+  HOST_CHECK(flickPassed);
+  HOST_CHECK(js.getFaultStats().spikeCount == 1);
+  g_hostMicros = sampleTime;
+}
+
+//***TEST FROZEN FRAMES FUNCTION***//
+// Function   : testFrozenFrames
+//
+// Description: Reading at 200 Hz returns every other frame twice (conversions take up to JOY_SENSOR_CONVERSION_PERIOD),
+//              which is not a fault. A frame counter that stops for JOY_SENSOR_FROZEN_PERIODS conversion periods is.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testFrozenFrames() {
+  resetJoystick();
+  for (int sampleIndex = 0; sampleIndex < 200; sampleIndex++) {
+    js._Tlv493dSensor.status = (sampleIndex % 2) ? TLV493D_FRAME_ERROR : TLV493D_NO_ERROR;
+    readSensor(1);
+  }
+  HOST_CHECK(js.getFaultStats().frozenCount == 0);
+  HOST_CHECK(js._sensorFaultRun == 0);
+
+  js._Tlv493dSensor.status = TLV493D_NO_ERROR;
+  readSensor(1);
+  js._Tlv493dSensor.status = TLV493D_FRAME_ERROR;
+  readSensor(JOY_SENSOR_FROZEN_PERIODS * JOY_SENSOR_CONVERSION_PERIOD / FAULT_SAMPLE_INTERVAL - 1);
+  HOST_CHECK(js.getFaultStats().frozenCount == 0);
+  readSensor(3);
+  HOST_CHECK(js.getFaultStats().frozenCount == 3);
+}
+
+//***TEST IMPLAUSIBLE READING FUNCTION***//
+// Function   : testImplausibleReading
+//
+// Description: A reading beyond JOY_SENSOR_FIELD_MAX is counted and replaced by the last good reading
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testImplausibleReading() {
+  resetJoystick();
+  readSensor(10);
+  js._Tlv493dSensor.setReading(-0.5, 120.0);
+  readSensor(1);
+  HOST_CHECK(js.getFaultStats().implausibleCount == 1);
+  HOST_CHECK_NEAR(js.getXYRaw().x, 0.5, 0.001);
+}
+
+//***TEST SENSOR RECOVERY FUNCTION***//
+// Function   : testSensorRecovery
+//
+// Description: A disconnected sensor (bus errors) requests a recovery after JOY_SENSOR_FAULT_LIMIT frames. The sampling
+//              task never re-initializes the sensor, update() does. Further attempts back off and stop after
+//              JOY_SENSOR_RECOVERY_ATTEMPT_MAX. A good frame allows new attempts.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testSensorRecovery() {
+  resetJoystick();
+  HOST_CHECK(js.beginSampling(CONF_JOY_SAMPLE_RATE));
+  js._Tlv493dSensor.status = TLV493D_BUS_ERROR;
+
+  // Sampling task: faults are counted and a recovery requested, the sensor is not touched
+  for (int sampleIndex = 0; sampleIndex < JOY_SENSOR_FAULT_LIMIT * 3; sampleIndex++) {
+    g_hostMicros += FAULT_SAMPLE_INTERVAL;
+    js.sampleSensor(1);
+  }
+  HOST_CHECK(js.getFaultStats().busErrorCount == JOY_SENSOR_FAULT_LIMIT * 3);
+  HOST_CHECK(js._sensorRecoveryPending);
+  HOST_CHECK(js._Tlv493dSensor.beginCount == 0);
+
+  // The first attempt runs in update() at once
+  js.update();
+  HOST_CHECK(js._Tlv493dSensor.beginCount == 1);
+  HOST_CHECK(!js._sensorRecoveryPending);
+  js.endSampling();
+
+  // Further attempts back off
+  unsigned long recoveryTime[JOY_SENSOR_RECOVERY_ATTEMPT_MAX + 1] = {0};
+  recoveryTime[1] = g_hostMicros;
+  unsigned long startTime = g_hostMicros;
+  while (g_hostMicros - startTime < 60000000UL) {                         // 1 minute
+    readSensor(1);
+    int attempt = js._Tlv493dSensor.beginCount;
+    if (attempt <= JOY_SENSOR_RECOVERY_ATTEMPT_MAX && recoveryTime[attempt] == 0) {
+      recoveryTime[attempt] = g_hostMicros;
+    }
+  }
+  HOST_CHECK(js._Tlv493dSensor.beginCount == JOY_SENSOR_RECOVERY_ATTEMPT_MAX);
+  HOST_CHECK(js.getFaultStats().sensorResetCount == JOY_SENSOR_RECOVERY_ATTEMPT_MAX);
+  unsigned long faultRunTime = (unsigned long)JOY_SENSOR_FAULT_LIMIT * FAULT_SAMPLE_INTERVAL;
+  for (int attempt = 2; attempt <= JOY_SENSOR_RECOVERY_ATTEMPT_MAX; attempt++) {
+    unsigned long backoffTime = (JOY_SENSOR_RECOVERY_BACKOFF * 1000UL) << (attempt - 2);
+    HOST_CHECK_NEAR(recoveryTime[attempt] - recoveryTime[attempt - 1], faultRunTime + backoffTime, FAULT_SAMPLE_INTERVAL);
+  }
+
+  // The sensor comes back: a good frame allows new attempts
+  js._Tlv493dSensor.status = TLV493D_NO_ERROR;
+  readSensor(1);
+  js._Tlv493dSensor.status = TLV493D_BUS_ERROR;
+  readSensor(JOY_SENSOR_FAULT_LIMIT + 1);
+  HOST_CHECK(js._Tlv493dSensor.beginCount == JOY_SENSOR_RECOVERY_ATTEMPT_MAX + 1);
+}
+
+//***TEST BUS CLEAR FUNCTION***//
+// Function   : testBusClear
+//
+// Description: The bus clear pulses SCL until a device releases SDA (at most TWIM_READER_RECOVERY_CLOCKS times)
+//              and gives the pins back to Wire.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testBusClear() {
+  LSTwimReader reader;
+  NRF_TWIM0->ENABLE = TWIM_ENABLE_ENABLE_Enabled;
+
+  g_hostPinLevel[PIN_WIRE_SCL] = HIGH;
+  g_hostPinToggles[PIN_WIRE_SCL] = 0;
+  HOST_CHECK(reader.recoverBus());
+  HOST_CHECK(g_hostPinToggles[PIN_WIRE_SCL] == 0);                       // SDA was free, no clocks
+
+  g_hostPinHeldLow[PIN_WIRE_SDA] = true;
+  HOST_CHECK(!reader.recoverBus());
+  HOST_CHECK(g_hostPinToggles[PIN_WIRE_SCL] == 2 * TWIM_READER_RECOVERY_CLOCKS);
+  HOST_CHECK(NRF_TWIM0->ENABLE == TWIM_ENABLE_ENABLE_Enabled);
+  g_hostPinHeldLow[PIN_WIRE_SDA] = false;
+}
+
+int main() {
+  testSpikeFilter();
+  testFrozenFrames();
+  testImplausibleReading();
+  testSensorRecovery();
+  testBusClear();
+
+  return hostTestResult("test_sensor_fault");
+}
@@ -0,0 +1,127 @@
+/*
+* File: test_temperature.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks the temperature drift learning: the center drift of a resting joystick is learned at a limited
+// rate per temperature reading, and nothing is learned while the joystick is touched inside the deadzone
+// or while a calibration is running.
+
+#include "HostTest.h"
+#define private public                   // The temperature readings are published by readSensor()
+#include "LSJoystick.h"
+#undef private
+
+#define TEMP_SAMPLE_INTERVAL 5000        // Time between readings in us (200 Hz)
+#define TEMP_CENTER_X 0.5                // Calibrated center (mT)
+#define TEMP_CENTER_Y -0.5
+#define TEMP_CORNER 14.0
+#define TEMP_DRIFT_X 0.1                 // Simulated center drift (mT per C)
+#define TEMP_DRIFT_Y -0.05
+#define TEMP_WARMUP_TIME 300             // Time to warm up by TEMP_WARMUP_DELTA (s)
+#define TEMP_WARMUP_DELTA 10.0           // (C)
+#define TEMP_TOUCH_NOISE 0.6             // Largest movement of a finger resting on the joystick (mT)
+
+//***LOAD CALIBRATION FUNCTION***//
+// Function   : loadCalibration
+//
+// Description: Start a joystick with a square calibration around the test center
+//
+// Parameters : js : LSJoystick& : Joystick to set up
+//
+// Return     : void
+//****************************************//
+void loadCalibration(LSJoystick& js) {
+  js.begin();
+  js.setInputMax(0, {TEMP_CENTER_X, TEMP_CENTER_Y});
+  js.setInputMax(1, {TEMP_CENTER_X - TEMP_CORNER, TEMP_CENTER_Y + TEMP_CORNER});
+  js.setInputMax(2, {TEMP_CENTER_X + TEMP_CORNER, TEMP_CENTER_Y + TEMP_CORNER});
+  js.setInputMax(3, {TEMP_CENTER_X + TEMP_CORNER, TEMP_CENTER_Y - TEMP_CORNER});
+  js.setInputMax(4, {TEMP_CENTER_X - TEMP_CORNER, TEMP_CENTER_Y - TEMP_CORNER});
+  js.setMinimumRadius();
+}
+
+//***WARM UP FUNCTION***//
+// Function   : warmUp
+//
+// Description: Warm the sensor up by TEMP_WARMUP_DELTA over TEMP_WARMUP_TIME while the center drifts with it.
+//              The temperature is published once every JOY_TEMP_READ_PERIOD like readSensor() does.
+//
+// Parameters : js : LSJoystick& : Joystick under test
+//              touchNoise : float : Largest random movement added to each reading (mT, 0 = untouched)
+//              slopeStepMax : float* : Largest change of the learned drift between temperature readings (mT per C)
+//
+// Return     : void
+//****************************************//
+void warmUp(LSJoystick& js, float touchNoise, float* slopeStepMax) {
+  unsigned long noiseSeed = 7;
+  unsigned long startTime = g_hostMicros;
+  pointFloatType previousSlope = js.getTemperatureSlope();
+  *slopeStepMax = 0.0;
+
+  for (unsigned long sampleIndex = 0; sampleIndex < TEMP_WARMUP_TIME * 1000000UL / TEMP_SAMPLE_INTERVAL; sampleIndex++) {
+    g_hostMicros += TEMP_SAMPLE_INTERVAL;
+    float temperatureChange = TEMP_WARMUP_DELTA * (g_hostMicros - startTime) / (TEMP_WARMUP_TIME * 1000000.0);
+    if (sampleIndex % (JOY_TEMP_READ_PERIOD / TEMP_SAMPLE_INTERVAL) == 0) {
+      js._sensorTemperature = JOY_SENSOR_TEMP_REFERENCE + temperatureChange;
+      js._temperatureReadCount++;
+    }
+
+    pointFloatType inputPoint;
+    inputPoint.x = TEMP_CENTER_X + TEMP_DRIFT_X * temperatureChange + touchNoise * hostRandom(&noiseSeed);
+    inputPoint.y = TEMP_CENTER_Y + TEMP_DRIFT_Y * temperatureChange + touchNoise * hostRandom(&noiseSeed);
+    js.update(inputPoint, g_hostMicros);
+
+    pointFloatType slope = js.getTemperatureSlope();
+    *slopeStepMax = max(*slopeStepMax, max(fabsf(slope.x - previousSlope.x), fabsf(slope.y - previousSlope.y)));
+    previousSlope = slope;
+  }
+}
+
+int main() {
+  float slopeStepMax = 0.0;
+
+  // Resting joystick: the drift is learned, one limited step per temperature reading
+  LSJoystick restingJs;
+  loadCalibration(restingJs);
+  warmUp(restingJs, 0.0, &slopeStepMax);
+  pointFloatType slope = restingJs.getTemperatureSlope();
+  printf("resting: slope %.3f|%.3f mT/C, largest step %.4f\n", slope.x, slope.y, slopeStepMax);
+  HOST_CHECK_NEAR(slope.x, TEMP_DRIFT_X, 0.02);
+  HOST_CHECK_NEAR(slope.y, TEMP_DRIFT_Y, 0.02);
+  HOST_CHECK(slopeStepMax <= JOY_TEMP_SLOPE_STEP_MAX + 1e-6);
+  HOST_CHECK(restingJs.getXOut() == 0 && restingJs.getYOut() == 0);
+
+  // Finger resting on the joystick: it moves less than the deadzone, but it isn't still
+  LSJoystick touchedJs;
+  loadCalibration(touchedJs);
+  warmUp(touchedJs, TEMP_TOUCH_NOISE, &slopeStepMax);
+  slope = touchedJs.getTemperatureSlope();
+  printf("touched: slope %.3f|%.3f mT/C\n", slope.x, slope.y);
+  HOST_CHECK(slope.x == 0.0 && slope.y == 0.0);
+
+  // Calibration running: its readings are not learned
+  LSJoystick calibratingJs;
+  loadCalibration(calibratingJs);
+  calibratingJs.setCalibrationMode(true);
+  warmUp(calibratingJs, 0.0, &slopeStepMax);
+  slope = calibratingJs.getTemperatureSlope();
+  pointFloatType shift = calibratingJs.getAutoCenterShift();
+  printf("calibrating: slope %.3f|%.3f mT/C\n", slope.x, slope.y);
+  HOST_CHECK(slope.x == 0.0 && slope.y == 0.0);
+  HOST_CHECK(shift.x == 0.0 && shift.y == 0.0);
+
+  return hostTestResult("test_temperature");
+}
@@ -0,0 +1,252 @@
+/*
+* File: test_timer.cpp
+* Firmware: Willow (host tests)
+* Developed by: MakersMakingChange
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Checks the LSTimer deadline tracking with simulated time, and measures how much of the time the
+// loop() of the firmware sleeps with its poll timers.
+
+#include "HostTest.h"
+#include "LSTimer.h"
+
+#define TIMER_TEST_SIZE 4
+#define IDLE_TEST_TIME 10000UL           // Simulated run time of the idle test (ms)
+#define IDLE_CALLBACK_TIME 300UL         // Simulated execution time of each poll callback (us)
+
+int fastCallCount = 0;
+int slowCallCount = 0;
+
+void fastCallback() { fastCallCount++; }
+void slowCallback() { slowCallCount++; }
+void pollCallback() { g_hostMicros += IDLE_CALLBACK_TIME; }
+void blockingCallback() { delay(5); }
+
+//***ADVANCE FUNCTION***//
+// Function   : advance
+//
+// Description: Advance the simulated time 1 ms at a time and call run() after each step
+//
+// Parameters : timers : LSTimer<TIMER_TEST_SIZE>& : Timers to run
+//              duration : unsigned long : Time to advance (ms)
+//
+// Return     : void
+//****************************************//
+void advance(LSTimer<TIMER_TEST_SIZE>& timers, unsigned long duration) {
+  for (unsigned long step = 0; step < duration; step++) {
+    g_hostMicros += 1000UL;
+    timers.run();
+  }
+}
+
+//***TEST DISABLED BEFORE FIRST RUN FUNCTION***//
+// Function   : testDisabledBeforeFirstRun
+//
+// Description: A timer with no start delay disabled before its first run (like CONF_TIMER_USB) must not
+//              pin the deadline to now or be called, and must run again once it is enabled.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testDisabledBeforeFirstRun() {
+  LSTimer<TIMER_TEST_SIZE> timers;
+  fastCallCount = 0;
+  slowCallCount = 0;
+
+  int slowId = timers.setInterval(500, 0, slowCallback);
+  int fastId = timers.setInterval(10, 0, fastCallback);
+  timers.disable(slowId);
+
+  timers.run();
+  HOST_CHECK(fastCallCount == 1 && slowCallCount == 0);
+  HOST_CHECK(timers.nextDeadline() == 10);              // Not 0 from the disabled zero delay first run
+
+  advance(timers, 1000);
+  HOST_CHECK(fastCallCount == 101);
+  HOST_CHECK(slowCallCount == 0);
+  HOST_CHECK(timers.nextDeadline() <= 10);
+
+  // Only disabled timers left: nothing is due
+  timers.disable(fastId);
+  advance(timers, 10);
+  HOST_CHECK(timers.nextDeadline() == timers.NO_DEADLINE);
+  advance(timers, 100);
+  HOST_CHECK(fastCallCount == 101);
+
+  // Enabling starts a new scan
+  timers.enable(slowId);
+  HOST_CHECK(timers.nextDeadline() == 0);
+  timers.run();
+  HOST_CHECK(slowCallCount == 1);
+  HOST_CHECK(timers.nextDeadline() > 0 && timers.nextDeadline() <= 500);
+}
+
+//***TEST CATCH-UP POLICY FUNCTION***//
+// Function   : testCatchupPolicy
+//
+// Description: A timer that is 3.5 periods late runs once per missed period by default (TIMER_CATCHUP_BURST),
+//              once with TIMER_CATCHUP_COALESCE and not until the next period with TIMER_CATCHUP_SKIP.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testCatchupPolicy() {
+  const unsigned policies[] = {TIMER_CATCHUP_BURST, TIMER_CATCHUP_COALESCE, TIMER_CATCHUP_SKIP};
+  const int expectedCalls[] = {3, 1, 0};
+  const unsigned long expectedMissed[] = {0, 2, 3};
+
+  for (int policyIndex = 0; policyIndex < 3; policyIndex++) {
+    LSTimer<TIMER_TEST_SIZE> timers;
+    fastCallCount = 0;
+    int fastId = timers.setInterval(10, 0, fastCallback);
+    if (policyIndex > 0) {
+      timers.setCatchupPolicy(fastId, policies[policyIndex]);
+    }
+    timers.run();                                       // First run
+    fastCallCount = 0;
+
+    g_hostMicros += 35000UL;                            // 3.5 periods late
+    for (int runIndex = 0; runIndex < 5; runIndex++) {  // Several passes at the same time
+      timers.run();
+    }
+    HOST_CHECK(fastCallCount == expectedCalls[policyIndex]);
+    HOST_CHECK(timers.getStats(fastId).missedPeriods == expectedMissed[policyIndex]);
+
+    advance(timers, 5);                                 // Back on the period grid
+    HOST_CHECK(fastCallCount == expectedCalls[policyIndex] + 1);
+  }
+}
+
+//***TEST EXECUTION TIME FUNCTION***//
+// Function   : testExecutionTime
+//
+// Description: The callback execution time is wall time, so a callback that blocks in delay() (where the
+//              core may sleep and the DWT cycle counter stops) is measured with the time it blocked.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testExecutionTime() {
+  LSTimer<TIMER_TEST_SIZE> timers;
+  int blockingId = timers.setInterval(20, 0, blockingCallback);
+  advance(timers, 100);
+
+  timerStatsStruct stats = timers.getStats(blockingId);
+  unsigned long histogram[TIMER_HISTOGRAM_BINS];
+  timers.getHistogram(blockingId, histogram);
+  HOST_CHECK(stats.numSamples > 0);
+  HOST_CHECK(stats.executionTimeAverage == 5000 && stats.executionTimeMax == 5000);
+  HOST_CHECK(histogram[7] == stats.numSamples);                 // 4096 to 8191 us
+}
+
+//***TEST INVALID TIMER ID FUNCTION***//
+// Function   : testInvalidTimerId
+//
+// Description: The -1 returned when no timer slot is free, and other out of range IDs, are rejected by
+//              every timer function without touching the timers that are set. So is an out of range catch-up policy.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testInvalidTimerId() {
+  LSTimer<2> timers;
+  fastCallCount = 0;
+  timers.setInterval(10, 0, fastCallback);
+  timers.setInterval(10, 0, fastCallback);
+  int fullId = timers.setInterval(10, 0, slowCallback);
+  HOST_CHECK(fullId == -1);
+
+  const int invalidIds[] = {fullId, -100, 2, 100};
+  for (int invalidId : invalidIds) {
+    timers.disable(invalidId);
+    timers.enable(invalidId);
+    timers.toggle(invalidId);
+    timers.restartTimer(invalidId);
+    timers.setCatchupPolicy(invalidId, TIMER_CATCHUP_SKIP);
+    timers.resetStats(invalidId);
+    HOST_CHECK(!timers.isEnabled(invalidId));
+    HOST_CHECK(timers.getNumRuns(invalidId) == 0);
+    HOST_CHECK(timers.elapsedTime(invalidId) == 0);
+    HOST_CHECK(timers.deleteTimer(invalidId) == -1);
+    HOST_CHECK(timers.getStats(invalidId).numSamples == 0);
+  }
+
+  timers.setCatchupPolicy(0, TIMER_CATCHUP_SKIP + 1);  // Invalid policy on a valid timer is ignored
+
+  HOST_CHECK(timers.getNumTimers() == 2);
+  HOST_CHECK(timers.isEnabled(0) && timers.isEnabled(1));
+  timers.run();
+  HOST_CHECK(fastCallCount == 2);
+}
+
+//***TEST IDLE SLEEP FUNCTION***//
+// Function   : testIdleSleep
+//
+// Description: Runs the poll timers of setup() (CONF_TIMER_USB disabled) the way loop() and idleLoop() do,
+//              with each callback taking IDLE_CALLBACK_TIME, and measures the share of the time spent in the
+//              idle delay. Without the deadline fix the disabled timer kept nextDeadline() at 0 and loop() spun.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testIdleSleep() {
+  LSTimer<CONF_POLL_TIMER_SIZE> pollTimer;
+  const unsigned long pollRates[CONF_POLL_TIMER_SIZE] = {
+    CONF_JOYSTICK_POLL_RATE, CONF_INPUT_POLL_RATE, CONF_BT_FEEDBACK_POLL_RATE, CONF_DEBUG_POLL_RATE, CONF_SCROLL_POLL_RATE,
+    CONF_SCREEN_POLL_RATE, CONF_USB_POLL_RATE, CONF_WATCHDOG_POLL_RATE, CONF_MEMORY_POLL_RATE
+  };
+  for (int timerIndex = 0; timerIndex < CONF_POLL_TIMER_SIZE; timerIndex++) {
+    pollTimer.setInterval(pollRates[timerIndex], 0, pollCallback);
+  }
+  for (int timerIndex = 0; timerIndex < CONF_POLL_TIMER_SIZE; timerIndex++) {
+    pollTimer.setCatchupPolicy(timerIndex, TIMER_CATCHUP_COALESCE);
+  }
+  pollTimer.setCatchupPolicy(CONF_TIMER_SCREEN, TIMER_CATCHUP_SKIP);
+  pollTimer.disable(CONF_TIMER_USB);
+
+  unsigned long startTime = g_hostMicros;
+  unsigned long idleDelayTime = 0;
+  unsigned long loopCount = 0;
+  while (g_hostMicros - startTime < IDLE_TEST_TIME * 1000UL && loopCount < IDLE_TEST_TIME) {   // A spinning loop doesn't advance the time
+    pollTimer.run();
+    unsigned long idleTime = min((unsigned long)CONF_IDLE_MAX_TIME, pollTimer.nextDeadline());
+    if (idleTime > 0) {
+      unsigned long delayStart = micros();
+      delay(idleTime);
+      idleDelayTime += micros() - delayStart;
+    }
+    loopCount++;
+  }
+
+  // Busy time: joystick, input and screen callbacks every 20 ms and a scroll callback every 30 ms, about 5.5%
+  float idleShare = (float)idleDelayTime / (g_hostMicros - startTime);
+  printf("idle: %lu loop passes in %lu ms, %.1f%% of the time in the idle delay\n", loopCount, (g_hostMicros - startTime) / 1000UL, 100.0 * idleShare);
+  HOST_CHECK(idleShare > 0.9);
+  HOST_CHECK(loopCount < IDLE_TEST_TIME / 5);                    // About one pass per deadline, not a spin
+}
+
+int main() {
+  testDisabledBeforeFirstRun();
+  testCatchupPolicy();
+  testExecutionTime();
+  testInvalidTimerId();
+  testIdleSleep();
+
+  return hostTestResult("test_timer");
+}
@@ -18,102 +18,92 @@
 
 
 //***API FUNCTIONS***// - DO NOT CHANGE
-typedef void (*FunctionPointer)(bool, bool, String);      // Type definition for API function pointer
+typedef void (*FunctionPointer)(bool, bool, const char*);      // Type definition for API function pointer
 
 typedef struct {                                  // Type definition for API function list
-  String endpoint;                                // Unique two character end point
-  String code;                                    // Unique one character command code
-  String parameter;                               // Parameter that is passed to function
+  uint32_t key;                                   // Unique two character end point and one character command code packed by API_KEY
+  const char* parameter;                          // Parameter that is passed to function, or "" for any numeric parameter
   FunctionPointer function;                       // API function pointer
 } _functionList;
 
-// Declare individual API functions with command, parameter, and corresponding function
-_functionList getModelNumberFunction =            {"MN", "0", "0", &getModelNumber};
-_functionList getVersionNumberFunction =          {"VN", "0", "0", &getVersionNumber};
-_functionList getDeviceIDFunction =               {"ID", "0", "0", &getDeviceID};
-_functionList getOperatingModeFunction =          {"OM", "0", "0", &getOperatingMode};
-_functionList setOperatingModeFunction =          {"OM", "1", "",  &setOperatingMode};
-_functionList getCommunicationModeFunction =      {"CM", "0", "0", &getCommunicationMode};
-_functionList setCommunicationModeFunction =      {"CM", "1", "",  &setCommunicationMode};
-
-_functionList getJoystickInitializationFunction = {"IN", "0", "0", &getJoystickInitialization};
-_functionList setJoystickInitializationFunction = {"IN", "1", "1", &setJoystickInitialization};
-_functionList getJoystickCalibrationFunction =    {"CA", "0", "0", &getJoystickCalibration};
-_functionList setJoystickCalibrationFunction =    {"CA", "1", "1", &setJoystickCalibration};
-
-_functionList getJoystickInnerDeadzoneFunction =  {"IZ", "0", "0", &getJoystickInnerDeadzone};
-_functionList setJoystickInnerDeadzoneFunction =  {"IZ", "1", "",  &setJoystickInnerDeadzone};
-_functionList getJoystickOuterDeadzoneFunction =  {"OZ", "0", "0", &getJoystickOuterDeadzone};
-_functionList setJoystickUpperDeadzoneFunction =  {"OZ", "1", "",  &setJoystickOuterDeadzone};
-_functionList getJoystickAccelerationFunction =   {"AV", "0", "0", &getJoystickAcceleration};
-_functionList setJoystickAccelerationFunction =   {"AV", "1", "0", &setJoystickAcceleration};
-
-_functionList getCursorSpeedFunction =            {"SS", "0", "0", &getCursorSpeed};
-_functionList setCursorSpeedFunction =            {"SS", "1", "",  &setCursorSpeed};
-_functionList getScrollLevelFunction =            {"SL", "0", "0", &getScrollLevel};
-_functionList setScrollLevelFunction =            {"SL", "1", "",  &setScrollLevel};
-
-_functionList getSoundModeFunction =              {"SM", "0", "0", &getSoundMode};
-_functionList setSoundModeFunction =              {"SM", "1", "",  &setSoundMode};
-_functionList getLightModeFunction =              {"LM", "0", "0", &getLightMode};
-_functionList setLightModeFunction =              {"LM", "1", "",  &setLightMode};
-_functionList getLightBrightnessLevelFunction =   {"LL", "0", "0", &getLightBrightnessLevel};
-_functionList setLightBrightnessLevelFunction =   {"LL", "1", "",  &setLightBrightnessLevel};
-
-_functionList controlHubMenuFunction =            {"CH", "1", "",  &controlHubMenu};
-
-_functionList getDebugModeFunction =              {"DM", "0", "0", &getDebugMode};
-_functionList setDebugModeFunction =              {"DM", "1", "",  &setDebugMode};
-_functionList getJoystickValueFunction =          {"JV", "0", "0", &getJoystickValue};
-
-_functionList runTestFunction =                   {"RT", "1", "",  &runTest};
-_functionList softResetFunction =                 {"SR", "1", "1", &softReset};
-_functionList resetSettingsFunction =             {"RS", "1", "1", &resetSettings};
-_functionList factoryResetFunction =              {"FR", "1", "1", &doFactoryReset};
-
-// Declare array of API functions
-_functionList apiFunction[] = { //Let compiler determine number of functions
-  getModelNumberFunction,
-  getVersionNumberFunction,
-  getDeviceIDFunction,
-  getOperatingModeFunction,
-  setOperatingModeFunction,
-  getCommunicationModeFunction,
-  setCommunicationModeFunction,
-  getJoystickInitializationFunction,
-  setJoystickInitializationFunction,
-  getJoystickCalibrationFunction,
-  setJoystickCalibrationFunction,
-  getJoystickInnerDeadzoneFunction,
-  setJoystickInnerDeadzoneFunction,
-  getJoystickOuterDeadzoneFunction,
-  setJoystickUpperDeadzoneFunction,
-  getCursorSpeedFunction,
-  setCursorSpeedFunction,
-  getScrollLevelFunction,
-  setScrollLevelFunction,
-  getJoystickValueFunction,
-  getJoystickAccelerationFunction,
-  setJoystickAccelerationFunction,
-  getSoundModeFunction,
-  setSoundModeFunction,
-  getLightModeFunction,
-  setLightModeFunction,
-  getLightBrightnessLevelFunction,
-  setLightBrightnessLevelFunction,
-  controlHubMenuFunction,
-  getDebugModeFunction,
-  setDebugModeFunction,
-  runTestFunction,
-  softResetFunction,
-  resetSettingsFunction,
-  factoryResetFunction
+#define API_KEY(endpoint, code) (((uint32_t)(uint8_t)(endpoint)[0] << 16) | ((uint32_t)(uint8_t)(endpoint)[1] << 8) | (uint32_t)(uint8_t)(code))
+
+// Declare array of API functions with command, parameter, and corresponding function
+// Keep sorted by end point and then command code, performCommand uses a binary search
+constexpr _functionList apiFunction[] = {
+  {API_KEY("AV", '0'), "0", &getJoystickAcceleration},
+  {API_KEY("AV", '1'), "",  &setJoystickAcceleration},
+  {API_KEY("CA", '0'), "0", &getJoystickCalibration},
+  {API_KEY("CA", '1'), "1", &setJoystickCalibration},
+  {API_KEY("CH", '1'), "",  &controlHubMenu},
+  {API_KEY("CM", '0'), "0", &getCommunicationMode},
+  {API_KEY("CM", '1'), "",  &setCommunicationMode},
+  {API_KEY("CR", '0'), "0", &getJoystickRangeMap},
+  {API_KEY("CR", '1'), "",  &setJoystickRangeMap},
+  {API_KEY("DM", '0'), "0", &getDebugMode},
+  {API_KEY("DM", '1'), "",  &setDebugMode},
+  {API_KEY("FB", '0'), "0", &getJoystickFilterBeta},
+  {API_KEY("FB", '1'), "",  &setJoystickFilterBeta},
+  {API_KEY("FC", '0'), "0", &getJoystickFilterCutoff},
+  {API_KEY("FC", '1'), "",  &setJoystickFilterCutoff},
+  {API_KEY("FR", '1'), "1", &doFactoryReset},
+  {API_KEY("ID", '0'), "0", &getDeviceID},
+  {API_KEY("IN", '0'), "0", &getJoystickInitialization},
+  {API_KEY("IN", '1'), "1", &setJoystickInitialization},
+  {API_KEY("IZ", '0'), "0", &getJoystickInnerDeadzone},
+  {API_KEY("IZ", '1'), "",  &setJoystickInnerDeadzone},
+  {API_KEY("JF", '0'), "0", &getJoystickFaults},
+  {API_KEY("JF", '1'), "0", &resetJoystickFaults},
+  {API_KEY("JT", '0'), "0", &getJoystickTemperature},
+  {API_KEY("JT", '1'), "0", &resetJoystickTemperature},
+  {API_KEY("JV", '0'), "0", &getJoystickValue},
+  {API_KEY("LL", '0'), "0", &getLightBrightnessLevel},
+  {API_KEY("LL", '1'), "",  &setLightBrightnessLevel},
+  {API_KEY("LM", '0'), "0", &getLightMode},
+  {API_KEY("LM", '1'), "",  &setLightMode},
+  {API_KEY("MN", '0'), "0", &getModelNumber},
+  {API_KEY("OM", '0'), "0", &getOperatingMode},
+  {API_KEY("OM", '1'), "",  &setOperatingMode},
+  {API_KEY("OZ", '0'), "0", &getJoystickOuterDeadzone},
+  {API_KEY("OZ", '1'), "",  &setJoystickOuterDeadzone},
+  {API_KEY("RS", '1'), "1", &resetSettings},
+  {API_KEY("RT", '1'), "",  &runTest},
+  {API_KEY("SJ", '0'), "0", &getSettingsJson},
+  {API_KEY("SJ", '1'), "",  &setSettingsJson},
+  {API_KEY("SL", '0'), "0", &getScrollLevel},
+  {API_KEY("SL", '1'), "",  &setScrollLevel},
+  {API_KEY("SM", '0'), "0", &getSoundMode},
+  {API_KEY("SM", '1'), "",  &setSoundMode},
+  {API_KEY("SR", '1'), "1", &softReset},
+  {API_KEY("SS", '0'), "0", &getCursorSpeed},
+  {API_KEY("SS", '1'), "",  &setCursorSpeed},
+  {API_KEY("TI", '0'), "0", &getIdleStats},
+  {API_KEY("TP", '0'), "",  &getTimerProfile},
+  {API_KEY("TS", '0'), "",  &getTimerStats},
+  {API_KEY("TS", '1'), "",  &resetTimerStats},
+  {API_KEY("VN", '0'), "0", &getVersionNumber}
 };
 
+constexpr int apiTotalNumber = sizeof(apiFunction) / sizeof(apiFunction[0]);
+
+struct apiFunctionOrder {                         // Compile time check of the apiFunction order (member function, so no sketch prototype is generated)
+  static constexpr bool isSorted(int apiIndex) {
+    return (apiIndex + 1 >= apiTotalNumber) || (apiFunction[apiIndex].key < apiFunction[apiIndex + 1].key && isSorted(apiIndex + 1));
+  }
+};
+static_assert(apiFunctionOrder::isSorted(0), "apiFunction must be sorted by end point and command code");
+
+char apiInputBuffer[CONF_API_INPUT_BUFFER_SIZE];  // Characters of the command being received
+int apiInputLength = 0;
+bool apiInputOverflow = false;                    // Command was longer than the buffer and is discarded
+unsigned long apiInputTime = 0;                   // Time the last character was received in ms
+
 //***SERIAL SETTINGS FUNCTION TO CHANGE SPEED AND COMMUNICATION MODE USING SOFTWARE***//
 // Function   : serialSettings
 //
-// Description: This function confirms if serial settings should be enabled.
+// Description: This function collects the characters received on the serial port without blocking.
+//              A command ends with a line ending, or with a pause of CONF_API_INPUT_TIMEOUT
+//              for hosts that send commands without one. Complete commands are processed.
 //              It returns true if it's in the settings mode and is waiting for a command.
 //              It returns false if it's not in the settings mode or it needs to exit the settings mode.
 //
@@ -123,32 +113,71 @@ _functionList apiFunction[] = { //Let compiler determine number of functions
 //*************************************************************************************//
 bool serialSettings(bool enabled) {
 
-  String commandString = "";
   bool settingsFlag = enabled;
 
-  // Set the input parameter to the flag returned. This will help to detect that the settings actions should be performed.
-  if (Serial.available() > 0)
-  {
-    // Check if serial has received or read input string and word "SETTINGS" is in input string.
-    commandString = Serial.readString();
-    if (settingsFlag == false && commandString == "SETTINGS") {
-      // SETTING received
-      // Set the return flag to true so settings actions can be performed in the next call to the function
-      printResponseInt(true, true, true, 0, commandString, false, 0);
-      settingsFlag = true;
-    } else if (settingsFlag == true && commandString == "EXIT") {
-      // EXIT Received
-      // Set the return flag to false so settings actions can be exited
-      printResponseInt(true, true, true, 0, commandString, false, 0);
-      settingsFlag = false;
-    } else if (settingsFlag == true && isValidCommandFormat(commandString)) { // Check if command's format is correct and it's in settings mode
-      performCommand(commandString);                  // Sub function to process valid strings
-      settingsFlag = false;
+  while (Serial.available() > 0) {                // Only consume the characters already received
+    char inputChar = Serial.read();
+    apiInputTime = millis();
+    if (inputChar == '\n' || inputChar == '\r') {
+      settingsFlag = processSerialCommand(settingsFlag);
+    } else if (apiInputLength < CONF_API_INPUT_BUFFER_SIZE - 1) {
+      apiInputBuffer[apiInputLength++] = inputChar;
     } else {
-      printResponseInt(true, true, false, 0, commandString, false, 0);
-      settingsFlag = false;
+      apiInputOverflow = true;
     }
-    Serial.flush();
+  }
+
+  if ((apiInputLength > 0 || apiInputOverflow) && (millis() - apiInputTime >= CONF_API_INPUT_TIMEOUT)) {
+    settingsFlag = processSerialCommand(settingsFlag);
+  }
+  return settingsFlag;
+}
+
+//***PROCESS SERIAL COMMAND FUNCTION***//
+// Function   : processSerialCommand
+//
+// Description: This function processes the received command and clears the input buffer.
+//              It returns true if it's in the settings mode and is waiting for a command.
+//              It returns false if it's not in the settings mode or it needs to exit the settings mode.
+//
+// Parameters :  enabled : bool : The input flag
+//
+// Return     : bool
+//*********************************//
+bool processSerialCommand(bool enabled) {
+  bool settingsFlag = enabled;
+
+  apiInputBuffer[apiInputLength] = '\0';
+  const char* commandString = apiInputBuffer;     // Valid until the next character is received
+  bool inputOverflow = apiInputOverflow;
+  bool inputEmpty = (apiInputLength == 0);
+  apiInputLength = 0;
+  apiInputOverflow = false;
+
+  if (inputEmpty && !inputOverflow) {             // Second character of a CR LF line ending
+    return settingsFlag;
+  }
+
+  // Set the input parameter to the flag returned. This will help to detect that the settings actions should be performed.
+  if (inputOverflow) {
+    printResponseInt(true, true, false, 0, commandString, false, 0);
+    settingsFlag = false;
+  } else if (settingsFlag == false && strcmp(commandString, "SETTINGS") == 0) {
+    // SETTING received
+    // Set the return flag to true so settings actions can be performed in the next call to the function
+    printResponseInt(true, true, true, 0, commandString, false, 0);
+    settingsFlag = true;
+  } else if (settingsFlag == true && strcmp(commandString, "EXIT") == 0) {
+    // EXIT Received
+    // Set the return flag to false so settings actions can be exited
+    printResponseInt(true, true, true, 0, commandString, false, 0);
+    settingsFlag = false;
+  } else if (settingsFlag == true && isValidCommandFormat(commandString)) { // Check if command's format is correct and it's in settings mode
+    performCommand(commandString);                  // Sub function to process valid strings
+    settingsFlag = false;
+  } else {
+    printResponseInt(true, true, false, 0, commandString, false, 0);
+    settingsFlag = false;
   }
   return settingsFlag;
 }
@@ -158,59 +187,59 @@ bool serialSettings(bool enabled) {
 //
 // Description: This function takes processes an input string from the serial and calls the
 //              corresponding API function, or outputs an error.
+//              The input string must already have the format checked by isValidCommandFormat.
 //
-// Parameters :  inputString : String : The input command as a string.
+// Parameters :  inputString : const char* : The input command as a string.
 //
 // Return     : void
 //*********************************//
-void performCommand(String inputString) {
-  int inputIndex = inputString.indexOf(':');
-
-  // Extract command string from input string
-  String inputCommandString = inputString.substring(0, inputIndex);
-
-  int inputCommandIndex = inputCommandString.indexOf(',');
-
-  String inputEndpointString = inputCommandString.substring(0, inputCommandIndex);
-
-  String inputCodeString = inputCommandString.substring(inputCommandIndex + 1);
-
-  // Extract parameter string from input string
-  String inputParameterString = inputString.substring(inputIndex + 1);
+void performCommand(const char* inputString) {
+  uint32_t inputKey = API_KEY(inputString, inputString[3]);  // XX,d:
+  const char* inputParameterString = inputString + 5;
 
-  // Determine total number of API commands
-  int apiTotalNumber = sizeof(apiFunction) / sizeof(apiFunction[0]);
+  int apiIndex = findApiFunction(inputKey);
 
-  // Iterate through each API command
-  for (int apiIndex = 0; apiIndex < apiTotalNumber; apiIndex++) {
+  if (apiIndex < 0) { // api doesn’t exist
 
-    // Test if input command string matches API command and input parameter string matches API parameter string
-    if (inputEndpointString == apiFunction[apiIndex].endpoint &&
-        inputCodeString == apiFunction[apiIndex].code) {
-
-      // Matching Command String found
-      if (!isValidCommandParameter( inputParameterString )) {
-        printResponseInt(true, true, false, 2, inputString, false, 0);
-      }
-      else if (inputParameterString == apiFunction[apiIndex].parameter || apiFunction[apiIndex].parameter == "") {
-        apiFunction[apiIndex].function(true, true, inputParameterString);
-      }
-      else { // Invalid input parameter
-
-        // Outut error message
-        printResponseInt(true, true, false, 3, inputString, false, 0);
-      }
-      break;
-    } else if (apiIndex == (apiTotalNumber - 1)) { // api doesn’t exist
+    // Output error message
+    printResponseInt(true, true, false, 1, inputString, false, 0);
+  }
+  else if (!isValidCommandParameter(inputParameterString) && inputKey != API_KEY("SJ", '1')) { // Settings import takes a json parameter
+    printResponseInt(true, true, false, 2, inputString, false, 0);
+  }
+  else if (apiFunction[apiIndex].parameter[0] == '\0' || strcmp(inputParameterString, apiFunction[apiIndex].parameter) == 0) {
+    apiFunction[apiIndex].function(true, true, inputParameterString);
+  }
+  else { // Invalid input parameter
 
-      // Output error message
-      printResponseInt(true, true, false, 1, inputString, false, 0);
+    // Outut error message
+    printResponseInt(true, true, false, 3, inputString, false, 0);
+  }
+}
 
-      //delay(5);
-      break;
+//***FIND API FUNCTION FUNCTION***//
+// Function   : findApiFunction
+//
+// Description: This function finds the API function for a packed end point and command code.
+//
+// Parameters :  inputKey : uint32_t : The end point and command code packed by API_KEY.
+//
+// Return     : int : The index in apiFunction, or -1 if the command doesn't exist.
+//*********************************//
+int findApiFunction(uint32_t inputKey) {
+  int lowIndex = 0;
+  int highIndex = apiTotalNumber - 1;
+  while (lowIndex <= highIndex) {
+    int apiIndex = (lowIndex + highIndex) / 2;
+    if (apiFunction[apiIndex].key == inputKey) {
+      return apiIndex;
+    } else if (apiFunction[apiIndex].key < inputKey) {
+      lowIndex = apiIndex + 1;
+    } else {
+      highIndex = apiIndex - 1;
     }
-  } // end iterate through API functions
-
+  }
+  return -1;
 }
 
 //***VALIDATE INPUT COMMAND FORMAT FUNCTION***//
@@ -220,17 +249,21 @@ void performCommand(String inputString) {
 //              It returns true if the string has a correct format.
 //              It returns false if the string doesn't have a correct format.
 //
-// Parameters :  inputCommandString : String : The input string
+// Parameters :  inputCommandString : const char* : The input string
 //
 // Return     : boolean
 //***********************************************//
-bool isValidCommandFormat(String inputCommandString) {
+bool isValidCommandFormat(const char* inputCommandString) {
   bool isValidFormat = false;
-  if ((inputCommandString.length() == (6) || // XX,d:d
-       inputCommandString.length() == (7) || // XX,d:dd
-       inputCommandString.length() == (8) || // XX,d:ddd
-       inputCommandString.length() == (9) || // XX,d:dddd
-       inputCommandString.length() == (11)) && inputCommandString.charAt(2) == ',' && inputCommandString.charAt(4) == ':') { // XX,d:dddddd
+  size_t inputLength = strlen(inputCommandString);
+  if ((inputLength == (6) || // XX,d:d
+       inputLength == (7) || // XX,d:dd
+       inputLength == (8) || // XX,d:ddd
+       inputLength == (9) || // XX,d:dddd
+       inputLength == (11)) && inputCommandString[2] == ',' && inputCommandString[4] == ':') { // XX,d:dddddd
+    isValidFormat = true;
+  }
+  else if (strncmp(inputCommandString, "SJ,1:{", 6) == 0) { // SJ,1:{json}
     isValidFormat = true;
   }
   return isValidFormat;
@@ -243,11 +276,11 @@ bool isValidCommandFormat(String inputCommandString) {
 //              It returns true if the string includes valid parameters.
 //              It returns false if the string includes invalid parameters.
 //
-// Parameters :  inputParamterString : String : The input string
+// Parameters :  inputParamterString : const char* : The input string
 //
 // Return     : boolean
 //*************************************************//
-bool isValidCommandParameter(String inputParameterString) {
+bool isValidCommandParameter(const char* inputParameterString) {
   if (isStrNumber(inputParameterString)) {
     return true;
   }
@@ -261,14 +294,14 @@ bool isValidCommandParameter(String inputParameterString) {
 //              It returns true if the string includes all numeric characters.
 //              It returns false if the string includes a non numeric character.
 //
-// Parameters :  str : String : The input string
+// Parameters :  str : const char* : The input string
 //
 // Return     : boolean
 //******************************************//
-boolean isStrNumber(String str) {
+boolean isStrNumber(const char* str) {
   boolean isNumber = false;
-  for (byte i = 0; i < str.length(); i++) {
-    isNumber = isDigit(str.charAt(i)) || str.charAt(i) == '+' || str.charAt(i) == '.' || str.charAt(i) == '-';
+  for (size_t i = 0; str[i] != '\0'; i++) {
+    isNumber = isDigit(str[i]) || str[i] == '+' || str[i] == '.' || str[i] == '-';
     if (!isNumber) {
       return false; // Non numeric character detected
     }
@@ -309,7 +342,7 @@ bool isValidDelimiter(char inputDelimiter) {
 // Return     : void
 //*********************************//
 void getModelNumber(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "MN";
+  const char* commandKey = "MN";
   int tempModelNumber = mem.readInt(CONF_SETTINGS_FILE, commandKey);
   if (tempModelNumber != CONF_WILLOW_MODEL) {                          // If the previous firmware was different model then reset the settings
     resetSettings(false, false);
@@ -329,11 +362,11 @@ void getModelNumber(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getModelNumber(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getModelNumber(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getModelNumber(responseEnabled, apiEnabled);
   }
 }
@@ -351,8 +384,6 @@ void getModelNumber(bool responseEnabled, bool apiEnabled, String optionalParame
 // Return     : void
 //*********************************//
 void getVersionNumber(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "VN";
-  
   int tempMajorVersionNumber = mem.readInt(CONF_SETTINGS_FILE, "VN1");
   int tempMinorVersionNumber = mem.readInt(CONF_SETTINGS_FILE, "VN2");
   int tempRevVersionNumber = mem.readInt(CONF_SETTINGS_FILE, "VN3");
@@ -382,11 +413,17 @@ void getVersionNumber(bool responseEnabled, bool apiEnabled) {
     tempRevVersionNumber = CONF_WILLOW_VERSION_REV;                                    // And store the version number
     mem.writeInt(CONF_SETTINGS_FILE, "VN3", tempRevVersionNumber);
   }
-  
 
-  String tempWillowVersionStr = String(tempMajorVersionNumber) + "." + String(tempMinorVersionNumber) + "." + String(tempRevVersionNumber);
-  
-  printResponseString(responseEnabled, apiEnabled, true, 0, "VN,0", true, tempWillowVersionStr);
+
+  if (responseEnabled) {                                                               // Respond with major.minor.revision
+    beginResponse(apiEnabled, true, 0, "VN,0", true);
+    appendResponseInt(tempMajorVersionNumber);
+    appendResponseChar('.');
+    appendResponseInt(tempMinorVersionNumber);
+    appendResponseChar('.');
+    appendResponseInt(tempRevVersionNumber);
+    sendResponse();
+  }
 }
 //***GET VERSION API FUNCTION***//
 // Function   : getVersionNumber
@@ -397,11 +434,11 @@ void getVersionNumber(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getVersionNumber(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getVersionNumber(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getVersionNumber(responseEnabled, apiEnabled);
   }
 }
@@ -419,11 +456,12 @@ void getVersionNumber(bool responseEnabled, bool apiEnabled, String optionalPara
 // Return     : void
 //*********************************//
 void getDeviceID(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "ID";
-  String tempDeviceID = mem.readString(CONF_SETTINGS_FILE, commandKey);
-  String deviceID = readUID();
+  const char* commandKey = "ID";
+  char tempDeviceID[sizeof(settingsStruct::deviceID)];
+  mem.readString(CONF_SETTINGS_FILE, commandKey, tempDeviceID, sizeof(tempDeviceID));
+  const char* deviceID = readUID();
  
-  if (tempDeviceID != deviceID) {  // If string doesn't match, store to memory
+  if (strcmp(tempDeviceID, deviceID) != 0) {  // If string doesn't match, store to memory
     mem.writeString(CONF_SETTINGS_FILE, commandKey, deviceID);
   }
   g_deviceUID = deviceID; // Update global variable
@@ -440,11 +478,11 @@ void getDeviceID(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getDeviceID(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getDeviceID(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getDeviceID(responseEnabled, apiEnabled);
   }
 }
@@ -462,7 +500,7 @@ void getDeviceID(bool responseEnabled, bool apiEnabled, String optionalParameter
 // Return     : operatingState : intol : The current state of operating mode.
 //*********************************//
 int getOperatingMode(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "OM";
+  const char* commandKey = "OM";
   int tempOperatingMode;
   tempOperatingMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
 
@@ -484,11 +522,11 @@ int getOperatingMode(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getOperatingMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getOperatingMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getOperatingMode(responseEnabled, apiEnabled);
   }
 }
@@ -507,7 +545,7 @@ void getOperatingMode(bool responseEnabled, bool apiEnabled, String optionalPara
 // Return     : void
 //*********************************//
 void setOperatingMode(bool responseEnabled, bool apiEnabled, int inputOperatingMode) {
-  String commandKey = "OM";
+  const char* commandKey = "OM";
 
   if ((inputOperatingMode >= CONF_OPERATING_MODE_MIN) && (inputOperatingMode <= CONF_OPERATING_MODE_MAX)) {   
     if ((g_comMode == CONF_COM_MODE_BLE) && (inputOperatingMode == CONF_OPERATING_MODE_GAMEPAD)){
@@ -535,11 +573,11 @@ void setOperatingMode(bool responseEnabled, bool apiEnabled, int inputOperatingM
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setOperatingMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setOperatingMode(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setOperatingMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setOperatingMode(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
 
@@ -556,7 +594,7 @@ void setOperatingMode(bool responseEnabled, bool apiEnabled, String optionalPara
 // Return     : void
 //*********************************//
 int getCursorSpeed(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "SS";
+  const char* commandKey = "SS";
   int tempCursorSpeedLevel = CONF_JOY_CURSOR_SPEED_LEVEL_DEFAULT;
   if (CONF_API_ENABLED) {
     tempCursorSpeedLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
@@ -580,11 +618,11 @@ int getCursorSpeed(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getCursorSpeed(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getCursorSpeed(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getCursorSpeed(responseEnabled, apiEnabled);
   }
 }
@@ -603,7 +641,7 @@ void getCursorSpeed(bool responseEnabled, bool apiEnabled, String optionalParame
 // Return     : void
 //*********************************//
 void setCursorSpeed(bool responseEnabled, bool apiEnabled, int inputSpeedLevel) {
-  String commandKey = "SS";
+  const char* commandKey = "SS";
   bool isValidSpeed = true;
   int tempCursorSpeedLevel = inputSpeedLevel;
   
@@ -638,11 +676,11 @@ void setCursorSpeed(bool responseEnabled, bool apiEnabled, int inputSpeedLevel)
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setCursorSpeed(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setCursorSpeed(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setCursorSpeed(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setCursorSpeed(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
 
@@ -659,7 +697,7 @@ void setCursorSpeed(bool responseEnabled, bool apiEnabled, String optionalParame
 // Return     : void
 //*********************************//
 int getScrollLevel(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "SL";
+  const char* commandKey = "SL";
   int tempScrollLevel = CONF_SCROLL_LEVEL_DEFAULT;
   if (CONF_API_ENABLED) {
     tempScrollLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
@@ -683,11 +721,11 @@ int getScrollLevel(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getScrollLevel(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getScrollLevel(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getScrollLevel(responseEnabled, apiEnabled);
   }
 }
@@ -706,7 +744,7 @@ void getScrollLevel(bool responseEnabled, bool apiEnabled, String optionalParame
 // Return     : void
 //*********************************//
 void setScrollLevel(bool responseEnabled, bool apiEnabled, int inputScrollLevel) {
-  String commandKey = "SL";
+  const char* commandKey = "SL";
   bool isValidLevel = true;
   int tempScrollLevel = inputScrollLevel;
   
@@ -741,11 +779,11 @@ void setScrollLevel(bool responseEnabled, bool apiEnabled, int inputScrollLevel)
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setScrollLevel(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setScrollLevel(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setScrollLevel(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setScrollLevel(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
 
@@ -849,11 +887,11 @@ void getJoystickInitialization(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getJoystickInitialization(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getJoystickInitialization(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getJoystickInitialization(responseEnabled, apiEnabled);
   }
 }
@@ -871,9 +909,9 @@ void getJoystickInitialization(bool responseEnabled, bool apiEnabled, String opt
 // Return     : void
 //*********************************//
 void setJoystickInitialization(bool responseEnabled, bool apiEnabled) {
-  int stepNumber = 0;
-  canOutputAction = false;
-  calibrationTimerId[0] = calibrationTimer.setTimeout(CONF_JOY_INIT_START_DELAY, performJoystickCenter, (int *)stepNumber);  
+  if (!startCalibration(CONF_CALIB_STATE_CENTER_READING, CONF_JOY_INIT_START_DELAY)) {  // Another calibration is running
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "IN,1", true, 1);
+  }
 }
 //***SET JOYSTICK INITIALIZATION API FUNCTION***//
 // Function   : setJoystickInitialization
@@ -884,11 +922,11 @@ void setJoystickInitialization(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setJoystickInitialization(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 1) {
+void setJoystickInitialization(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 1) {
     setJoystickInitialization(responseEnabled, apiEnabled);
   }
 }
@@ -906,12 +944,12 @@ void setJoystickInitialization(bool responseEnabled, bool apiEnabled, String opt
 // Return     : void
 //*********************************//
 void getJoystickCalibration(bool responseEnabled, bool apiEnabled) {
-  String commandKey;
+  char commandKey[4];                             // "CA" and the point number
   pointFloatType calibrationPointArray[5];
   calibrationPointArray[0] = js.getInputCenter();
   for (int i = 1; i < 5; i++)
   {
-    commandKey = "CA" + String(i);
+    snprintf(commandKey, sizeof(commandKey), "CA%d", i);
     calibrationPointArray[i] = mem.readPoint(CONF_SETTINGS_FILE, commandKey);
     js.setInputMax(i, calibrationPointArray[i]);
   }
@@ -928,11 +966,11 @@ void getJoystickCalibration(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getJoystickCalibration(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getJoystickCalibration(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getJoystickCalibration(responseEnabled, apiEnabled);
   }
 }
@@ -950,10 +988,9 @@ void getJoystickCalibration(bool responseEnabled, bool apiEnabled, String option
 // Return     : void
 //*********************************//
 void setJoystickCalibration(bool responseEnabled, bool apiEnabled) {
-  js.clear();                                                                                           // Clear previous calibration values
-  int stepNumber = 0;
-  canOutputAction = false;
-  calibrationTimerId[0] = calibrationTimer.setTimeout(CONF_JOY_CALIB_START_DELAY, performJoystickCalibration, (int *)stepNumber);  // Start the process
+  if (!startCalibration(CONF_CALIB_STATE_FULL_START, CONF_JOY_CALIB_START_DELAY)) {  // Another calibration is running
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "CA,1", true, 1);
+  }
 }
 //***SET JOYSTICK CALIBRATION API FUNCTION***//
 // Function   : setJoystickCalibration
@@ -964,15 +1001,105 @@ void setJoystickCalibration(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setJoystickCalibration(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 1) {
+void setJoystickCalibration(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 1) {
     setJoystickCalibration(responseEnabled, apiEnabled);
   }
 }
 
+//*** GET JOYSTICK RANGE MAP FUNCTION***//
+// Function   : getJoystickRangeMap
+//
+// Description: This function loads the joystick range map from flash memory and retrieves its radius in each direction.
+//              The range map is used only after a complete range sweep was stored.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : void
+//*********************************//
+void getJoystickRangeMap(bool responseEnabled, bool apiEnabled) {
+  const char* commandKey = "CR";
+  uint8_t rangeMap[JOY_RANGE_MAP_SIZE];
+  float rangeMapArray[JOY_RANGE_MAP_SIZE];
+  mem.readBytes(CONF_SETTINGS_FILE, commandKey, rangeMap, JOY_RANGE_MAP_SIZE);
+  bool isValid = js.setRangeMap(rangeMap);
+  for (int i = 0; i < JOY_RANGE_MAP_SIZE; i++) {
+    rangeMapArray[i] = rangeMap[i] * JOY_RANGE_MAP_UNIT;                                              // Radius in mT
+  }
+  printResponseFloatArray(responseEnabled, apiEnabled, isValid, isValid ? 0 : 3, "CR,0", true, "", JOY_RANGE_MAP_SIZE, ',', rangeMapArray);
+}
+//***GET JOYSTICK RANGE MAP API FUNCTION***//
+// Function   : getJoystickRangeMap
+//
+// Description: This function is redefinition of main getJoystickRangeMap function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getJoystickRangeMap(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickRangeMap(responseEnabled, apiEnabled);
+  }
+}
+
+//*** SET JOYSTICK RANGE MAP FUNCTION***//
+// Function   : setJoystickRangeMap
+//
+// Description: This function starts the joystick range sweep or clears the stored range map.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               inputRangeMapMode : int : 1 = start the range sweep, 0 = clear the range map and use the calibration corners
+//
+// Return     : void
+//*********************************//
+void setJoystickRangeMap(bool responseEnabled, bool apiEnabled, int inputRangeMapMode) {
+  const char* commandKey = "CR";
+  uint8_t rangeMap[JOY_RANGE_MAP_SIZE];
+
+  if (inputRangeMapMode == 1) {
+    if (!startCalibration(CONF_CALIB_STATE_SWEEP_READING, CONF_JOY_SWEEP_START_DELAY)) {  // Another calibration is running
+      printResponseInt(responseEnabled, apiEnabled, false, 3, "CR,1", true, inputRangeMapMode);
+    }
+  }
+  else if (inputRangeMapMode == 0) {
+    js.clearRangeMap();
+    js.getRangeMap(rangeMap);
+    mem.writeBytes(CONF_SETTINGS_FILE, commandKey, rangeMap, JOY_RANGE_MAP_SIZE);
+    printResponseInt(responseEnabled, apiEnabled, true, 0, "CR,1", true, inputRangeMapMode);
+  }
+  else {
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "CR,1", true, inputRangeMapMode);
+  }
+}
+//***SET JOYSTICK RANGE MAP API FUNCTION***//
+// Function   : setJoystickRangeMap
+//
+// Description: This function is redefinition of main setJoystickRangeMap function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void setJoystickRangeMap(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setJoystickRangeMap(responseEnabled, apiEnabled, atoi(optionalParameter));
+}
+
 
 //*** GET JOYSTICK DEADZONE FUNCTION***//
 // Function   : getJoystickInnerDeadzone
@@ -987,7 +1114,7 @@ void setJoystickCalibration(bool responseEnabled, bool apiEnabled, String option
 // Return     : void
 //*********************************//
 float getJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled) {
-  String deadzoneCommand = "IZ";
+  const char* deadzoneCommand = "IZ";
   float tempDeadzone;
   tempDeadzone = mem.readFloat(CONF_SETTINGS_FILE, deadzoneCommand);
 
@@ -1008,11 +1135,11 @@ float getJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getJoystickInnerDeadzone(responseEnabled, apiEnabled);
   }
 }
@@ -1030,7 +1157,7 @@ void getJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, String opti
 // Return     : void
 //*********************************//
 void setJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, float inputDeadzone) {
-  String deadzoneCommand = "IZ";
+  const char* deadzoneCommand = "IZ";
   if ((inputDeadzone > CONF_JOY_DEADZONE_MIN) && (inputDeadzone <= CONF_JOY_DEADZONE_MAX)) {
     mem.writeFloat(CONF_SETTINGS_FILE, deadzoneCommand, inputDeadzone);
     js.setInnerDeadzone(true, inputDeadzone);
@@ -1049,11 +1176,11 @@ void setJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, float input
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setJoystickInnerDeadzone(responseEnabled, apiEnabled, optionalParameter.toFloat());
+void setJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setJoystickInnerDeadzone(responseEnabled, apiEnabled, atof(optionalParameter));
 }
 
 //*** GET JOYSTICK OUTER DEADZONE FUNCTION***//
@@ -1069,7 +1196,7 @@ void setJoystickInnerDeadzone(bool responseEnabled, bool apiEnabled, String opti
 // Return     : void
 //*********************************//
 float getJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled) {
-  String outerDeadzoneCommand = "OZ";
+  const char* outerDeadzoneCommand = "OZ";
   float tempOuterDeadzone;
   tempOuterDeadzone = mem.readFloat(CONF_SETTINGS_FILE, outerDeadzoneCommand);
 
@@ -1090,11 +1217,11 @@ float getJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getJoystickOuterDeadzone(responseEnabled, apiEnabled);
   }
 }
@@ -1113,7 +1240,7 @@ void getJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, String opti
 // Return     : void
 //*********************************//
 void setJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, float inputUpperDeadZone) {
-  String outerDeadzoneCommand = "OZ";
+  const char* outerDeadzoneCommand = "OZ";
   if ((inputUpperDeadZone > CONF_JOY_DEADZONE_MIN) && (inputUpperDeadZone <= CONF_JOY_DEADZONE_MAX)) {
     mem.writeFloat(CONF_SETTINGS_FILE, outerDeadzoneCommand, inputUpperDeadZone);
     js.setOuterDeadzone(true, inputUpperDeadZone);
@@ -1132,168 +1259,186 @@ void setJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, float input
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setJoystickOuterDeadzone(responseEnabled, apiEnabled, optionalParameter.toFloat());
+void setJoystickOuterDeadzone(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setJoystickOuterDeadzone(responseEnabled, apiEnabled, atof(optionalParameter));
 }
 
-//***GET JOYSTICK VALUE FUNCTION***//
-// Function   : getJoystickValue
+//*** GET JOYSTICK FILTER CUTOFF FUNCTION***//
+// Function   : getJoystickFilterCutoff
 //
-// Description: This function returns raw joystick value.
+// Description: This function retrieves the joystick smoothing filter cutoff frequency at rest.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
 //
-// Return     : void
+// Return     : tempFilterCutoff : float : The cutoff frequency in Hz (0 = filter off)
 //*********************************//
-void getJoystickValue(bool responseEnabled, bool apiEnabled) {
-  js.update();      // Request new values from joystick class
-  
-  const int outputArraySize = 6; 
-  float tempJoystickArray[outputArraySize];
-  
-  pointFloatType tempJoystickRaw = js.getXYRaw();                                 // Read the raw values
-  pointIntType tempJoystickIn = js.getXYIn();                                     // Read the input
-  pointIntType tempJoystickProcessed = js.getXYOut();                             // Read the filtered values  
-  
-  tempJoystickArray[0] = tempJoystickRaw.x;
-  tempJoystickArray[1] = tempJoystickRaw.y;
-  tempJoystickArray[2] = (float)tempJoystickIn.x;
-  tempJoystickArray[3] = (float)tempJoystickIn.y;
-  tempJoystickArray[4] = (float)tempJoystickProcessed.x;
-  tempJoystickArray[5] = (float)tempJoystickProcessed.y;
-  
-  printResponseFloatArray(responseEnabled, apiEnabled, true, 0, "JV,0", true, "", outputArraySize, ',', tempJoystickArray);
-  
-}
+float getJoystickFilterCutoff(bool responseEnabled, bool apiEnabled) {
+  const char* filterCutoffCommand = "FC";
+  float tempFilterCutoff;
+  tempFilterCutoff = mem.readFloat(CONF_SETTINGS_FILE, filterCutoffCommand);
 
-//***GET JOYSTICK VALUE API FUNCTION***//
-// Function   : getJoystickValue
+  if ((tempFilterCutoff < CONF_JOY_FILTER_CUTOFF_MIN) || (tempFilterCutoff > CONF_JOY_FILTER_CUTOFF_MAX)) {
+    tempFilterCutoff = CONF_JOY_FILTER_CUTOFF_DEFAULT;
+    mem.writeFloat(CONF_SETTINGS_FILE, filterCutoffCommand, tempFilterCutoff);
+  }
+  js.setFilterCutoff(tempFilterCutoff);
+  printResponseFloat(responseEnabled, apiEnabled, true, 0, "FC,0", true, tempFilterCutoff);
+  return tempFilterCutoff;
+}
+//***GET JOYSTICK FILTER CUTOFF API FUNCTION***//
+// Function   : getJoystickFilterCutoff
 //
-// Description: This function is redefinition of main getJoystickValue function to match the types of API function arguments.
+// Description: This function is redefinition of main getJoystickFilterCutoff function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getJoystickValue(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
-    getJoystickValue(responseEnabled, apiEnabled);
+void getJoystickFilterCutoff(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickFilterCutoff(responseEnabled, apiEnabled);
   }
 }
 
-//***GET JOYSTICK ACCELERATION FUNCTION***//
-// Function   : getJoystickAcceleration
+//*** SET JOYSTICK FILTER CUTOFF FUNCTION***//
+// Function   : setJoystickFilterCutoff
 //
-// Description: This function retrieves the current joystick speed level.
+// Description: This function sets the joystick smoothing filter cutoff frequency at rest.
+//              Lower values smooth more while the joystick is still. 0 turns the filter off.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
+//               inputFilterCutoff : float : The new cutoff frequency in Hz.
 //
 // Return     : void
 //*********************************//
-int getJoystickAcceleration(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "AV";
-  int tempJoystickAccelerationLevel = CONF_JOY_ACCELERATION_LEVEL_DEFAULT;
-  if (CONF_API_ENABLED) {
-    tempJoystickAccelerationLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
-    if ((tempJoystickAccelerationLevel < CONF_JOY_ACCELERATION_LEVEL_MIN) || (tempJoystickAccelerationLevel > CONF_JOY_ACCELERATION_LEVEL_MAX)) {
-      tempJoystickAccelerationLevel = CONF_JOY_ACCELERATION_LEVEL_DEFAULT;
-      mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempJoystickAccelerationLevel);
-    }
-    
+void setJoystickFilterCutoff(bool responseEnabled, bool apiEnabled, float inputFilterCutoff) {
+  const char* filterCutoffCommand = "FC";
+  if ((inputFilterCutoff >= CONF_JOY_FILTER_CUTOFF_MIN) && (inputFilterCutoff <= CONF_JOY_FILTER_CUTOFF_MAX)) {
+    mem.writeFloat(CONF_SETTINGS_FILE, filterCutoffCommand, inputFilterCutoff);
+    js.setFilterCutoff(inputFilterCutoff);
+    printResponseFloat(responseEnabled, apiEnabled, true, 0, "FC,1", true, inputFilterCutoff);
   }
-  printResponseInt(responseEnabled, apiEnabled, true, 0, "AV,0", true, tempJoystickAccelerationLevel);
+  else {
+    printResponseFloat(responseEnabled, apiEnabled, false, 3, "FC,1", true, inputFilterCutoff);
+  }
+}
+//***SET JOYSTICK FILTER CUTOFF API FUNCTION***//
+// Function   : setJoystickFilterCutoff
+//
+// Description: This function is redefinition of main setJoystickFilterCutoff function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain the new cutoff frequency.
+//
+// Return     : void
+void setJoystickFilterCutoff(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setJoystickFilterCutoff(responseEnabled, apiEnabled, atof(optionalParameter));
+}
 
-  return tempJoystickAccelerationLevel;
+//*** GET JOYSTICK FILTER BETA FUNCTION***//
+// Function   : getJoystickFilterBeta
+//
+// Description: This function retrieves the joystick smoothing filter speed coefficient.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : tempFilterBeta : float : The cutoff increase in Hz per mT/s
+//*********************************//
+float getJoystickFilterBeta(bool responseEnabled, bool apiEnabled) {
+  const char* filterBetaCommand = "FB";
+  float tempFilterBeta;
+  tempFilterBeta = mem.readFloat(CONF_SETTINGS_FILE, filterBetaCommand);
+
+  if ((tempFilterBeta < CONF_JOY_FILTER_BETA_MIN) || (tempFilterBeta > CONF_JOY_FILTER_BETA_MAX)) {
+    tempFilterBeta = CONF_JOY_FILTER_BETA_DEFAULT;
+    mem.writeFloat(CONF_SETTINGS_FILE, filterBetaCommand, tempFilterBeta);
+  }
+  js.setFilterBeta(tempFilterBeta);
+  printResponseFloat(responseEnabled, apiEnabled, true, 0, "FB,0", true, tempFilterBeta);
+  return tempFilterBeta;
 }
-//***GET JOYSTICK ACCELERATION IO API FUNCTION***//
-// Function   : getJoystickAcceleration
+//***GET JOYSTICK FILTER BETA API FUNCTION***//
+// Function   : getJoystickFilterBeta
 //
-// Description: This function is redefinition of main getJoystickAcceleration function to match the types of API function arguments.
+// Description: This function is redefinition of main getJoystickFilterBeta function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getJoystickAcceleration(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
-    getJoystickAcceleration(responseEnabled, apiEnabled);
+void getJoystickFilterBeta(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickFilterBeta(responseEnabled, apiEnabled);
   }
 }
 
-//***SET JOYSTICK ACCELERATION FUNCTION***//
-// Function   : setJoystickAcceleration
+//*** SET JOYSTICK FILTER BETA FUNCTION***//
+// Function   : setJoystickFilterBeta
 //
-// Description: This function sets the current joystick acceleration level.
+// Description: This function sets the joystick smoothing filter speed coefficient.
+//              Higher values reduce the lag during fast movements.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               inputAccelerationLevel : bool : The new joystick acceleration level.
+//               inputFilterBeta : float : The new cutoff increase in Hz per mT/s.
 //
 // Return     : void
 //*********************************//
-void setJoystickAcceleration(bool responseEnabled, bool apiEnabled, int inputAccelerationLevel) {
-  String commandKey = "AV";
-  bool isValidAcceleration = true;
-  int tempJoystickAccelerationLevel = inputAccelerationLevel;
-  
-  if ((tempJoystickAccelerationLevel >= CONF_JOY_ACCELERATION_LEVEL_MIN) && (tempJoystickAccelerationLevel <= CONF_JOY_ACCELERATION_LEVEL_MAX)) { // Check if inputAccelerationCounter is valid
-    // Valid inputAccelerationLevel
-    mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempJoystickAccelerationLevel);
-    if (!CONF_API_ENABLED) {
-      tempJoystickAccelerationLevel = CONF_JOY_ACCELERATION_LEVEL_DEFAULT;
-    }
-    isValidAcceleration = true;
+void setJoystickFilterBeta(bool responseEnabled, bool apiEnabled, float inputFilterBeta) {
+  const char* filterBetaCommand = "FB";
+  if ((inputFilterBeta >= CONF_JOY_FILTER_BETA_MIN) && (inputFilterBeta <= CONF_JOY_FILTER_BETA_MAX)) {
+    mem.writeFloat(CONF_SETTINGS_FILE, filterBetaCommand, inputFilterBeta);
+    js.setFilterBeta(inputFilterBeta);
+    printResponseFloat(responseEnabled, apiEnabled, true, 0, "FB,1", true, inputFilterBeta);
   }
   else {
-    // Invalid inputAccelerationLevel
-    tempJoystickAccelerationLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
-    isValidAcceleration = false;
+    printResponseFloat(responseEnabled, apiEnabled, false, 3, "FB,1", true, inputFilterBeta);
   }
-
-
-  int responseCode = 0;
-  (isValidAcceleration) ? responseCode = 0 : responseCode = 3;
-  printResponseInt(responseEnabled, apiEnabled, isValidAcceleration, responseCode, "AV,1", true, tempJoystickAccelerationLevel);
 }
-//***SET JOYSTICK ACCELERATION API FUNCTION***//
-// Function   : setJoystickAcceleration
+//***SET JOYSTICK FILTER BETA API FUNCTION***//
+// Function   : setJoystickFilterBeta
 //
-// Description: This function is redefinition of main setJoystickAcceleration function to match the types of API function arguments.
+// Description: This function is redefinition of main setJoystickFilterBeta function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain the new speed coefficient.
 //
 // Return     : void
-void setJoystickAcceleration(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setJoystickAcceleration(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setJoystickFilterBeta(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setJoystickFilterBeta(responseEnabled, apiEnabled, atof(optionalParameter));
 }
 
-
-
-//***INCREASE/ACCELERATE JOYSTICK MOVEMENT FUNCTION***//
-// Function   : increaseJoystickAcceleration
+//***GET JOYSTICK FAULTS FUNCTION***//
+// Function   : getJoystickFaults
 //
-// Description: This function increases the joystick acceleration level by one.
+// Description: This function returns the joystick sensor fault counters:
+//              spikes rejected, frozen frames, implausible frames, bus errors, sensor resets and dropped samples.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
@@ -1302,100 +1447,421 @@ void setJoystickAcceleration(bool responseEnabled, bool apiEnabled, String optio
 //
 // Return     : void
 //*********************************//
-void increaseJoystickAcceleration(bool responseEnabled, bool apiEnabled) {
-  int tempJoystickAccelerationLevel=acceleration;
-  tempJoystickAccelerationLevel++;
-  if(tempJoystickAccelerationLevel <= CONF_JOY_ACCELERATION_LEVEL_MAX) {
-    setJoystickAcceleration(responseEnabled, apiEnabled, tempJoystickAccelerationLevel);
-  } 
-  else {
-  }
+void getJoystickFaults(bool responseEnabled, bool apiEnabled) {
+  const int outputArraySize = 6;
+  int tempFaultArray[outputArraySize];
+
+  joystickFaultStruct tempFaults = js.getFaultStats();
 
+  tempFaultArray[0] = tempFaults.spikeCount;
+  tempFaultArray[1] = tempFaults.frozenCount;
+  tempFaultArray[2] = tempFaults.implausibleCount;
+  tempFaultArray[3] = tempFaults.busErrorCount;
+  tempFaultArray[4] = tempFaults.sensorResetCount;
+  tempFaultArray[5] = tempFaults.sampleDropCount;
+
+  printResponseIntArray(responseEnabled, apiEnabled, true, 0, "JF,0", true, "", outputArraySize, ',', tempFaultArray);
 }
 
-//***DECREASE/DECELERATE JOYSTICK MOVEMENT FUNCTION***//
-// Function   : decreaseJoystickAcceleration
+//***GET JOYSTICK FAULTS API FUNCTION***//
+// Function   : getJoystickFaults
 //
-// Description: This function decreases the joystick acceleration level by one.
+// Description: This function is redefinition of main getJoystickFaults function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-//*********************************//
-void decreaseJoystickAcceleration(bool responseEnabled, bool apiEnabled) {
-  int tempJoystickAccelerationLevel=acceleration;
-  tempJoystickAccelerationLevel--;
-  if(tempJoystickAccelerationLevel <= CONF_JOY_ACCELERATION_LEVEL_MIN){
-    setJoystickAcceleration(responseEnabled, apiEnabled, tempJoystickAccelerationLevel);
-  } 
-  else{
+void getJoystickFaults(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickFaults(responseEnabled, apiEnabled);
   }
-
 }
 
-//***GET COMMUNICATION MODE FUNCTION***//
-// Function   : getCommunicationMode
+//***RESET JOYSTICK FAULTS FUNCTION***//
+// Function   : resetJoystickFaults
 //
-// Description: This function retrieves the state of communication mode.
+// Description: This function clears the joystick sensor fault counters.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
 //
-// Return     : communicationMode : int : The current state of communication method.
+// Return     : void
 //*********************************//
-int getCommunicationMode(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "CM";
-  int tempComMode;
-  tempComMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
-
-  if ((tempComMode < CONF_COM_MODE_MIN) || (tempComMode > CONF_COM_MODE_MAX)) {
-    tempComMode = CONF_COM_MODE_DEFAULT;
-    mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempComMode);
-  }
-
-  printResponseInt(responseEnabled, apiEnabled, true, 0, "CM,0", true, tempComMode);
-
-  return tempComMode;
+void resetJoystickFaults(bool responseEnabled, bool apiEnabled) {
+  js.resetFaultStats();
+  printResponseInt(responseEnabled, apiEnabled, true, 0, "JF,1", true, 0);
 }
-//***GET COMMUNICATION MODE API FUNCTION***//
-// Function   : getCommunicationMode
+
+//***RESET JOYSTICK FAULTS API FUNCTION***//
+// Function   : resetJoystickFaults
 //
-// Description: This function is redefinition of main getCommunicationMode function to match the types of API function arguments.
+// Description: This function is redefinition of main resetJoystickFaults function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getCommunicationMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
-    getCommunicationMode(responseEnabled, apiEnabled);
+void resetJoystickFaults(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    resetJoystickFaults(responseEnabled, apiEnabled);
   }
 }
 
-//***SET COMMUNICATION MODE FUNCTION***//
-// Function   : setCommunicationMode
+//***GET JOYSTICK TEMPERATURE FUNCTION***//
+// Function   : getJoystickTemperature
 //
-// Description: This function sets the state of communication mode.
+// Description: This function returns the joystick sensor temperature compensation state:
+//              temperature (C), temperature at the last center reset (C), learned x and y drift (mT/C),
+//              and the x and y center correction currently applied, temperature and idle correction together (mT).
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               inputCommunicationMode : int : The new communication mode state ( 0 = None, 1 = USB , 2 = BLE )
 //
 // Return     : void
 //*********************************//
-void setCommunicationMode(bool responseEnabled, bool apiEnabled, int inputCommunicationMode) {
-  String commandKey = "CM";
-  
+void getJoystickTemperature(bool responseEnabled, bool apiEnabled) {
+  const int outputArraySize = 6;
+  float tempTemperatureArray[outputArraySize];
+
+  pointFloatType tempSlope = js.getTemperatureSlope();
+  pointFloatType tempCenter = js.getInputCenter();
+  pointFloatType tempCompensatedCenter = js.getCompensatedCenter();
+
+  tempTemperatureArray[0] = js.getTemperature();
+  tempTemperatureArray[1] = js.getReferenceTemperature();
+  tempTemperatureArray[2] = tempSlope.x;
+  tempTemperatureArray[3] = tempSlope.y;
+  tempTemperatureArray[4] = tempCompensatedCenter.x - tempCenter.x;
+  tempTemperatureArray[5] = tempCompensatedCenter.y - tempCenter.y;
+
+  printResponseFloatArray(responseEnabled, apiEnabled, true, 0, "JT,0", true, "", outputArraySize, ',', tempTemperatureArray);
+}
+
+//***GET JOYSTICK TEMPERATURE API FUNCTION***//
+// Function   : getJoystickTemperature
+//
+// Description: This function is redefinition of main getJoystickTemperature function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getJoystickTemperature(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickTemperature(responseEnabled, apiEnabled);
+  }
+}
+
+//***RESET JOYSTICK TEMPERATURE FUNCTION***//
+// Function   : resetJoystickTemperature
+//
+// Description: This function clears the learned joystick center drift with temperature.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : void
+//*********************************//
+void resetJoystickTemperature(bool responseEnabled, bool apiEnabled) {
+  js.resetTemperatureModel();
+  printResponseInt(responseEnabled, apiEnabled, true, 0, "JT,1", true, 0);
+}
+
+//***RESET JOYSTICK TEMPERATURE API FUNCTION***//
+// Function   : resetJoystickTemperature
+//
+// Description: This function is redefinition of main resetJoystickTemperature function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void resetJoystickTemperature(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    resetJoystickTemperature(responseEnabled, apiEnabled);
+  }
+}
+
+//***GET JOYSTICK VALUE FUNCTION***//
+// Function   : getJoystickValue
+//
+// Description: This function returns raw joystick value.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : void
+//*********************************//
+void getJoystickValue(bool responseEnabled, bool apiEnabled) {
+  js.update();      // Request new values from joystick class
+  
+  const int outputArraySize = 6; 
+  float tempJoystickArray[outputArraySize];
+  
+  pointFloatType tempJoystickRaw = js.getXYRaw();                                 // Read the raw values
+  pointIntType tempJoystickIn = js.getXYIn();                                     // Read the input
+  pointIntType tempJoystickProcessed = js.getXYOut();                             // Read the filtered values  
+  
+  tempJoystickArray[0] = tempJoystickRaw.x;
+  tempJoystickArray[1] = tempJoystickRaw.y;
+  tempJoystickArray[2] = (float)tempJoystickIn.x;
+  tempJoystickArray[3] = (float)tempJoystickIn.y;
+  tempJoystickArray[4] = (float)tempJoystickProcessed.x;
+  tempJoystickArray[5] = (float)tempJoystickProcessed.y;
+  
+  printResponseFloatArray(responseEnabled, apiEnabled, true, 0, "JV,0", true, "", outputArraySize, ',', tempJoystickArray);
+  
+}
+
+//***GET JOYSTICK VALUE API FUNCTION***//
+// Function   : getJoystickValue
+//
+// Description: This function is redefinition of main getJoystickValue function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getJoystickValue(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickValue(responseEnabled, apiEnabled);
+  }
+}
+
+//***GET JOYSTICK ACCELERATION FUNCTION***//
+// Function   : getJoystickAcceleration
+//
+// Description: This function retrieves the current joystick speed level.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : void
+//*********************************//
+int getJoystickAcceleration(bool responseEnabled, bool apiEnabled) {
+  const char* commandKey = "AV";
+  int tempJoystickAccelerationLevel = CONF_JOY_ACCELERATION_LEVEL_DEFAULT;
+  if (CONF_API_ENABLED) {
+    tempJoystickAccelerationLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
+    if ((tempJoystickAccelerationLevel < CONF_JOY_ACCELERATION_LEVEL_MIN) || (tempJoystickAccelerationLevel > CONF_JOY_ACCELERATION_LEVEL_MAX)) {
+      tempJoystickAccelerationLevel = CONF_JOY_ACCELERATION_LEVEL_DEFAULT;
+      mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempJoystickAccelerationLevel);
+    }
+    
+  }
+  acceleration = tempJoystickAccelerationLevel;
+  js.setAccelerationLevel(tempJoystickAccelerationLevel);                     // Rebuild the joystick response curve
+  printResponseInt(responseEnabled, apiEnabled, true, 0, "AV,0", true, tempJoystickAccelerationLevel);
+
+  return tempJoystickAccelerationLevel;
+}
+//***GET JOYSTICK ACCELERATION IO API FUNCTION***//
+// Function   : getJoystickAcceleration
+//
+// Description: This function is redefinition of main getJoystickAcceleration function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getJoystickAcceleration(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getJoystickAcceleration(responseEnabled, apiEnabled);
+  }
+}
+
+//***SET JOYSTICK ACCELERATION FUNCTION***//
+// Function   : setJoystickAcceleration
+//
+// Description: This function sets the current joystick acceleration level.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               inputAccelerationLevel : bool : The new joystick acceleration level.
+//
+// Return     : void
+//*********************************//
+void setJoystickAcceleration(bool responseEnabled, bool apiEnabled, int inputAccelerationLevel) {
+  const char* commandKey = "AV";
+  bool isValidAcceleration = true;
+  int tempJoystickAccelerationLevel = inputAccelerationLevel;
+  
+  if ((tempJoystickAccelerationLevel >= CONF_JOY_ACCELERATION_LEVEL_MIN) && (tempJoystickAccelerationLevel <= CONF_JOY_ACCELERATION_LEVEL_MAX)) { // Check if inputAccelerationCounter is valid
+    // Valid inputAccelerationLevel
+    mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempJoystickAccelerationLevel);
+    if (!CONF_API_ENABLED) {
+      tempJoystickAccelerationLevel = CONF_JOY_ACCELERATION_LEVEL_DEFAULT;
+    }
+    acceleration = tempJoystickAccelerationLevel;
+    js.setAccelerationLevel(tempJoystickAccelerationLevel);                   // Rebuild the joystick response curve
+    isValidAcceleration = true;
+  }
+  else {
+    // Invalid inputAccelerationLevel
+    tempJoystickAccelerationLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
+    isValidAcceleration = false;
+  }
+
+
+  int responseCode = 0;
+  (isValidAcceleration) ? responseCode = 0 : responseCode = 3;
+  printResponseInt(responseEnabled, apiEnabled, isValidAcceleration, responseCode, "AV,1", true, tempJoystickAccelerationLevel);
+}
+//***SET JOYSTICK ACCELERATION API FUNCTION***//
+// Function   : setJoystickAcceleration
+//
+// Description: This function is redefinition of main setJoystickAcceleration function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void setJoystickAcceleration(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setJoystickAcceleration(responseEnabled, apiEnabled, atoi(optionalParameter));
+}
+
+
+
+//***INCREASE/ACCELERATE JOYSTICK MOVEMENT FUNCTION***//
+// Function   : increaseJoystickAcceleration
+//
+// Description: This function increases the joystick acceleration level by one.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : void
+//*********************************//
+void increaseJoystickAcceleration(bool responseEnabled, bool apiEnabled) {
+  int tempJoystickAccelerationLevel=acceleration;
+  tempJoystickAccelerationLevel++;
+  if(tempJoystickAccelerationLevel <= CONF_JOY_ACCELERATION_LEVEL_MAX) {
+    setJoystickAcceleration(responseEnabled, apiEnabled, tempJoystickAccelerationLevel);
+  } 
+  else {
+  }
+
+}
+
+//***DECREASE/DECELERATE JOYSTICK MOVEMENT FUNCTION***//
+// Function   : decreaseJoystickAcceleration
+//
+// Description: This function decreases the joystick acceleration level by one.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : void
+//*********************************//
+void decreaseJoystickAcceleration(bool responseEnabled, bool apiEnabled) {
+  int tempJoystickAccelerationLevel=acceleration;
+  tempJoystickAccelerationLevel--;
+  if(tempJoystickAccelerationLevel >= CONF_JOY_ACCELERATION_LEVEL_MIN){
+    setJoystickAcceleration(responseEnabled, apiEnabled, tempJoystickAccelerationLevel);
+  } 
+  else{
+  }
+
+}
+
+//***GET COMMUNICATION MODE FUNCTION***//
+// Function   : getCommunicationMode
+//
+// Description: This function retrieves the state of communication mode.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : communicationMode : int : The current state of communication method.
+//*********************************//
+int getCommunicationMode(bool responseEnabled, bool apiEnabled) {
+  const char* commandKey = "CM";
+  int tempComMode;
+  tempComMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
+
+  if ((tempComMode < CONF_COM_MODE_MIN) || (tempComMode > CONF_COM_MODE_MAX)) {
+    tempComMode = CONF_COM_MODE_DEFAULT;
+    mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempComMode);
+  }
+
+  printResponseInt(responseEnabled, apiEnabled, true, 0, "CM,0", true, tempComMode);
+
+  return tempComMode;
+}
+//***GET COMMUNICATION MODE API FUNCTION***//
+// Function   : getCommunicationMode
+//
+// Description: This function is redefinition of main getCommunicationMode function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getCommunicationMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getCommunicationMode(responseEnabled, apiEnabled);
+  }
+}
+
+//***SET COMMUNICATION MODE FUNCTION***//
+// Function   : setCommunicationMode
+//
+// Description: This function sets the state of communication mode.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               inputCommunicationMode : int : The new communication mode state ( 0 = None, 1 = USB , 2 = BLE )
+//
+// Return     : void
+//*********************************//
+void setCommunicationMode(bool responseEnabled, bool apiEnabled, int inputCommunicationMode) {
+  const char* commandKey = "CM";
+  
   if ((inputCommunicationMode >= CONF_COM_MODE_MIN) && (inputCommunicationMode <= CONF_COM_MODE_MAX)) {
     if ((inputCommunicationMode == CONF_COM_MODE_BLE) && (g_operatingMode == CONF_OPERATING_MODE_GAMEPAD)){
       printResponseInt(responseEnabled, apiEnabled, false, 3, "CM,1", true, inputCommunicationMode);    // Return error if user tries to change to Bluetooth mode while in Gamepad mode
@@ -1456,11 +1922,11 @@ void setCommunicationModeLed(int inputCommunicationMode) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setCommunicationMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setCommunicationMode(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setCommunicationMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setCommunicationMode(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
 
@@ -1498,7 +1964,7 @@ void toggleCommunicationMode(bool responseEnabled, bool apiEnabled) {
 // Return     : debugState : intol : The current state of sound mode.
 //*********************************//
 int getSoundMode(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "SM";
+  const char* commandKey = "SM";
   int tempSoundMode;
   tempSoundMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
 
@@ -1521,11 +1987,11 @@ int getSoundMode(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getSoundMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getSoundMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getSoundMode(responseEnabled, apiEnabled);
   }
 }
@@ -1544,7 +2010,7 @@ void getSoundMode(bool responseEnabled, bool apiEnabled, String optionalParamete
 // Return     : void
 //*********************************//
 void setSoundMode(bool responseEnabled, bool apiEnabled, int inputSoundMode) {
-  String commandKey = "SM";
+  const char* commandKey = "SM";
 
   if ((inputSoundMode >= CONF_SOUND_MODE_MIN) && (inputSoundMode <= CONF_SOUND_MODE_MAX)) {
     mem.writeInt(CONF_SETTINGS_FILE, commandKey, inputSoundMode);
@@ -1568,11 +2034,11 @@ void setSoundMode(bool responseEnabled, bool apiEnabled, int inputSoundMode) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setSoundMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setSoundMode(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setSoundMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setSoundMode(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
 //***GET LIGHT MODE STATE FUNCTION***//
@@ -1588,7 +2054,7 @@ void setSoundMode(bool responseEnabled, bool apiEnabled, String optionalParamete
 // Return     : tempLightMode : int : The current state of light mode.
 //*********************************//
 int getLightMode(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "LM";
+  const char* commandKey = "LM";
   int tempLightMode;
   tempLightMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
 
@@ -1611,11 +2077,11 @@ int getLightMode(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getLightMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getLightMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getLightMode(responseEnabled, apiEnabled);
   }
 }
@@ -1634,7 +2100,7 @@ void getLightMode(bool responseEnabled, bool apiEnabled, String optionalParamete
 // Return     : void
 //*********************************//
 void setLightMode(bool responseEnabled, bool apiEnabled, int inputLightMode) {
-  String commandKey = "LM";
+  const char* commandKey = "LM";
 
   if ((inputLightMode >= CONF_LIGHT_MODE_MIN) && (inputLightMode <= CONF_LIGHT_MODE_MAX)) {
     mem.writeInt(CONF_SETTINGS_FILE, commandKey, inputLightMode);
@@ -1658,11 +2124,11 @@ void setLightMode(bool responseEnabled, bool apiEnabled, int inputLightMode) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void setLightMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setLightMode(responseEnabled, apiEnabled, optionalParameter.toInt());
+void setLightMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setLightMode(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
 // *********************************************************************************
@@ -1680,7 +2146,7 @@ void setLightMode(bool responseEnabled, bool apiEnabled, String optionalParamete
 // Return     : tempLightLevel : int : The current light brightness level (0-10)
 //*********************************//
 int getLightBrightnessLevel(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "LL";
+  const char* commandKey = "LL";
   int tempLightLevel;
   tempLightLevel = mem.readInt(CONF_SETTINGS_FILE, commandKey);
 
@@ -1703,260 +2169,514 @@ int getLightBrightnessLevel(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void getLightBrightnessLevel(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
+void getLightBrightnessLevel(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
     getLightBrightnessLevel(responseEnabled, apiEnabled);
   }
 }
 
-//***SET LIGHT BRIGHTNESS LEVEL FUNCTION***//
-// Function   : setLightBrightnessLevel
+//***SET LIGHT BRIGHTNESS LEVEL FUNCTION***//
+// Function   : setLightBrightnessLevel
+//
+// Description: This function sets the level of the light brightness.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               inputLightLevel : int : The new light brightness level (0-10)
+//
+// Return     : void
+//*********************************//
+void setLightBrightnessLevel(bool responseEnabled, bool apiEnabled, int inputLightLevel) {
+  const char* commandKey = "LL";
+
+  if ((inputLightLevel >= CONF_LED_BRIGHTNESS_LEVEL_MIN) && (inputLightLevel <= CONF_LED_BRIGHTNESS_LEVEL_MAX)) {
+    mem.writeInt(CONF_SETTINGS_FILE, commandKey, inputLightLevel);
+    led.setLedBrightnessLevel(inputLightLevel);
+    printResponseInt(responseEnabled, apiEnabled, true, 0, "LL,1", true, inputLightLevel);
+  }
+  else {
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "LL,1", true, inputLightLevel);
+
+  }
+
+  //TODO: Add LED blink
+  setLedState(LED_ACTION_BLINK,
+            LED_CLR_RED, 
+            CONF_LED_ALL, 
+            1,                     // number of blinks
+            1000,                     // blink time
+            led.getLedBrightness());  // brightness
+  // Perform led action
+  performLedAction(ledCurrentState);
+
+}
+
+//***SET LIGHT BRIGHTNESS LEVEL API FUNCTION***//
+// Function   : setLightBrightnessLevel
+//
+// Description: This function is redefinition of main setLightBrightnessLevel function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of the input light level.
+//
+// Return     : void
+void setLightBrightnessLevel(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setLightBrightnessLevel(responseEnabled, apiEnabled, atoi(optionalParameter));
+}
+
+// *********************************************************************************
+
+//***OPEN HUB MENU FUNCTION***//
+// Function   : openHubMenu
+//
+// Description: This function opens the Hub Menu.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               inputLightMode : int : The new debug mode state ( true = ON , false = OFF )
+//
+// Return     : void
+//*********************************//
+void controlHubMenu(bool responseEnabled, bool apiEnabled, int inputMenuControl) {
+  if ((inputMenuControl >= CONF_MENU_CONTROL_MIN) && (inputMenuControl <= CONF_MENU_CONTROL_MAX)) {
+    switch(inputMenuControl) {
+      case CONF_MENU_CONTROL_OPEN: 
+        screen.activateMenu();
+        break;     
+      case CONF_MENU_CONTROL_SELECT:
+        screen.selectMenuItem();
+        break;
+      case CONF_MENU_CONTROL_NEXT:
+        screen.nextMenuItem();
+        break;     
+      case CONF_MENU_CONTROL_CLOSE:
+        screen.deactivateMenu();
+        break;      
+    } // end switch
+   
+    printResponseInt(responseEnabled, apiEnabled, true, 0, "CH,1", true, inputMenuControl);
+
+  } // end if valid inputMenuControl
+  else {
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "CH,1", true, inputMenuControl);
+
+  }
+
+}
+//***CONTROL HUB MENU API FUNCTION***//
+// Function   : controlHubMenu
+//
+// Description: This function is redefinition of main controlHubMenu function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void controlHubMenu(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  controlHubMenu(responseEnabled, apiEnabled, atoi(optionalParameter));
+}
+
+// *********************************************************************************
+
+//***GET DEBUG MODE STATE FUNCTION***//
+// Function   : getDebugMode
+//
+// Description: This function retrieves the state of debug mode.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//
+// Return     : debugState : intol : The current state of debug mode.
+//*********************************//
+int getDebugMode(bool responseEnabled, bool apiEnabled) {
+  const char* commandKey = "DM";
+  int tempDebugMode;
+  tempDebugMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
+
+  if ((tempDebugMode < CONF_DEBUG_MODE_MIN) || (tempDebugMode > CONF_DEBUG_MODE_MAX)) {
+    tempDebugMode = CONF_DEBUG_MODE_DEFAULT;
+    mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempDebugMode);
+  }
+
+  setDebugState(tempDebugMode);
+
+  printResponseInt(responseEnabled, apiEnabled, true, 0, "DM,0", true, tempDebugMode);
+
+  return tempDebugMode;
+}
+
+//***GET DEBUG MODE STATE API FUNCTION***//
+// Function   : getDebugMode
+//
+// Description: This function is redefinition of main getDebugMode function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getDebugMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getDebugMode(responseEnabled, apiEnabled);
+  }
+}
+
+//***SET DEBUG MODE STATE FUNCTION***//
+// Function   : setDebugMode
+//
+// Description: This function sets the state of debug mode.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               inputDebugStateMode : int : The new debug mode state ( true = ON , false = OFF )
+//
+// Return     : void
+//*********************************//
+void setDebugMode(bool responseEnabled, bool apiEnabled, int inputDebugMode) {
+  const char* commandKey = "DM";
+
+  if ((inputDebugMode >= CONF_DEBUG_MODE_MIN) && (inputDebugMode <= CONF_DEBUG_MODE_MAX)) {
+    mem.writeInt(CONF_SETTINGS_FILE, commandKey, inputDebugMode);
+    g_debugMode = inputDebugMode;
+    setDebugState(inputDebugMode);
+    printResponseInt(responseEnabled, apiEnabled, true, 0, "DM,1", true, inputDebugMode);
+  }
+  else {
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "DM,1", true, inputDebugMode);
+  }
+
+}
+
+//***SET DEBUG MODE STATE API FUNCTION***//
+// Function   : setDebugMode
+//
+// Description: This function is redefinition of main setDebugMode function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void setDebugMode(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  setDebugMode(responseEnabled, apiEnabled, atoi(optionalParameter));
+}
+
+//***RUN TEST FUNCTION***//
+// Function   : runTest
+//
+// Description: This function activates an internal test.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               intputTest : int : The id of test to run.
+//
+// Return     : void
+//*********************************//
+void runTest(bool responseEnabled, bool apiEnabled, int inputTest) {
+  if ((inputTest >= CONF_TEST_MODE_MIN) && (inputTest <= CONF_TEST_MODE_MAX)) { 
+    printResponseInt(responseEnabled, apiEnabled, true, 0, "RT,1", true, inputTest);
+    activateTest(inputTest); // run the test
+  }
+  else { // error message
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "RT,1", true, inputTest);
+  }
+}
+
+//***RUN TEST API FUNCTION***//
+// Function   : runTest
+//
+// Description: This function is redefinition of main runTest function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void runTest(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  runTest(responseEnabled, apiEnabled, atoi(optionalParameter));
+}
+
+//***GET TIMER STATISTICS FUNCTION***//
+// Function   : getTimerStats
 //
-// Description: This function sets the level of the light brightness.
+// Description: This function returns the run statistics of a polling timer:
+//              timer id, runs measured, min, average and max lateness (ms), missed periods,
+//              average and max callback execution time (us), average and max time the core was awake during
+//              a callback (us, 0 unless CONF_TIMER_PROFILE_CYCLES is set).
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               inputLightLevel : int : The new light brightness level (0-10)
+//               inputTimer : int : The polling timer id (CONF_TIMER_*).
 //
 // Return     : void
 //*********************************//
-void setLightBrightnessLevel(bool responseEnabled, bool apiEnabled, int inputLightLevel) {
-  String commandKey = "LL";
-
-  if ((inputLightLevel >= CONF_LED_BRIGHTNESS_LEVEL_MIN) && (inputLightLevel <= CONF_LED_BRIGHTNESS_LEVEL_MAX)) {
-    mem.writeInt(CONF_SETTINGS_FILE, commandKey, inputLightLevel);
-    led.setLedBrightnessLevel(inputLightLevel);
-    printResponseInt(responseEnabled, apiEnabled, true, 0, "LL,1", true, inputLightLevel);
+void getTimerStats(bool responseEnabled, bool apiEnabled, int inputTimer) {
+  if ((inputTimer >= 0) && (inputTimer <= CONF_TIMER_MAX)) {
+    const int outputArraySize = 10;
+    int tempStatsArray[outputArraySize];
+
+    timerStatsStruct tempStats = pollTimer.getStats(pollTimerId[inputTimer]);
+
+    tempStatsArray[0] = inputTimer;
+    tempStatsArray[1] = tempStats.numSamples;
+    tempStatsArray[2] = tempStats.latenessMin;
+    tempStatsArray[3] = tempStats.latenessAverage;
+    tempStatsArray[4] = tempStats.latenessMax;
+    tempStatsArray[5] = tempStats.missedPeriods;
+    tempStatsArray[6] = tempStats.executionTimeAverage;
+    tempStatsArray[7] = tempStats.executionTimeMax;
+    tempStatsArray[8] = tempStats.activeTimeAverage;
+    tempStatsArray[9] = tempStats.activeTimeMax;
+
+    printResponseIntArray(responseEnabled, apiEnabled, true, 0, "TS,0", true, "", outputArraySize, ',', tempStatsArray);
   }
-  else {
-    printResponseInt(responseEnabled, apiEnabled, false, 3, "LL,1", true, inputLightLevel);
-
+  else { // error message
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "TS,0", true, inputTimer);
   }
-
-  //TODO: Add LED blink
-  setLedState(LED_ACTION_BLINK,
-            LED_CLR_RED, 
-            CONF_LED_ALL, 
-            1,                     // number of blinks
-            1000,                     // blink time
-            led.getLedBrightness());  // brightness
-  // Perform led action
-  performLedAction(ledCurrentState);
-
 }
 
-//***SET LIGHT BRIGHTNESS LEVEL API FUNCTION***//
-// Function   : setLightBrightnessLevel
+//***GET TIMER STATISTICS API FUNCTION***//
+// Function   : getTimerStats
 //
-// Description: This function is redefinition of main setLightBrightnessLevel function to match the types of API function arguments.
+// Description: This function is redefinition of main getTimerStats function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of the input light level.
+//               optionalParameter : const char* : The input parameter string should contain one element with the polling timer id.
 //
 // Return     : void
-void setLightBrightnessLevel(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setLightBrightnessLevel(responseEnabled, apiEnabled, optionalParameter.toInt());
+void getTimerStats(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  getTimerStats(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
-// *********************************************************************************
-
-//***OPEN HUB MENU FUNCTION***//
-// Function   : openHubMenu
+//***GET IDLE STATISTICS FUNCTION***//
+// Function   : getIdleStats
 //
-// Description: This function opens the Hub Menu.
+// Description: This function returns how much of the time since the last request the loop task waited in idleLoop
+//              and the core was awake, then clears the statistics:
+//              elapsed time (ms), loop passes, loop task idle delay (ms), core awake time (ms).
+//              The core awake time comes from the DWT cycle counter, which stops while the core sleeps.
+//              It wraps after 2^32 cycles (67 s at 64 MHz), so it is -1 if the requests are further apart.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               inputLightMode : int : The new debug mode state ( true = ON , false = OFF )
 //
 // Return     : void
 //*********************************//
-void controlHubMenu(bool responseEnabled, bool apiEnabled, int inputMenuControl) {
-  String commandKey = "CH";
-
-  if ((inputMenuControl >= CONF_MENU_CONTROL_MIN) && (inputMenuControl <= CONF_MENU_CONTROL_MAX)) {
-    switch(inputMenuControl) {
-      case CONF_MENU_CONTROL_OPEN: 
-        screen.activateMenu();
-        break;     
-      case CONF_MENU_CONTROL_SELECT:
-        screen.selectMenuItem();
-        break;
-      case CONF_MENU_CONTROL_NEXT:
-        screen.nextMenuItem();
-        break;     
-      case CONF_MENU_CONTROL_CLOSE:
-        screen.deactivateMenu();
-        break;      
-    } // end switch
-   
-    printResponseInt(responseEnabled, apiEnabled, true, 0, "CH,1", true, inputMenuControl);
+void getIdleStats(bool responseEnabled, bool apiEnabled) {
+  const int outputArraySize = 4;
+  int tempIdleArray[outputArraySize];
 
-  } // end if valid inputMenuControl
-  else {
-    printResponseInt(responseEnabled, apiEnabled, false, 3, "CH,1", true, inputMenuControl);
+  unsigned long elapsedTime = micros() - g_idleStartTime;
+  unsigned long awakeCycles = DWT->CYCCNT - g_idleStartCycles;
+  unsigned long cyclesPerMillisecond = SystemCoreClock / 1000;
 
-  }
+  tempIdleArray[0] = elapsedTime / 1000;
+  tempIdleArray[1] = g_idleLoopCount;
+  tempIdleArray[2] = g_idleDelayTime / 1000;
+  tempIdleArray[3] = (elapsedTime / 1000 < 0xFFFFFFFFUL / cyclesPerMillisecond) ? (int)(awakeCycles / cyclesPerMillisecond) : -1;
 
+  printResponseIntArray(responseEnabled, apiEnabled, true, 0, "TI,0", true, "", outputArraySize, ',', tempIdleArray);
+  resetIdleStats();
 }
-//***CONTROL HUB MENU API FUNCTION***//
-// Function   : controlHubMenu
+
+//***GET IDLE STATISTICS API FUNCTION***//
+// Function   : getIdleStats
 //
-// Description: This function is redefinition of main controlHubMenu function to match the types of API function arguments.
+// Description: This function is redefinition of main getIdleStats function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void controlHubMenu(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  controlHubMenu(responseEnabled, apiEnabled, optionalParameter.toInt());
+void getIdleStats(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getIdleStats(responseEnabled, apiEnabled);
+  }
 }
 
-// *********************************************************************************
-
-//***GET DEBUG MODE STATE FUNCTION***//
-// Function   : getDebugMode
+//***GET TIMER PROFILE FUNCTION***//
+// Function   : getTimerProfile
 //
-// Description: This function retrieves the state of debug mode.
+// Description: This function returns the callback execution time histogram of a polling timer:
+//              timer id, followed by the number of callbacks under 64 us, under 128 us, doubling up to 16.4 ms and over.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
+//               inputTimer : int : The polling timer id (CONF_TIMER_*).
 //
-// Return     : debugState : intol : The current state of debug mode.
+// Return     : void
 //*********************************//
-int getDebugMode(bool responseEnabled, bool apiEnabled) {
-  String commandKey = "DM";
-  int tempDebugMode;
-  tempDebugMode = mem.readInt(CONF_SETTINGS_FILE, commandKey);
+void getTimerProfile(bool responseEnabled, bool apiEnabled, int inputTimer) {
+  if ((inputTimer >= 0) && (inputTimer <= CONF_TIMER_MAX)) {
+    const int outputArraySize = TIMER_HISTOGRAM_BINS + 1;
+    int tempProfileArray[outputArraySize];
+    unsigned long tempHistogram[TIMER_HISTOGRAM_BINS];
 
-  if ((tempDebugMode < CONF_DEBUG_MODE_MIN) || (tempDebugMode > CONF_DEBUG_MODE_MAX)) {
-    tempDebugMode = CONF_DEBUG_MODE_DEFAULT;
-    mem.writeInt(CONF_SETTINGS_FILE, commandKey, tempDebugMode);
-  }
+    pollTimer.getHistogram(pollTimerId[inputTimer], tempHistogram);
 
-  setDebugState(tempDebugMode);
-
-  printResponseInt(responseEnabled, apiEnabled, true, 0, "DM,0", true, tempDebugMode);
+    tempProfileArray[0] = inputTimer;
+    for (int binIndex = 0; binIndex < TIMER_HISTOGRAM_BINS; binIndex++) {
+      tempProfileArray[binIndex + 1] = tempHistogram[binIndex];
+    }
 
-  return tempDebugMode;
+    printResponseIntArray(responseEnabled, apiEnabled, true, 0, "TP,0", true, "", outputArraySize, ',', tempProfileArray);
+  }
+  else { // error message
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "TP,0", true, inputTimer);
+  }
 }
 
-//***GET DEBUG MODE STATE API FUNCTION***//
-// Function   : getDebugMode
+//***GET TIMER PROFILE API FUNCTION***//
+// Function   : getTimerProfile
 //
-// Description: This function is redefinition of main getDebugMode function to match the types of API function arguments.
+// Description: This function is redefinition of main getTimerProfile function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with the polling timer id.
 //
 // Return     : void
-void getDebugMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 0) {
-    getDebugMode(responseEnabled, apiEnabled);
-  }
+void getTimerProfile(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  getTimerProfile(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
-//***SET DEBUG MODE STATE FUNCTION***//
-// Function   : setDebugMode
+//***RESET TIMER STATISTICS FUNCTION***//
+// Function   : resetTimerStats
 //
-// Description: This function sets the state of debug mode.
+// Description: This function clears the run statistics and execution time histogram of a polling timer.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               inputDebugStateMode : int : The new debug mode state ( true = ON , false = OFF )
+//               inputTimer : int : The polling timer id (CONF_TIMER_*).
 //
 // Return     : void
 //*********************************//
-void setDebugMode(bool responseEnabled, bool apiEnabled, int inputDebugMode) {
-  String commandKey = "DM";
-
-  if ((inputDebugMode >= CONF_DEBUG_MODE_MIN) && (inputDebugMode <= CONF_DEBUG_MODE_MAX)) {
-    mem.writeInt(CONF_SETTINGS_FILE, commandKey, inputDebugMode);
-    g_debugMode = inputDebugMode;
-    setDebugState(inputDebugMode);
-    printResponseInt(responseEnabled, apiEnabled, true, 0, "DM,1", true, inputDebugMode);
+void resetTimerStats(bool responseEnabled, bool apiEnabled, int inputTimer) {
+  if ((inputTimer >= 0) && (inputTimer <= CONF_TIMER_MAX)) {
+    pollTimer.resetStats(pollTimerId[inputTimer]);
+    printResponseInt(responseEnabled, apiEnabled, true, 0, "TS,1", true, inputTimer);
   }
-  else {
-    printResponseInt(responseEnabled, apiEnabled, false, 3, "DM,1", true, inputDebugMode);
+  else { // error message
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "TS,1", true, inputTimer);
   }
-
 }
 
-//***SET DEBUG MODE STATE API FUNCTION***//
-// Function   : setDebugMode
+//***RESET TIMER STATISTICS API FUNCTION***//
+// Function   : resetTimerStats
 //
-// Description: This function is redefinition of main setDebugMode function to match the types of API function arguments.
+// Description: This function is redefinition of main resetTimerStats function to match the types of API function arguments.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with the polling timer id.
 //
 // Return     : void
-void setDebugMode(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  setDebugMode(responseEnabled, apiEnabled, optionalParameter.toInt());
+void resetTimerStats(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  resetTimerStats(responseEnabled, apiEnabled, atoi(optionalParameter));
 }
 
-//***RUN TEST FUNCTION***//
-// Function   : runTest
+//***GET SETTINGS JSON FUNCTION***//
+// Function   : getSettingsJson
 //
-// Description: This function activates an internal test.
+// Description: This function exports all stored settings as a json string.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               intputTest : int : The id of test to run.
 //
 // Return     : void
 //*********************************//
-void runTest(bool responseEnabled, bool apiEnabled, int inputTest) {
-  String commandKey = "RT";
-
-  if ((inputTest >= CONF_TEST_MODE_MIN) && (inputTest <= CONF_TEST_MODE_MAX)) { 
-    printResponseInt(responseEnabled, apiEnabled, true, 0, "RT,1", true, inputTest);
-    activateTest(inputTest); // run the test
+void getSettingsJson(bool responseEnabled, bool apiEnabled) {
+  if (responseEnabled) {
+    beginResponse(apiEnabled, true, 0, "SJ,0", true);
+    appendResponseSettings(CONF_SETTINGS_FILE);
+    sendResponse();
   }
-  else { // error message
-    printResponseInt(responseEnabled, apiEnabled, false, 3, "RT,1", true, inputTest);
+}
+//***GET SETTINGS JSON API FUNCTION***//
+// Function   : getSettingsJson
+//
+// Description: This function is redefinition of main getSettingsJson function to match the types of API function arguments.
+//
+// Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
+//                                        The serial printing is ignored if it's set to false.
+//               apiEnabled : bool : The api response is sent if it's set to true.
+//                                   Manual response is sent if it's set to false.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
+//
+// Return     : void
+void getSettingsJson(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 0) {
+    getSettingsJson(responseEnabled, apiEnabled);
   }
 }
 
-//***RUN TEST API FUNCTION***//
-// Function   : runTest
+//***SET SETTINGS JSON FUNCTION***//
+// Function   : setSettingsJson
 //
-// Description: This function is redefinition of main runTest function to match the types of API function arguments.
+// Description: This function imports settings from a json string and resets the device to apply them.
+//              Keys missing from the json string keep their current values.
 //
 // Parameters :  responseEnabled : bool : The response for serial printing is enabled if it's set to true.
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               inputSettingsJson : const char* : The settings as json key and value pairs.
 //
 // Return     : void
-void runTest(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  runTest(responseEnabled, apiEnabled, optionalParameter.toInt());
+//*********************************//
+void setSettingsJson(bool responseEnabled, bool apiEnabled, const char* inputSettingsJson) {
+  if (inputSettingsJson[0] != '{' || !mem.writeAll(CONF_SETTINGS_FILE, inputSettingsJson)) {
+    printResponseInt(responseEnabled, apiEnabled, false, 3, "SJ,1", true, 0);
+    return;
+  }
+
+  printResponseInt(responseEnabled, apiEnabled, true, 0, "SJ,1", true, 1);
+  softwareReset();  // Restart so every module picks up the imported settings
 }
 
 //***SOFT RESET FUNCTION***//
@@ -1985,11 +2705,11 @@ void softReset(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void softReset(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 1) {
+void softReset(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 1) {
     softReset(responseEnabled, apiEnabled);
   }
 }
@@ -2019,11 +2739,11 @@ void resetSettings(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void resetSettings(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 1) {
+void resetSettings(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 1) {
     resetSettings(responseEnabled, apiEnabled);
   }
 }
@@ -2056,10 +2776,13 @@ void doFactoryReset(bool responseEnabled, bool apiEnabled) {
   setDebugMode(false, false, CONF_DEBUG_MODE_DEFAULT);
   setJoystickInnerDeadzone(false, false, CONF_JOY_DEADZONE_INNER_DEFAULT);
   setJoystickOuterDeadzone(false, false, CONF_JOY_DEADZONE_OUTER_DEFAULT);
+  setJoystickFilterCutoff(false, false, CONF_JOY_FILTER_CUTOFF_DEFAULT);
+  setJoystickFilterBeta(false, false, CONF_JOY_FILTER_BETA_DEFAULT);
   setCursorSpeed(false, false, CONF_JOY_CURSOR_SPEED_LEVEL_DEFAULT);  
   setScrollLevel(false, false, CONF_SCROLL_LEVEL_DEFAULT);
   setLightBrightnessLevel(false, false, CONF_LED_BRIGHTNESS_LEVEL_DEFAULT);
   setJoystickAcceleration(false, false, CONF_JOY_ACCELERATION_LEVEL_DEFAULT);
+  setJoystickRangeMap(false, false, 0);
   printResponseInt(responseEnabled, apiEnabled, true, 0, "FR,1", true, 1);
 
   // Clear all LEDs to indicate factory reset process is finished 
@@ -2081,11 +2804,11 @@ void doFactoryReset(bool responseEnabled, bool apiEnabled) {
 //                                        The serial printing is ignored if it's set to false.
 //               apiEnabled : bool : The api response is sent if it's set to true.
 //                                   Manual response is sent if it's set to false.
-//               optionalParameter : String : The input parameter string should contain one element with value of zero.
+//               optionalParameter : const char* : The input parameter string should contain one element with value of zero.
 //
 // Return     : void
-void doFactoryReset(bool responseEnabled, bool apiEnabled, String optionalParameter) {
-  if (optionalParameter.length() == 1 && optionalParameter.toInt() == 1) {
+void doFactoryReset(bool responseEnabled, bool apiEnabled, const char* optionalParameter) {
+  if (strlen(optionalParameter) == 1 && atoi(optionalParameter) == 1) {
     doFactoryReset(responseEnabled, apiEnabled);
   }
 }
@@ -2100,37 +2823,27 @@ void doFactoryReset(bool responseEnabled, bool apiEnabled, String optionalParame
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
-//               responseParameter : String : The response parameters printed as output.
+//               responseParameter : const char* : The response parameters printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseString(bool responseEnabled, 
+bool printResponseString(bool responseEnabled, 
                          bool apiEnabled,
                          bool responseStatus,
                          int responseNumber,
-                         String responseCommand, 
+                         const char* responseCommand, 
                          bool responseParameterEnabled, 
-                         String responseParameter) {
+                         const char* responseParameter) {
   if (responseEnabled) {
-
-    if (responseStatus) {
-      (apiEnabled) ? Serial.print("SUCCESS") : Serial.print("MANUAL");
-    } else {
-      Serial.print("FAIL");
-    }
-    Serial.print(",");
-    Serial.print(responseNumber);
-    Serial.print(":");
-    Serial.print(responseCommand);
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
     if (responseParameterEnabled) {
-      Serial.print(":");
-      Serial.println(responseParameter);
-    } else {
-      Serial.println("");
+      appendResponseString(responseParameter);
     }
+    return sendResponse();
   }
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH INT PARAMETER FUNCTION***//
@@ -2143,20 +2856,27 @@ void printResponseString(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : int : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseInt(bool responseEnabled, 
+bool printResponseInt(bool responseEnabled, 
                       bool apiEnabled,
                       bool responseStatus, 
                       int responseNumber, 
-                      String responseCommand, 
+                      const char* responseCommand, 
                       bool responseParameterEnabled, 
                       int responseParameter) {
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, String(responseParameter));
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseInt(responseParameter);
+    }
+    return sendResponse();
+  }
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH INT PARAMETER FUNCTION***//
@@ -2169,36 +2889,36 @@ void printResponseInt(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : int[] : The array response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseIntArray(bool responseEnabled, 
+bool printResponseIntArray(bool responseEnabled, 
                            bool apiEnabled, 
                            bool responseStatus, 
                            int responseNumber, 
-                           String responseCommand, 
+                           const char* responseCommand, 
                            bool responseParameterEnabled, 
-                           String responsePrefix, 
+                           const char* responsePrefix, 
                            int responseParameterSize, 
                            char responseParameterDelimiter, 
                            int responseParameter[]) {
-  char tempParameterDelimiter[1];
-
-  (isValidDelimiter(responseParameterDelimiter)) ? tempParameterDelimiter[0] = {responseParameterDelimiter} : tempParameterDelimiter[0] = {'\0'};
-
-  String responseParameterString = String(responsePrefix);
-  for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
-    responseParameterString.concat(responseParameter[parameterIndex]);
-    if (parameterIndex < (responseParameterSize - 1)) {
-      responseParameterString.concat(tempParameterDelimiter[0]);
-    };
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseString(responsePrefix);
+      for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
+        if (parameterIndex > 0 && isValidDelimiter(responseParameterDelimiter)) {
+          appendResponseChar(responseParameterDelimiter);
+        }
+        appendResponseInt(responseParameter[parameterIndex]);
+      }
+    }
+    return sendResponse();
   }
-
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, responseParameterString);
-
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH POINT PARAMETER FUNCTION***//
@@ -2211,25 +2931,29 @@ void printResponseIntArray(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : pointIntType : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseIntPoint(bool responseEnabled,
+bool printResponseIntPoint(bool responseEnabled,
                            bool apiEnabled, 
                            bool responseStatus, 
                            int responseNumber, 
-                           String responseCommand, 
+                           const char* responseCommand, 
                            bool responseParameterEnabled, 
                            pointIntType responseParameter) {
-  String responseParameterString = "";
-  responseParameterString.concat(responseParameter.x);
-  responseParameterString.concat("|");
-  responseParameterString.concat(responseParameter.y);
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, responseParameterString);
-
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseInt(responseParameter.x);
+      appendResponseChar('|');
+      appendResponseInt(responseParameter.y);
+    }
+    return sendResponse();
+  }
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH INT POINT ARRAY PARAMETER FUNCTION***//
@@ -2242,37 +2966,38 @@ void printResponseIntPoint(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : pointIntType : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseIntPointArray(bool responseEnabled,
+bool printResponseIntPointArray(bool responseEnabled,
                                 bool apiEnabled, 
                                 bool responseStatus, 
                                 int responseNumber, 
-                                String responseCommand, 
+                                const char* responseCommand, 
                                 bool responseParameterEnabled, 
-                                String responsePrefix, 
+                                const char* responsePrefix, 
                                 int responseParameterSize, 
                                 char responseParameterDelimiter, 
                                 pointIntType responseParameter[]) {
-  char tempParameterDelimiter[1];
-
-  (isValidDelimiter(responseParameterDelimiter)) ? tempParameterDelimiter[0] = {responseParameterDelimiter} : tempParameterDelimiter[0] = {'\0'};
-
-  String responseParameterString = String(responsePrefix);
-  for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
-    responseParameterString.concat(responseParameter[parameterIndex].x);
-    responseParameterString.concat("|");
-    responseParameterString.concat(responseParameter[parameterIndex].y);
-    if (parameterIndex < (responseParameterSize - 1)) {
-      responseParameterString.concat(tempParameterDelimiter[0]);
-    };
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseString(responsePrefix);
+      for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
+        if (parameterIndex > 0 && isValidDelimiter(responseParameterDelimiter)) {
+          appendResponseChar(responseParameterDelimiter);
+        }
+        appendResponseInt(responseParameter[parameterIndex].x);
+        appendResponseChar('|');
+        appendResponseInt(responseParameter[parameterIndex].y);
+      }
+    }
+    return sendResponse();
   }
-
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, responseParameterString);
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH FLOAT PARAMETER FUNCTION***//
@@ -2285,20 +3010,27 @@ void printResponseIntPointArray(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : float : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseFloat(bool responseEnabled,
+bool printResponseFloat(bool responseEnabled,
                         bool apiEnabled,
                         bool responseStatus,
                         int responseNumber,
-                        String responseCommand,
+                        const char* responseCommand,
                         bool responseParameterEnabled,
                         float responseParameter) {
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, String(responseParameter));
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseFloat(responseParameter);
+    }
+    return sendResponse();
+  }
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH FLOAT ARRAY PARAMETER FUNCTION***//
@@ -2311,38 +3043,39 @@ void printResponseFloat(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
-//               responsePrefix : String : 
+//               responsePrefix : const char* : Text printed before the first response
 //               responseParameterSize : int : Number of responses in array
 //               responseParameterDelimiter : char : Delimter character to separate responses
 //               responseParameter : float[] : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseFloatArray(bool responseEnabled, 
+bool printResponseFloatArray(bool responseEnabled, 
                              bool apiEnabled,
                              bool responseStatus,
                              int responseNumber,
-                             String responseCommand,
+                             const char* responseCommand,
                              bool responseParameterEnabled,
-                             String responsePrefix,
+                             const char* responsePrefix,
                              int responseParameterSize,
                              char responseParameterDelimiter,
                              float responseParameter[]) {
-  char tempParameterDelimiter[1];
-
-  (isValidDelimiter(responseParameterDelimiter)) ? tempParameterDelimiter[0] = {responseParameterDelimiter} : tempParameterDelimiter[0] = {'\0'};
-
-  String responseParameterString = String(responsePrefix);
-  for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
-    responseParameterString.concat(responseParameter[parameterIndex]);
-    if (parameterIndex < (responseParameterSize - 1)) {
-      responseParameterString.concat(tempParameterDelimiter[0]);
-    };
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseString(responsePrefix);
+      for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
+        if (parameterIndex > 0 && isValidDelimiter(responseParameterDelimiter)) {
+          appendResponseChar(responseParameterDelimiter);
+        }
+        appendResponseFloat(responseParameter[parameterIndex]);
+      }
+    }
+    return sendResponse();
   }
-
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, responseParameterString);
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH FLOAT POINT PARAMETER FUNCTION***//
@@ -2355,25 +3088,29 @@ void printResponseFloatArray(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : pointFloatType : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseFloatPoint(bool responseEnabled, 
+bool printResponseFloatPoint(bool responseEnabled, 
                              bool apiEnabled, 
                              bool responseStatus, 
                              int responseNumber, 
-                             String responseCommand, 
+                             const char* responseCommand, 
                              bool responseParameterEnabled, 
                              pointFloatType responseParameter) {
-  String responseParameterString = "";
-  responseParameterString.concat(responseParameter.x);
-  responseParameterString.concat("|");
-  responseParameterString.concat(responseParameter.y);
-
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, responseParameterString);
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseFloat(responseParameter.x);
+      appendResponseChar('|');
+      appendResponseFloat(responseParameter.y);
+    }
+    return sendResponse();
+  }
+  return true;
 }
 
 //***SERIAL PRINT OUT COMMAND RESPONSE WITH FLOAT POINT ARRAY PARAMETER FUNCTION***//
@@ -2386,35 +3123,232 @@ void printResponseFloatPoint(bool responseEnabled,
 //                                   Print Manual response if the function wasn't called via API.
 //               responseStatus : bool : The response status (SUCCESS,FAIL)
 //               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
-//               responseCommand : String : The End-Point command which is returned as output.
+//               responseCommand : const char* : The End-Point command which is returned as output.
 //               responseParameterEnabled : bool : Print the parameter if it's set to true, and skip the parameter if it's set to false.
 //               responseParameter : pointFloatType[] : The response parameter printed as output.
 //
-// Return     : void
+// Return     : sent : bool : False if the response didn't fit the buffer and was truncated
 //***********************************************************************//
-void printResponseFloatPointArray(bool responseEnabled, 
+bool printResponseFloatPointArray(bool responseEnabled, 
                                   bool apiEnabled,
                                   bool responseStatus,
                                   int responseNumber,
-                                  String responseCommand,
+                                  const char* responseCommand,
                                   bool responseParameterEnabled,
-                                  String responsePrefix,
+                                  const char* responsePrefix,
                                   int responseParameterSize,
                                   char responseParameterDelimiter,
                                   pointFloatType responseParameter[]) {
-  char tempParameterDelimiter[1];
+  if (responseEnabled) {
+    beginResponse(apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled);
+    if (responseParameterEnabled) {
+      appendResponseString(responsePrefix);
+      for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
+        if (parameterIndex > 0 && isValidDelimiter(responseParameterDelimiter)) {
+          appendResponseChar(responseParameterDelimiter);
+        }
+        appendResponseFloat(responseParameter[parameterIndex].x);
+        appendResponseChar('|');
+        appendResponseFloat(responseParameter[parameterIndex].y);
+      }
+    }
+    return sendResponse();
+  }
+  return true;
+}
+
+char apiResponseBuffer[CONF_API_RESPONSE_BUFFER_SIZE];  // Response being formatted, sent with a single write
+int apiResponseLength = 0;
+bool apiResponseTruncated = false;                       // Characters were dropped because the response didn't fit
+
+//***BEGIN RESPONSE FUNCTION***//
+// Function   : beginResponse
+//
+// Description: Starts formatting a new response with its status, number and command.
+//
+// Parameters :  apiEnabled : bool : Indicate if the the function was called via the API if it's set to true.
+//               responseStatus : bool : The response status (SUCCESS,FAIL)
+//               responseNumber : int : 0,1,2 (Different meanings depending on the responseStatus)
+//               responseCommand : const char* : The End-Point command which is returned as output.
+//               responseParameterEnabled : bool : Add the separator for a parameter if it's set to true.
+//
+// Return     : void
+//***********************************************************************//
+void beginResponse(bool apiEnabled, bool responseStatus, int responseNumber, const char* responseCommand, bool responseParameterEnabled) {
+  apiResponseLength = 0;
+  apiResponseTruncated = false;
+  if (responseStatus) {
+    (apiEnabled) ? appendResponseString("SUCCESS") : appendResponseString("MANUAL");
+  } else {
+    appendResponseString("FAIL");
+  }
+  appendResponseChar(',');
+  appendResponseInt(responseNumber);
+  appendResponseChar(':');
+  appendResponseString(responseCommand);
+  if (responseParameterEnabled) {
+    appendResponseChar(':');
+  }
+}
+
+//***APPEND RESPONSE CHAR FUNCTION***//
+// Function   : appendResponseChar
+//
+// Description: Adds a character to the response. Characters that don't fit the buffer are dropped and
+//              the response is marked as truncated.
+//
+// Parameters :  responseChar : char : The character
+//
+// Return     : added : bool : False if the character didn't fit
+//***********************************************************************//
+bool appendResponseChar(char responseChar) {
+  if (apiResponseLength >= CONF_API_RESPONSE_BUFFER_SIZE - 2) {  // Keep room for the line ending
+    apiResponseTruncated = true;
+    return false;
+  }
+  apiResponseBuffer[apiResponseLength++] = responseChar;
+  return true;
+}
+
+//***APPEND RESPONSE STRING FUNCTION***//
+// Function   : appendResponseString
+//
+// Description: Adds a string to the response.
+//
+// Parameters :  responseString : const char* : The string
+//
+// Return     : added : bool : False if the string didn't fit
+//***********************************************************************//
+bool appendResponseString(const char* responseString) {
+  while (*responseString != '\0') {
+    if (!appendResponseChar(*responseString++)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//***APPEND RESPONSE UNSIGNED INT FUNCTION***//
+// Function   : appendResponseUnsignedInt
+//
+// Description: Adds the decimal digits of an unsigned integer to the response.
+//
+// Parameters :  responseValue : unsigned long : The integer
+//
+// Return     : added : bool : False if the digits didn't fit
+//***********************************************************************//
+bool appendResponseUnsignedInt(unsigned long responseValue) {
+  char digitBuffer[11];                           // 10 digits and terminator
+  int digitIndex = sizeof(digitBuffer) - 1;
+
+  digitBuffer[digitIndex] = '\0';
+  do {
+    digitBuffer[--digitIndex] = '0' + (responseValue % 10);
+    responseValue /= 10;
+  } while (responseValue > 0);
+  return appendResponseString(&digitBuffer[digitIndex]);
+}
+
+//***APPEND RESPONSE INT FUNCTION***//
+// Function   : appendResponseInt
+//
+// Description: Adds a decimal integer to the response.
+//
+// Parameters :  responseValue : long : The integer
+//
+// Return     : added : bool : False if the integer didn't fit
+//***********************************************************************//
+bool appendResponseInt(long responseValue) {
+  if (responseValue < 0) {
+    return appendResponseChar('-') && appendResponseUnsignedInt(0UL - (unsigned long)responseValue);
+  }
+  return appendResponseUnsignedInt((unsigned long)responseValue);
+}
+
+//***APPEND RESPONSE FLOAT FUNCTION***//
+// Function   : appendResponseFloat
+//
+// Description: Adds a float to the response with two decimal places, matching the previous String output.
+//              Like Print::print(float), NaN is written as "nan", infinity as "inf", values that don't
+//              fit an unsigned long as "ovf" and negative values that round to zero as "-0.00".
+//
+// Parameters :  responseValue : float : The float
+//
+// Return     : added : bool : False if the float didn't fit
+//***********************************************************************//
+bool appendResponseFloat(float responseValue) {
+  if (isnan(responseValue)) {
+    return appendResponseString("nan");
+  }
+  if (isinf(responseValue)) {
+    return appendResponseString("inf");
+  }
+  if (responseValue > 4294967040.0 || responseValue < -4294967040.0) {   // Largest float below 2^32
+    return appendResponseString("ovf");
+  }
+
+  float absoluteValue = fabs(responseValue);
+  unsigned long integerPart = (unsigned long)absoluteValue;
+  unsigned long hundredths = (unsigned long)((absoluteValue - integerPart) * 100.0 + 0.5);
+  if (hundredths >= 100) {                        // Rounded up to the next integer
+    integerPart++;
+    hundredths -= 100;
+  }
 
-  (isValidDelimiter(responseParameterDelimiter)) ? tempParameterDelimiter[0] = {responseParameterDelimiter} : tempParameterDelimiter[0] = {'\0'};
+  if (responseValue < 0.0 && !appendResponseChar('-')) {
+    return false;
+  }
+  return appendResponseUnsignedInt(integerPart) &&
+         appendResponseChar('.') &&
+         appendResponseChar('0' + hundredths / 10) &&
+         appendResponseChar('0' + hundredths % 10);
+}
 
-  String responseParameterString = String(responsePrefix);
-  for (int parameterIndex = 0; parameterIndex < responseParameterSize; parameterIndex++) {
-    responseParameterString.concat(responseParameter[parameterIndex].x);
-    responseParameterString.concat("|");
-    responseParameterString.concat(responseParameter[parameterIndex].y);
-    if (parameterIndex < (responseParameterSize - 1)) {
-      responseParameterString.concat(tempParameterDelimiter[0]);
-    };
+//***APPEND RESPONSE SETTINGS FUNCTION***//
+// Function   : appendResponseSettings
+//
+// Description: Exports the settings file as json straight into the response.
+//              A json string that doesn't fit the buffer is cut off and the response is marked as truncated.
+//
+// Parameters :  fileString : const char* : The name of the settings file
+//
+// Return     : added : bool : False if the json string didn't fit
+//***********************************************************************//
+bool appendResponseSettings(const char* fileString) {
+  if (apiResponseLength >= CONF_API_RESPONSE_BUFFER_SIZE - 2) {  // Keep room for the line ending
+    apiResponseTruncated = true;
+    return false;
   }
+  size_t availableLength = CONF_API_RESPONSE_BUFFER_SIZE - 2 - apiResponseLength;  // Including the terminator written by readAll
+  size_t settingsLength = mem.readAll(fileString, &apiResponseBuffer[apiResponseLength], availableLength);
+  if (settingsLength >= availableLength) {
+    apiResponseLength += availableLength - 1;
+    apiResponseTruncated = true;
+    return false;
+  }
+  apiResponseLength += settingsLength;
+  return true;
+}
 
-  printResponseString(responseEnabled, apiEnabled, responseStatus, responseNumber, responseCommand, responseParameterEnabled, responseParameterString);
+//***SEND RESPONSE FUNCTION***//
+// Function   : sendResponse
+//
+// Description: Ends the response with a line ending and writes it to the serial port in one call.
+//              A truncated response ends with "..." so the host can tell it is incomplete.
+//
+// Parameters :  void
+//
+// Return     : sent : bool : False if the response was truncated
+//***********************************************************************//
+bool sendResponse() {
+  bool responseComplete = !apiResponseTruncated;
+  if (apiResponseTruncated) {
+    memcpy(&apiResponseBuffer[apiResponseLength - 3], "...", 3);
+  }
+  apiResponseBuffer[apiResponseLength++] = '\r';
+  apiResponseBuffer[apiResponseLength++] = '\n';
+  Serial.write((const uint8_t*)apiResponseBuffer, apiResponseLength);
+  apiResponseLength = 0;
+  apiResponseTruncated = false;
+  return responseComplete;
 }
@@ -43,6 +43,8 @@ class LSBLEMouse {
     inline bool isConnected(void);
   protected:
     uint8_t _buttons;
+    uint8_t _lastReportButtons;                    // Buttons of the last report the host accepted
+    bool _lastReportIdle;                          // True if the last report the host accepted had no motion
     void buttons(uint8_t b);
   private:
     void mouseReport(signed char b, signed char x, signed char y, signed char wheel = 0, signed char pan = 0);
@@ -112,6 +114,8 @@ LSBLEMouse::LSBLEMouse(void)
 void LSBLEMouse::begin(const char* s)
 {
   _buttons = 0;
+  _lastReportButtons = 0;
+  _lastReportIdle = false;                      // Always send the first report
   if (needsInitialization) {
     initializeBluefruit(s);
     needsInitialization = false;
@@ -125,7 +129,15 @@ void LSBLEMouse::end(void)
 
 void LSBLEMouse::mouseReport(int8_t b, int8_t x, int8_t y, int8_t wheel, int8_t pan)
 {
-  blehid.mouseReport(b, x, y, wheel, pan);
+  // A report with no motion only matters if the buttons changed or the previous report moved
+  bool isIdleReport = (x == 0 && y == 0 && wheel == 0 && pan == 0);
+  if (isIdleReport && _lastReportIdle && b == _lastReportButtons) {
+    return;
+  }
+
+  // A report that is not delivered (e.g. while disconnected) is resent on the next call
+  _lastReportIdle = blehid.mouseReport(b, x, y, wheel, pan) && isIdleReport;
+  _lastReportButtons = b;
 }
 
 void LSBLEMouse::move(int8_t x, int8_t y)
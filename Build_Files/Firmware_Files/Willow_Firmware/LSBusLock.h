@@ -0,0 +1,97 @@
+/*
+* File: LSBusLock.h
+* Firmware: Willow
+* Developed by: MakersMakingChange
+* Version: v1.0rc (April 4 2025)
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Header definition
+#ifndef _LSBUSLOCK_H
+#define _LSBUSLOCK_H
+
+#include <Arduino.h>
+
+// Mutex guarding a bus shared between FreeRTOS tasks (the display and the joystick sensor share the I2C bus).
+// lock() and unlock() do nothing until begin() has been called, so single task code at startup is unaffected.
+class LSBusLock {
+  public:
+    LSBusLock();
+    void begin();                         // Create the mutex
+    void lock();                          // Wait for and take the bus
+    void unlock();                        // Give the bus back
+  private:
+    SemaphoreHandle_t _mutex;
+};
+
+//*********************************//
+// Function   : LSBusLock
+//
+// Description: Construct LSBusLock
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+LSBusLock::LSBusLock() {
+  _mutex = NULL;
+}
+
+//*********************************//
+// Function   : begin
+//
+// Description: Create the mutex. Must be called from setup() before a second task uses the bus.
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSBusLock::begin() {
+  if (_mutex == NULL) {
+    _mutex = xSemaphoreCreateMutex();      // Mutex (not binary semaphore) so the holder inherits the priority of a waiting task
+  }
+}
+
+//*********************************//
+// Function   : lock
+//
+// Description: Wait until the bus is free and take it
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSBusLock::lock() {
+  if (_mutex != NULL) {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+}
+
+//*********************************//
+// Function   : unlock
+//
+// Description: Release the bus
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSBusLock::unlock() {
+  if (_mutex != NULL) {
+    xSemaphoreGive(_mutex);
+  }
+}
+
+extern LSBusLock g_i2cBusLock;            // Defined in Willow_Firmware.ino
+
+#endif
@@ -111,11 +111,19 @@
 #define NOTE_D8  4699
 #define NOTE_DS8 4978
 
+// Note of a sound that plays after its first note
+typedef struct {
+  unsigned int frequency;   // Hz
+  unsigned long duration;   // ms
+} buzzerNoteStruct;
+
 class LSBuzzer {
   public: 
     LSBuzzer();
     void begin();
     void update();
+    unsigned long nextDeadline();
+    void finish();
     void clear();
     void playStartupSound();
     void playReadySound();
@@ -128,6 +136,10 @@ class LSBuzzer {
     void calibCenterTone();
 
   private:
+    static void playNote(buzzerNoteStruct* note);
+    void playNoteLater(unsigned long noteDelay, unsigned int frequency, unsigned long duration);
+
+    LSTimer<CONF_BUZZER_TIMER_SIZE, buzzerNoteStruct> _buzzerTimer;  // Later notes of the sounds being played
     boolean _buzzerOn = true; // Sound feedback is on by default
     int _soundModeLevel; // Levels that correspond to volume
 };
@@ -162,14 +174,74 @@ void LSBuzzer::begin(){
 //*********************************//
 // Function   : update
 // 
-// Description: Updates buzzer (currently not implemented)
+// Description: Plays the notes of the current sounds that are due. Sounds don't wait for their later notes,
+//              so this must be called inside loop().
 // 
 // Arguments :  void
 // 
 // Return     : void
 //*********************************//
 void LSBuzzer::update(){
-  
+  _buzzerTimer.run();
+}
+
+//*********************************//
+// Function   : nextDeadline
+// 
+// Description: Time until the next note of the current sounds is due
+// 
+// Arguments :  void
+// 
+// Return     : unsigned long : Time until the next note (ms), NO_DEADLINE if no notes are waiting
+//*********************************//
+unsigned long LSBuzzer::nextDeadline(){
+  return _buzzerTimer.nextDeadline();
+}
+
+//*********************************//
+// Function   : finish
+// 
+// Description: Wait until every note of the current sounds has started. Only for callers that stop running loop(),
+//              like a restart.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSBuzzer::finish(){
+  while (_buzzerTimer.getNumTimers() > 0) {
+    delay(_buzzerTimer.nextDeadline());
+    _buzzerTimer.run();
+  }
+}
+
+//*********************************//
+// Function   : playNote
+// 
+// Description: Timer callback that plays a later note of a sound
+// 
+// Arguments :  note : buzzerNoteStruct* : Note stored in the timer
+// 
+// Return     : void
+//*********************************//
+void LSBuzzer::playNote(buzzerNoteStruct* note){
+  tone(CONF_BUZZER_PIN, note->frequency, note->duration);
+}
+
+//*********************************//
+// Function   : playNoteLater
+// 
+// Description: Schedule a later note of a sound
+// 
+// Arguments :  noteDelay : unsigned long : Time from now until the note starts (ms)
+//              frequency : unsigned int : Note frequency (Hz)
+//              duration : unsigned long : Note length (ms)
+// 
+// Return     : void
+//*********************************//
+void LSBuzzer::playNoteLater(unsigned long noteDelay, unsigned int frequency, unsigned long duration){
+  buzzerNoteStruct note = {frequency, duration};
+  _buzzerTimer.setTimeout(noteDelay, playNote, note);
 }
 
 //*********************************//
@@ -251,8 +323,7 @@ void LSBuzzer::playStartupSound(){
 void LSBuzzer::playReadySound(){ 
   if (_buzzerOn && (_soundModeLevel != CONF_SOUND_MODE_OFF)){
     tone(CONF_BUZZER_PIN, NOTE_F5, 500);
-    delay(500);  // TODO: add timer instead of delay
-    tone(CONF_BUZZER_PIN, NOTE_C6, 250);
+    playNoteLater(500, NOTE_C6, 250);
   }
 }
 
@@ -267,8 +338,7 @@ void LSBuzzer::playReadySound(){
 //*********************************//
 void LSBuzzer::playErrorSound(){
     tone(CONF_BUZZER_PIN, NOTE_G4, 500);
-    delay(500);
-    tone(CONF_BUZZER_PIN, NOTE_C4, 500);       
+    playNoteLater(500, NOTE_C4, 500);
 }
 
 //*********************************//
@@ -283,11 +353,8 @@ void LSBuzzer::playErrorSound(){
 void LSBuzzer::playShutdownSound(){
   if (_buzzerOn && (_soundModeLevel != CONF_SOUND_MODE_OFF)) {
     tone(CONF_BUZZER_PIN, NOTE_C6, 500);
-    delay(250);
-    tone(CONF_BUZZER_PIN, NOTE_G5, 500);       
-    delay(250);
-    tone(CONF_BUZZER_PIN, NOTE_C5, 300);
-    delay(500);  
+    playNoteLater(250, NOTE_G5, 500);
+    playNoteLater(500, NOTE_C5, 300);
   } 
 }
 
@@ -24,6 +24,8 @@
 #define SHOW_CONNECTION_TIME 0 // Set to 0 for production
 
 #define CONF_ENABLE_WATCHDOG 1 // Set to 1 to enable hardware watchdog
+#define CONF_ENABLE_IDLE 1 // Set to 1 to sleep between timer deadlines instead of spinning in loop()
+#define CONF_TIMER_PROFILE_CYCLES 0 // Set to 1 to also count the time the core is awake during timer callbacks with the DWT cycle counter
 
 //***DO NOT CHANGE***//
 #define CONF_WILLOW_MODEL 1                // 1: Willow w/ Hub
@@ -156,8 +158,9 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 
 
 // Flash Memory settings - Don't change  
-#define CONF_SETTINGS_FILE    "/settings.txt"
-#define CONF_SETTINGS_JSON    "{\"MN\":0,\"VN1\":4,\"VN2\":1,\"VN3\":0,\"ID\":0,\"OM\":1,\"CM\":1,\"SS\":5,\"SL\":5,\"PM\":2,\"ST\":3.0,\"PT\":3.0,\"AV\":0,\"IZ\":0.05,\"OZ\":0.95,\"CA0\":[0.0,0.0],\"CA1\":[-13.0,13.0],\"CA2\":[13.0,13.0],\"CA3\":[13.0,-13.0],\"CA4\":[-13.0,-13.0],\"SM\":1,\"LM\":1,\"LL\":5,\"DM\":0}"
+#define CONF_SETTINGS_FILE    "/settings.dat"        // Binary settings record
+#define CONF_SETTINGS_JSON_FILE "/settings.txt"      // Legacy json settings file, migrated to the settings record on first boot
+#define CONF_SETTINGS_JSON    "{\"MN\":0,\"VN1\":4,\"VN2\":1,\"VN3\":0,\"ID\":0,\"OM\":1,\"CM\":1,\"SS\":5,\"SL\":5,\"PM\":2,\"ST\":3.0,\"PT\":3.0,\"AV\":0,\"IZ\":0.05,\"OZ\":0.95,\"CA0\":[0.0,0.0],\"CA1\":[-13.0,13.0],\"CA2\":[13.0,13.0],\"CA3\":[13.0,-13.0],\"CA4\":[-13.0,-13.0],\"SM\":1,\"LM\":1,\"LL\":5,\"DM\":0,\"FC\":1.0,\"FB\":0.1,\"CR\":\"\"}"
 
 // Polling rates for each module
 #define CONF_JOYSTICK_POLL_RATE 20          // 20 ms 
@@ -168,6 +171,8 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_SCREEN_POLL_RATE 20            // 20 ms
 #define CONF_USB_POLL_RATE 1000             // Check USB connection every 1 second
 #define CONF_WATCHDOG_POLL_RATE 5000        // Reset watchdog timer every 5 seconds
+#define CONF_MEMORY_POLL_RATE 500           // Check for unsaved settings every 500 ms
+#define CONF_IDLE_MAX_TIME 10               // 10 ms - longest sleep between loops, bounds the delay before serial input is read
 
 #define CONF_BUTTON_PRESS_DELAY 150         // 150 ms - Duration of single button press in gamepad mode
 
@@ -193,6 +198,7 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 
 #define CONF_USB_HID_TIMEOUT  5000           // 5 seconds - timeout for connecting to USB and continuing with the program
 #define CONF_USB_HID_INIT_DELAY 2000         // initial delay before attempting to reconnect to usb again
+#define CONF_HID_KEEP_ALIVE_PERIOD 1000      // 1 second - an unchanged gamepad report is resent at most this often
 
 // Polling Timer IDs for each module
 #define CONF_TIMER_JOYSTICK 0
@@ -203,12 +209,25 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_TIMER_SCREEN 5
 #define CONF_TIMER_USB 6
 #define CONF_TIMER_WATCHDOG 7
+#define CONF_TIMER_MEMORY 8
+#define CONF_TIMER_MAX 8
+
+// Timer capacities ( number of timers each timer instance can hold at the same time )
+#define CONF_POLL_TIMER_SIZE (CONF_TIMER_MAX + 1)   // One per polling timer ID
+#define CONF_LED_TIMER_SIZE 8                        // LED effects, blinks can overlap when actions follow each other quickly
+#define CONF_ACTION_TIMER_SIZE 4                     // Gamepad button releases
+#define CONF_CALIBRATION_TIMER_SIZE 3                // Calibration state timer, plus one while a finished reading timer starts the next state
+#define CONF_USB_TIMER_SIZE 2                        // USB connection check, plus one for a check that restarts itself
+#define CONF_SCREEN_TIMER_SIZE 4                     // Screen page timeouts
+#define CONF_INPUT_TIMER_SIZE 1                      // Input state stopwatch
+#define CONF_BUZZER_TIMER_SIZE 4                     // Later notes of a sound, sounds can overlap
 
 #define CONF_TIMER_LED_STARTUP 0
 #define CONF_TIMER_LED_IBM 1
 #define CONF_TIMER_LED_BLINK 2
 #define CONF_TIMER_LED_BT 3
 #define CONF_TIMER_LED_ERROR 4
+#define CONF_TIMER_LED_MAX 4
 
 
 // Joystick values 
@@ -241,7 +260,15 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_TEST_MODE_LED 1
 #define CONF_TEST_MODE_BUZZER 2
 #define CONF_TEST_MODE_WATCHDOG 3
-#define CONF_TEST_MODE_MAX 3
+#define CONF_TEST_MODE_JOYSTICK_BENCHMARK 4
+#define CONF_TEST_MODE_MAX 4
+
+// Joystick replay benchmark
+#define CONF_TEST_BENCHMARK_SAMPLE_NUMBER 400     // Number of samples in the replay trace
+#define CONF_TEST_BENCHMARK_RUN_NUMBER 10         // Number of times the replay trace is processed
+#define CONF_TEST_BENCHMARK_CENTER_X 0.5          // Fixed calibration used while replaying so checksums are comparable between builds (mT)
+#define CONF_TEST_BENCHMARK_CENTER_Y -0.5
+#define CONF_TEST_BENCHMARK_CORNER 14.0
 
 
 // Sound Modes                                                                                              
@@ -273,6 +300,9 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 //***CAN BE CHANGED***//
 // API
 #define CONF_API_ENABLED true               // Enable or Disable API
+#define CONF_API_INPUT_BUFFER_SIZE 768     // Longest API command in characters, including the settings json import
+#define CONF_API_INPUT_TIMEOUT 50           // 50 ms - a pause this long also ends a command sent without a line ending
+#define CONF_API_RESPONSE_BUFFER_SIZE 768  // Longest API response in characters, including the settings json export
 
 // Startup Default settings
 #define CONF_STARTUP_LED_STEP_TIME 500      // Time for each color
@@ -283,6 +313,14 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_JOY_DEADZONE_OUTER_DEFAULT 0.95
 #define CONF_JOY_DEADZONE_MAX 1.0
 
+// Joystick smoothing filter settings ( Cutoff frequency at rest and its increase with joystick speed )
+#define CONF_JOY_FILTER_CUTOFF_MIN 0.0        // 0 Hz turns the filter off
+#define CONF_JOY_FILTER_CUTOFF_DEFAULT 1.0    // Hz
+#define CONF_JOY_FILTER_CUTOFF_MAX 30.0
+#define CONF_JOY_FILTER_BETA_MIN 0.0
+#define CONF_JOY_FILTER_BETA_DEFAULT 0.1      // Hz per mT/s
+#define CONF_JOY_FILTER_BETA_MAX 10.0
+
 // Joystick full calibration points and related LED feedback settings
 #define CONF_JOY_CALIB_CORNER_DEFAULT 13.0
 #define CONF_JOY_CALIB_START_DELAY 1000              // Number of milliseconds to delay full joystick calibration once triggered
@@ -297,8 +335,28 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_JOY_CALIB_READING_NUMBER 10             // Number of readings to measure (and then average) for each calibration point  
 
 #define CONF_JOY_CALIB_ERROR 10  // flag to display message stating there was an error with one or more corner calibrations
+#define CONF_JOY_CALIB_ERROR_DELAY 3000  // Number of milliseconds the error message is shown before the next corner
 #define CONF_JOY_CALIB_CORNER_MIN 3  // Minimum value for a corner coordinate when completing full calibration. Less than this will be set to default.
 
+// Joystick range sweep calibration ( The user circles the joystick along the edge of its range ) and related LED feedback settings
+#define CONF_JOY_SWEEP_START_DELAY 1000        // Number of milliseconds to delay the range sweep once triggered
+#define CONF_JOY_SWEEP_DURATION 10000          // Number of milliseconds the range sweep records every joystick sample
+#define CONF_JOY_SWEEP_LED_NUMBER CONF_LED_ALL
+#define CONF_JOY_SWEEP_LED_COLOR LED_CLR_ORANGE  // LED color while the range sweep is recorded
+
+// Joystick calibration state machine ( setCalibrationState ) shared by center initialization, full calibration and range sweep
+#define CONF_CALIB_STATE_IDLE 0            // No calibration running
+#define CONF_CALIB_STATE_START 1           // Waiting for the first state of a process
+#define CONF_CALIB_STATE_CENTER_READING 2  // Center readings with the joystick released
+#define CONF_CALIB_STATE_CENTER_DONE 3     // Center point evaluated
+#define CONF_CALIB_STATE_FULL_START 4      // Full calibration announced
+#define CONF_CALIB_STATE_CORNER_READING 5  // Corner readings with the joystick held in the corner
+#define CONF_CALIB_STATE_CORNER_DONE 6     // Corner stored, pause before the next one
+#define CONF_CALIB_STATE_CENTER_RELEASE 7  // Full calibration asks to release the joystick
+#define CONF_CALIB_STATE_FULL_DONE 8       // Full calibration complete
+#define CONF_CALIB_STATE_SWEEP_READING 9   // Range sweep readings with the joystick circled along its edge
+#define CONF_CALIB_STATE_SWEEP_DONE 10     // Range map built and stored
+
 // Joystick center initialization and related LED feedback settings 
 #define CONF_JOY_INIT_START_DELAY 1000  // Number of milliseconds to delay joystick neutral calibration once triggered
 #define CONF_JOY_INIT_LED_NUMBER CONF_LED_ALL
@@ -324,6 +382,13 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_JOY_OUTPUT_XY_MAX  1024
 #define CONF_JOY_OUTPUT_XY_MAX_GAMEPAD  127
 
+#define CONF_JOY_FIXED_POINT_MATH 0  // Set to 1 to process joystick readings with integer (fixed-point) math instead of float math
+#define CONF_JOY_SAMPLE_RATE 200     // Joystick sensor sample rate in Hz driven by a hardware timer (10 to 1000). Set to 0 to read the sensor from joystickLoop
+#define CONF_JOY_SENSOR_ASYNC 1      // Set to 1 to read the joystick sensor with EasyDMA while the reading task sleeps, 0 to use the Tlv493d library
+#define CONF_JOY_SENSOR_I2C_CLOCK 400000  // Joystick sensor read bus clock in Hz (100000, 250000 or 400000)
+#define CONF_JOY_TEMP_COMPENSATION 1 // Set to 1 to correct the center point for sensor temperature drift learned while the joystick is idle
+#define CONF_JOY_AUTO_CENTER 1       // Set to 1 to slowly move the center point to the resting reading while the joystick is idle
+
 // Scroll level change and related LED feedback settings 
 #define CONF_SCROLL_CHANGE_LED_DELAY  150
 #define CONF_SCROLL_CHANGE_LED_BLINK  1
@@ -377,18 +442,30 @@ const String willowVersionStr = String(CONF_WILLOW_VERSION_MAJOR) + "." + String
 #define CONF_ERROR_LED_BRIGHTNESS 255      // Full brightness
 
 // Acceleration
-// Cursor acceleration structure
+// Cursor acceleration structure ( One entry per acceleration level from CONF_JOY_ACCELERATION_LEVEL_MIN to CONF_JOY_ACCELERATION_LEVEL_MAX )
+// accNumber, accCoefficient (response curve exponent = 2^(level/10)), accStartSpeed, accEndSpeed
 const accStruct accProperty[]{
-  { 0, 1.0, 0, 0 },
-  { 1, 1.0, 0, 0 },
-  { 2, 1.0, 0, 0 },
-  { 3, 1.0, 0, 0 },
-  { 4, 1.0, 0, 0 },
-  { 5, 1.0, 0, 0 },
-  { 6, 1.0, 0, 0 },
-  { 7, 1.0, 0, 0 },
-  { 8, 1.0, 0, 0 },
-  { 9, 1.0, 0, 0 }
+  { 0, 0.500, 0, 0 },   // Level -10
+  { 1, 0.536, 0, 0 },
+  { 2, 0.574, 0, 0 },
+  { 3, 0.616, 0, 0 },
+  { 4, 0.660, 0, 0 },
+  { 5, 0.707, 0, 0 },
+  { 6, 0.758, 0, 0 },
+  { 7, 0.812, 0, 0 },
+  { 8, 0.871, 0, 0 },
+  { 9, 0.933, 0, 0 },
+  { 10, 1.000, 0, 0 },  // Level 0 (linear)
+  { 11, 1.072, 0, 0 },
+  { 12, 1.149, 0, 0 },
+  { 13, 1.231, 0, 0 },
+  { 14, 1.320, 0, 0 },
+  { 15, 1.414, 0, 0 },
+  { 16, 1.516, 0, 0 },
+  { 17, 1.625, 0, 0 },
+  { 18, 1.741, 0, 0 },
+  { 19, 1.866, 0, 0 },
+  { 20, 2.000, 0, 0 }   // Level 10
 };
 
 /* WILLOW INPUT AND OUTPUT MAPPING */
@@ -47,7 +47,7 @@ class LSInput {
     int inputAllState;
     inputStateStruct inputCurrState = {0, 0, 0};
     inputStateStruct inputPrevState = {0, 0, 0};
-    LSTimer <void> inputStateTimer;
+    LSTimer<CONF_INPUT_TIMER_SIZE> inputStateTimer;
     int inputStateTimerId;
 
 };
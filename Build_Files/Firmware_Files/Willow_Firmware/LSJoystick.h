@@ -24,6 +24,9 @@
 #include <Arduino.h>
 #include "LSCircularBuffer.h"           // LSCircularBuffer
 #include "LSUtils.h"                    // pointIntType
+#include "LSSampleQueue.h"              // LSSampleQueue
+#include "LSBusLock.h"                  // g_i2cBusLock
+#include "LSTwimReader.h"               // LSTwimReader
 
 #define JOY_RAW_BUFF_SIZE 10            // The size of _joystickRawBuffer
 #define JOY_INPUT_BUFF_SIZE 5           // The size of _joystickInputBuffer
@@ -31,6 +34,11 @@
 #define JOY_CENTER_BUFF_SIZE 5          // The size of _joystickCenterBuffer
 
 #define JOY_CALIBR_ARRAY_SIZE 5         // The _magnetInputCalibration array size
+#define JOY_SECTOR_NUMBER 4             // Calibration sectors, one between each pair of neighbouring corners
+#define JOY_RANGE_MAP_SIZE 64           // Angle bins of the range map ( JOY_RANGE_MAP_SIZE / 4 per quadrant )
+#define JOY_RANGE_MAP_UNIT 0.25         // Range map radius resolution in mT per count
+#define JOY_RANGE_MAP_COVERAGE_MIN 48   // Bins a range sweep must reach to replace the range map
+#define JOY_RANGE_MAP_RADIUS_MIN 3.0    // Sweep readings closer to the center are not at the edge of the range (mT)
 #define JOY_MAG_SAMPLE_SIZE 5           // The sample size used for averaging magnet samples 
 
 // Joystick magnetic directions
@@ -59,6 +67,100 @@
 
 #define JOY_OUTPUT_XY_MAX_GAMEPAD  127
 
+#define JOY_RESPONSE_TABLE_SIZE (JOY_INPUT_XY_MAX + 1)  // The size of _responseTable (one entry per input magnitude count)
+
+#define JOY_ACCELERATION_LEVEL_DEFAULT 0 // The default acceleration level (linear response)
+
+#define JOY_FILTER_DERIVATIVE_CUTOFF 1.0 // Cutoff frequency in Hz of the speed estimate used by the smoothing filter
+#define JOY_FILTER_RESET_TIME 100000    // Restart the smoothing filter if samples are further apart than this (us)
+
+#define JOY_FIXED_POINT_SHIFT 16        // Number of fractional bits of the fixed-point (Q16) output magnitudes in _responseTable
+#define JOY_FIXED_POINT_ONE (1L << JOY_FIXED_POINT_SHIFT)  // 1.0 in fixed-point (Q16)
+#define JOY_FIXED_VALUE_MAX 32767       // Largest fixed-point factor, so a sum of two products of factors fits in 32 bits
+#define JOY_FIXED_INPUT_SHIFT 12        // Fractional bits of centered readings in the fixed-point math (Q12 mT, fewer for readings over 8 mT)
+#define JOY_FIXED_INPUT_LIMIT (1L << 20) // Largest centered reading in Q12 (256 mT, beyond the sensor range)
+#define JOY_FIXED_SECTOR_SHIFT 4        // Fractional bits of the sector corners (Q4 mT), so the sector cross products fit in 32 bits
+#define JOY_FIXED_MAPPED_SHIFT 4        // Fractional bits of mapped points (Q4 output counts)
+#define JOY_FIXED_POSITION_SHIFT 8      // Fractional bits of the range map bin position (Q8)
+#define JOY_FIXED_MAGNITUDE_SHIFT 5     // Fractional bits of the input magnitude in processOutputResponseFixed (Q5)
+#define JOY_FIXED_RESPONSE_SHIFT 10     // Fractional bits of the output magnitude in processOutputResponseFixed (Q10)
+
+#define JOY_SAMPLE_QUEUE_SIZE 32        // The size of _sampleQueue (power of two)
+#define JOY_SAMPLE_RATE_MIN 10          // The minimum sensor sample rate in Hz
+#define JOY_SAMPLE_RATE_MAX 1000        // The maximum sensor sample rate in Hz
+#define JOY_SAMPLE_TASK_STACK_SIZE 256  // Stack size of the sampling task in words
+#define JOY_SAMPLE_TASK_PRIORITY TASK_PRIO_HIGH  // Above loop() so sample timing doesn't depend on the loop
+#define JOY_SAMPLE_TIMER NRF_TIMER4     // Hardware timer that paces sampling (its interrupt handler is TIMER4_IRQHandler below)
+#define JOY_SAMPLE_TIMER_IRQN TIMER4_IRQn
+#define JOY_SAMPLE_TIMER_IRQ_PRIORITY 3 // Lowest priority allowed to call FreeRTOS FromISR functions with the SoftDevice running
+#define JOY_SAMPLE_TIMER_FREQUENCY 1000000 // Timer tick rate in Hz (16 MHz / 2^JOY_SAMPLE_TIMER_PRESCALER)
+#define JOY_SAMPLE_TIMER_PRESCALER 4
+
+#define JOY_SENSOR_READ_XY_LENGTH 5     // Registers 0 to 4 hold the 12 bit x and y readings
+#define JOY_SENSOR_READ_FULL_LENGTH 7   // Registers 0 to 6 add the z low bits and temperature
+#define JOY_SENSOR_READ_TIMEOUT 5       // The longest wait for a sensor read in ms
+#define JOY_SENSOR_MT_PER_LSB 0.098     // Sensor resolution in mT per count
+#define JOY_SENSOR_FIELD_MAX 100.0      // Readings beyond this are implausible for the joystick magnet (mT, sensor range is 130 mT)
+#define JOY_SENSOR_FAULT_LIMIT 20       // Faulty frames in a row before the sensor is recovered
+#define JOY_SENSOR_FRAME_COUNT_NONE 0xFF // No frame counter read yet
+#define JOY_SENSOR_CONVERSION_PERIOD 10000 // Longest time between conversions in master controlled mode (us)
+#define JOY_SENSOR_FROZEN_PERIODS 3     // Conversion periods without a new frame before the sensor counts as frozen
+#define JOY_SENSOR_RECOVERY_BACKOFF 100 // Wait before the second recovery attempt (ms), doubled for each further attempt
+#define JOY_SENSOR_RECOVERY_ATTEMPT_MAX 8 // Recovery attempts without a good frame before the sensor is given up on
+
+#define JOY_SENSOR_TEMP_OFFSET 340       // Temperature reading at JOY_SENSOR_TEMP_REFERENCE (LSB)
+#define JOY_SENSOR_TEMP_PER_LSB 1.1      // Temperature resolution in C per count
+#define JOY_SENSOR_TEMP_REFERENCE 25.0   // C
+
+#define JOY_TEMP_READ_PERIOD 1000000     // Time between temperature readings (us)
+#define JOY_TEMP_SMOOTHING 0.1           // Weight of a new temperature reading in the smoothed temperature
+#define JOY_TEMP_IDLE_TIME 2000000       // Time still before a resting reading is used to learn the drift (us)
+#define JOY_TEMP_DELTA_MIN 2.0           // Smallest temperature change from the center reset used to learn the drift (C)
+#define JOY_TEMP_MODEL_DECAY 0.995       // Weight kept by older drift readings for each new one
+#define JOY_TEMP_PRIOR_WEIGHT 4.0        // Weight (C^2) the learned drift keeps after a center reset
+#define JOY_TEMP_SLOPE_MAX 0.2           // Largest center drift accepted (mT per C)
+#define JOY_TEMP_SLOPE_STEP_MAX 0.01     // Largest change of the learned drift per temperature reading (mT per C)
+
+#define JOY_STILL_TIME_CONSTANT 100000   // Time constant of the resting mean and variance (us)
+#define JOY_STILL_VARIANCE_MAX 0.05      // Largest variance of x plus y at rest, higher means the joystick is touched (mT^2)
+
+#define JOY_AUTO_CENTER_IDLE_TIME 2000000  // Time still before resting readings are collected (us)
+#define JOY_AUTO_CENTER_WINDOW_TIME 1000000  // Resting time averaged for one center correction, at any sample rate (us)
+#define JOY_AUTO_CENTER_GAIN 0.1           // Part of the measured center error corrected per window
+#define JOY_AUTO_CENTER_SHIFT_MAX 4.0      // Largest total correction since the center was measured (mT)
+
+// Sensor frame status
+#define JOY_SENSOR_STATUS_OK 0
+#define JOY_SENSOR_STATUS_BUS_ERROR 1   // Read failed or timed out
+#define JOY_SENSOR_STATUS_FROZEN 2      // Frame counter did not change, no new conversion (ADC hang)
+#define JOY_SENSOR_STATUS_IMPLAUSIBLE 3 // Reading outside of JOY_SENSOR_FIELD_MAX
+#define JOY_SENSOR_STATUS_REPEATED 4    // Frame counter did not change within JOY_SENSOR_FROZEN_PERIODS, read faster than the conversions
+
+#define JOY_SPIKE_WINDOW_SIZE 5         // Number of previous raw readings the spike filter compares with
+#define JOY_SPIKE_THRESHOLD 3.0         // A reading further than this many deviations from the median is a spike
+#define JOY_SPIKE_MAD_SCALE 1.4826      // Converts the median absolute deviation to a standard deviation
+#define JOY_SPIKE_DEVIATION_MIN 1.0     // Lower limit of the deviation so sensor noise at rest is never a spike (mT)
+
+static_assert(JOY_RANGE_MAP_SIZE == sizeof(settingsStruct::rangeMap), "The range map is stored in settingsStruct::rangeMap");
+static_assert(JOY_RANGE_MAP_SIZE % 4 == 0, "Range map bins are spread evenly over the four quadrants");
+static_assert(JOY_SPIKE_WINDOW_SIZE <= JOY_RAW_BUFF_SIZE, "The spike filter window is taken from _joystickRawBuffer");
+
+// Joystick sensor fault counters
+typedef struct {
+  unsigned long spikeCount;             // Readings replaced by the spike filter and not confirmed by the next reading
+  unsigned long frozenCount;            // Frames without a new conversion for JOY_SENSOR_FROZEN_PERIODS
+  unsigned long implausibleCount;       // Frames outside of JOY_SENSOR_FIELD_MAX
+  unsigned long busErrorCount;          // Failed or timed out reads
+  unsigned long sensorResetCount;       // Bus recoveries and sensor re-initializations after JOY_SENSOR_FAULT_LIMIT faulty frames in a row
+  unsigned long sampleDropCount;        // Samples lost by the sampling task
+} joystickFaultStruct;
+
+// Sensor sample taken by the sampling task
+typedef struct {
+  pointFloatType point;                 // Raw x and y in mT (mapped to joystick directions)
+  unsigned long sampleTime;             // micros() when the reading completed
+} joystickSampleStruct;
+
 extern int g_operatingMode; 
 
 
@@ -76,38 +178,158 @@ class LSJoystick {
     void setMagnetDirection(int magnetXDirection, int magnetYDirection);  // Set magnet direction based on orientation of magnet (z axis), X and Y direction variables.
     void setInnerDeadzone(bool deadzoneEnabled,float deadzoneFactor);     // Enable or disable deadzone and set deadzone scale factor (0-100), default 0.12
     float getInnerDeadzoneFactor(void);                                   // Get the inner deadzone factor ()
+    float getOuterDeadzoneFactor(void);                                   // Get the outer deadzone factor ()
     void setOuterDeadzone(bool upperDeadzoneEnabled,float outerDeadzoneFactor);  // Enable or disable deadzone and set deadzone scale factor  Default 0.95 
     int getOutputRange();                                                 // Get the output range or speed levels.
     void setOutputRange(int rangeLevel);                                  // Set the output range or speed levels.
     int getMouseSpeedRange();                                             // Get the maximum cursor change
+    int getAccelerationLevel();                                           // Get the acceleration level or response curve.
+    void setAccelerationLevel(int accelerationLevel);                     // Set the acceleration level or response curve.
+    float getFilterCutoff();                                              // Get the smoothing filter cutoff frequency at rest (Hz).
+    void setFilterCutoff(float filterCutoff);                             // Set the smoothing filter cutoff frequency at rest (Hz, 0 = filter off).
+    float getFilterBeta();                                                // Get the smoothing filter speed coefficient.
+    void setFilterBeta(float filterBeta);                                 // Set the smoothing filter speed coefficient (cutoff increase in Hz per mT/s).
+    void resetFilter();                                                   // Restart the smoothing filter from the next reading.
     int getMinimumRadius();                                               // Get the minimum input radius for square to circle mapping.
     void setMinimumRadius();                                              // Set or update the minimum input radius for square to circle mapping.
     pointFloatType getInputCenter();                                      // Get the updated center compensation point.
     void evaluateInputCenter();                                           // Evaluate the center compensation point.
-    void updateInputCenterBuffer();                                       // Push new center compensation point to joystickCenter
-    pointFloatType getInputMax(int quad);                                 // Get the updated maximum input reading from the selected corner of joystick using the input quadrant. (Calibration purposes)
+    void updateInputCenterBuffer();                                       // Push the last spike free reading to joystickCenter
+    pointFloatType getInputMax(int quad);                                 // Keep the last spike free reading if it is the largest so far of the selected corner, and get the corner. (Calibration purposes)
     void setInputMax(int quad, pointFloatType point);                     // Set the maximum input reading for each corner of joystick using the input quadrant. 
     void zeroInputMax(int quad);                                          // Zero the maximum input reading for each corner of joystick using the input quadrant. 
+    void setCalibrationMode(bool calibrationMode);                        // Pause the drift learning while a calibration moves the joystick on purpose.
+    void beginRangeSweep();                                               // Start recording the range of the joystick in each direction from every reading update() processes.
+    bool endRangeSweep();                                                 // Build the range map from the sweep. False if the sweep didn't cover enough directions.
+    void getRangeMap(uint8_t* rangeMap);                                  // Copy the range map (JOY_RANGE_MAP_SIZE radii in JOY_RANGE_MAP_UNIT).
+    bool setRangeMap(const uint8_t* rangeMap);                            // Load a stored range map. False if it is empty or incomplete.
+    void clearRangeMap();                                                 // Stop using the range map.
+    bool isRangeMapValid();                                               // Is the range map used to map input readings?
     void update();                                                        // Update the joystick reading to get new input from the magnetic sensor and calculate the output.
+    void update(pointFloatType inputRawPoint);                            // Process a supplied raw reading through the joystick pipeline and calculate the output. (Used for replay)
+    void update(pointFloatType inputRawPoint, unsigned long sampleTime);  // Process a supplied raw reading taken at sampleTime (micros()) through the joystick pipeline.
+    bool beginSampling(int sampleRate);                                   // Start reading the sensor at a fixed rate in the background. update() then processes the queued samples.
+    void endSampling();                                                   // Stop background sampling. update() reads the sensor directly again.
+    bool isSampling();                                                    // Is background sampling running?
+    unsigned long getSampleDropCount();                                   // Number of samples lost to a full queue or a busy bus since sampling started
+    unsigned long getLastSampleTime();                                    // micros() of the last processed sensor reading
+    float getTemperature();                                               // Get the smoothed sensor temperature (C)
+    float getReferenceTemperature();                                      // Get the sensor temperature at the last center reset (C)
+    pointFloatType getTemperatureSlope();                                 // Get the learned center drift (mT per C)
+    pointFloatType getCompensatedCenter();                                // Get the center point corrected for temperature drift and the idle correction
+    void resetTemperatureModel();                                         // Forget the learned center drift
+    pointFloatType getAutoCenterShift();                                  // Get the idle center correction since the center was measured (mT)
+    joystickFaultStruct getFaultStats();                                  // Get the sensor fault and spike counters
+    void resetFaultStats();                                               // Clear the sensor fault and spike counters
+    static void samplingInterrupt();                                      // Called from the sample timer interrupt
     int getXOut();                                                        // Get the output x value.
     int getYOut();                                                        // Get the output y value.
     pointFloatType getXYRaw();                                            // Get the raw x and y values.
+    pointFloatType getXYFiltered();                                       // Get the smoothed raw x and y values.
     pointIntType getXYIn();                                               // Get the mapped and filtered x and y values.
     pointIntType getXYOut();                                              // Get the output x and y values.
+    pointIntType getOutputResponse(pointIntType inputPoint);              // Get the output response of a mapped input point without updating the joystick. (Testing purposes)
     int mapRoundInt(int input, int inputStart, int inputEnd, int outputStart, int outputEnd);       // Custom map function that rounds the results instead of truncating
 
   private:
     Tlv493d _Tlv493dSensor = Tlv493d();                                   // Create an object of Tlv493d class
+    pointFloatType readSensor();                                          // Read x and y from the sensor while holding the I2C bus
+    pointFloatType parseSensorReading(const uint8_t* sensorData);         // Convert sensor registers to x and y in mT
+    LSTwimReader _sensorReader;                                           // Asynchronous EasyDMA reader of the sensor registers
+    bool _sensorAsync;                                                    // Is the sensor read with _sensorReader? (Otherwise through the Tlv493d library)
+    uint8_t _sensorReadLength;                                            // Number of sensor registers read each sample
+    pointFloatType _sensorPoint;                                          // Last good sensor reading, returned when a read fails
+    uint8_t _sensorFrameCount;                                            // Frame counter of the last sensor frame
+    unsigned long _sensorFrameTime;                                       // micros() when the frame counter last changed
+    int _sensorFaultRun;                                                  // Faulty frames in a row
+    volatile bool _sensorRecoveryPending;                                 // Set by the sampling task, the recovery runs in update()
+    unsigned long _sensorRecoveryTime;                                    // millis() when the pending recovery is due
+    int _sensorRecoveryCount;                                             // Recovery attempts since the last good frame
+    joystickFaultStruct _faultStats;                                      // Sensor fault and spike counters
+    volatile float _sensorTemperature;                                    // Last sensor temperature reading (C)
+    volatile unsigned long _temperatureReadCount;                         // Number of temperature readings taken
+    unsigned long _temperatureReadTime;                                   // micros() of the last temperature reading
+    unsigned long _temperatureUsedCount;                                  // Number of temperature readings used by the drift model
+    bool _temperatureValid;                                               // Has a temperature reading been used?
+    bool _referenceValid;                                                 // Has the temperature at the center reset been taken?
+    float _temperature;                                                   // Smoothed sensor temperature (C)
+    float _referenceTemperature;                                          // Sensor temperature at the last center reset (C)
+    float _slopeSumTT;                                                    // Weighted sum of squared temperature changes
+    pointFloatType _slopeSumXT;                                           // Weighted sums of center drift times temperature change
+    pointFloatType _temperatureSlope;                                     // Learned center drift (mT per C)
+    pointFloatType _centerOffset;                                         // Center correction for the current temperature (mT)
+    bool _stillValid;                                                     // Has a reading been added to the resting mean?
+    unsigned long _stillSampleTime;                                       // micros() of the last reading added to the resting mean
+    pointFloatType _stillMean;                                            // Exponential mean of the readings (mT)
+    float _stillVariance;                                                 // Exponential variance of x plus y (mT^2)
+    unsigned long _stillStartTime;                                        // micros() of the last reading with output or movement
+    void resetStillness();                                                // Restart the stillness test
+    void updateStillness(pointFloatType inputPoint, unsigned long sampleTime);   // Add a reading to the resting mean and variance
+    bool isStill(unsigned long stillTime, unsigned long sampleTime);      // Has the joystick been untouched for stillTime?
+    float parseSensorTemperature(const uint8_t* sensorData);              // Convert the sensor registers to temperature
+    void setReferenceTemperature();                                       // Take the next temperature as the center reset temperature
+    void updateTemperatureModel(unsigned long sampleTime);                // Learn the center drift and update _centerOffset
+    int _autoCenterCount;                                                 // Resting readings in the current window
+    unsigned long _autoCenterStartTime;                                   // micros() of the first reading in the current window
+    pointFloatType _autoCenterMean;                                       // Running mean of the current window (mT)
+    pointFloatType _autoCenterShift;                                      // Center drift the temperature model doesn't explain (mT)
+    void resetAutoCenter();                                               // The center point was measured, start without correction
+    void updateAutoCenter(pointFloatType inputPoint, unsigned long sampleTime);  // Collect a resting reading and correct the center point
+    int checkFrameCount(bool frameRepeated);                              // Status of a frame with or without a new conversion
+    void updateSensorFault(int sensorStatus);                             // Count a faulty frame and request a recovery if they persist
+    void recoverSensor();                                                 // Clear the bus and re-initialize the sensor without a reboot
+    bool _spikePending;                                                   // The last reading was held as a possible spike
+    pointFloatType rejectSpike(pointFloatType inputPoint);                // Replace a spike with the median of the previous raw readings (Hampel filter)
+    float getMedian(float* values, int size);                             // Median of values (values are sorted in place)
+    static void samplingTask(void* joystick);                             // Sampling task body, waits for the sample timer
+    void sampleSensor(uint32_t numTicks);                                 // Take one sample and push it to _sampleQueue
+    static TaskHandle_t _samplingTaskHandle;                              // Sampling task, notified by the sample timer interrupt
+    LSSampleQueue<joystickSampleStruct, JOY_SAMPLE_QUEUE_SIZE> _sampleQueue;  // Samples waiting to be processed by update()
+    volatile bool _samplingEnabled;                                       // Is background sampling running?
+    volatile unsigned long _sampleDropCount;                              // Samples lost since sampling started
+    unsigned long _lastSampleTime;                                        // micros() of the last processed sensor reading
     LSCircularBuffer <pointFloatType> _joystickRawBuffer;                 // Create a buffer of type pointFloatType to push raw readings 
     LSCircularBuffer <pointIntType> _joystickInputBuffer;                 // Create a buffer of type pointIntType to push mapped and filtered readings 
     LSCircularBuffer <pointIntType> _joystickOutputBuffer;                // Create a buffer of type pointIntType to push mapped readings 
     LSCircularBuffer <pointFloatType> _joystickCenterBuffer;              // Create a buffer of type pointFloatType to push center input readings     
     bool canSkipInputChange(pointFloatType inputPoint);                   // Check if the output change can be skipped (Low-Pass Filter)
-    pointIntType applyRadialDeadzone(pointIntType inputPoint, float inputPointMagnitude, float inputPointAngle);    // Apply radial deadzone to the input based on deadzoneValue and upperDeadzoneValue
+    pointFloatType applyFilter(pointFloatType inputPoint, unsigned long sampleTime);  // Adaptive (One Euro) low-pass filter of raw readings
+    float getFilterAlpha(float cutoff, float sampleInterval);             // Smoothing factor of a first order low-pass filter
+    float applyRadialDeadzone(float inputMagnitude);                      // Apply radial deadzone to the input magnitude based on deadzoneValue and upperDeadzoneValue
     pointIntType processInputReading(pointFloatType inputPoint);          // Process the input readings and map the input reading from square to circle. (-1024 to 1024 output )
-    pointIntType linearizeOutput(pointIntType inputPoint);                // Linearize the output.
-    pointIntType scaleOutput(pointIntType inputPoint, float inputMagnitude, float inputAngle);                    // Scales the output from -1024 1024 to operating mode requirements of gamepad or curosor
+    float linearizeOutput(float inputMagnitude);                          // Linearize the output magnitude by applying the acceleration curve.
+    float scaleOutput(float inputMagnitude);                              // Scales the output magnitude from 0 1024 to operating mode requirements of gamepad or curosor
     pointIntType processOutputResponse(pointIntType inputPoint);          // Process the output (Including linearizeOutput methods and speed control)
+    void updateResponseTable();                                           // Rebuild _responseTable after a deadzone or acceleration change
+    float getResponseMagnitude(float inputMagnitude);                     // Get the output magnitude of an input magnitude from _responseTable
+    pointIntType processInputReadingFixed(pointFloatType inputPoint);     // Fixed-point version of processInputReading (CONF_JOY_FIXED_POINT_MATH)
+    pointIntType processOutputResponseFixed(pointIntType inputPoint);     // Fixed-point version of processOutputResponse (CONF_JOY_FIXED_POINT_MATH)
+    void setSectorTransform();                                            // Build the per-sector input mapping from the calibration corners
+    int findSector(float inputX, float inputY);                           // Sector of a centered reading (-1 if not calibrated)
+    int findSectorFixed(int32_t inputX, int32_t inputY);                  // Sector of a centered fixed-point reading (-1 if not calibrated)
+    pointFloatType _sectorCorner[JOY_SECTOR_NUMBER];                      // First corner of each sector, counterclockwise from the center (mT)
+    int32_t _sectorCornerFixed[JOY_SECTOR_NUMBER][2];                     // _sectorCorner in Q4 (JOY_FIXED_SECTOR_SHIFT)
+    float _sectorTransform[JOY_SECTOR_NUMBER][4];                         // 2x2 input mapping of each sector (row major, output counts per mT)
+    int32_t _sectorTransformFixed[JOY_SECTOR_NUMBER][4];                  // _sectorTransform in fixed-point with _sectorShiftFixed fractional bits
+    int _sectorShiftFixed;                                                // Fractional bits of _sectorTransformFixed
+    bool _sectorValid;                                                    // Do the calibration corners form four sectors?
+    void updateRangeSweep(pointFloatType inputPoint);                      // Record the radius of a reading in its angle bin.
+    bool _sweepActive;                                                    // Is a range sweep recording the readings?
+    float _sweepRadius[JOY_RANGE_MAP_SIZE];                               // Largest radius of the range sweep in progress in each bin (mT)
+    uint8_t _rangeMap[JOY_RANGE_MAP_SIZE];                                // Range of the joystick in each bin (JOY_RANGE_MAP_UNIT per count)
+    float _rangeScale[JOY_RANGE_MAP_SIZE];                                // Output counts per mT in each bin
+    int32_t _rangeScaleFixed[JOY_RANGE_MAP_SIZE];                         // _rangeScale in fixed-point with _rangeShiftFixed fractional bits
+    int _rangeShiftFixed;                                                 // Fractional bits of _rangeScaleFixed
+    bool _rangeMapValid;                                                  // Is the range map used?
+    float getRangePosition(float inputX, float inputY);                   // Bin position of a centered reading (0 to JOY_RANGE_MAP_SIZE)
+    float getRangeScale(float inputX, float inputY);                      // Interpolated output counts per mT in the direction of a centered reading
+    int32_t getRangeScaleFixed(int32_t inputX, int32_t inputY);           // Fixed-point version of getRangeScale (_rangeShiftFixed fractional bits)
+    int _lastSector;                                                      // Sector of the previous reading, checked first
+    uint32_t sqrtInt(uint32_t input);                                     // Integer square root (rounded down)
+    int32_t divRoundInt(int32_t numerator, int32_t denominator);          // Integer division rounded half away from zero
+    int32_t shiftRoundInt(int32_t input, int shift);                      // Arithmetic right shift rounded to nearest
+    int getFixedShift(float valueMax);                                    // Fractional bits that keep a fixed-point factor below JOY_FIXED_VALUE_MAX
+    int32_t toFixed(float value, int shift, int32_t valueMax);            // Convert to fixed-point, rounded and limited to +/-valueMax
     int mapFloatInt(float input, float inputStart, float inputEnd, int outputStart, int outputEnd); // Custom map function to map float to int.
     float mapIntToFloat(int input, int inputStart, int inputEnd, int outputStart, int outputEnd);    // Custom map function that takes integers and outputs a float
     pointFloatType absPoint(pointFloatType inputPoint);                   // Get the absolute value of the point.
@@ -119,6 +341,16 @@ class LSJoystick {
     int sgn(float val);                                                   // Get the sign of the value.
     pointFloatType _magnetInputCalibration[JOY_CALIBR_ARRAY_SIZE];        // Array of calibration points.
     pointFloatType _rawPoint;                                             // Raw x and y values used for debugging purposes.
+    pointFloatType _filteredPoint;                                        // Smoothed raw x and y values passed to processInputReading
+    pointFloatType _spikeFreePoint;                                       // Last raw reading after the spike filter, read by the calibration
+    bool _calibrationMode;                                                // Is a calibration running? (No drift learning)
+    pointFloatType _processedPoint;                                       // Last smoothed point that was processed (reference for canSkipInputChange)
+    float _filterCutoff;                                                  // Smoothing filter cutoff frequency at rest in Hz (0 = off)
+    float _filterBeta;                                                    // Smoothing filter cutoff increase in Hz per mT/s of joystick speed
+    bool _filterStarted;                                                  // Has the smoothing filter received its first reading?
+    pointFloatType _filterRawPoint;                                       // Previous raw reading of the smoothing filter
+    pointFloatType _filterSpeed;                                          // Low-pass filtered joystick speed in mT/s
+    unsigned long _filterTime;                                            // Time of the previous smoothing filter reading (us)
     pointIntType _inputPoint;                                             // Mapped and filtered x and y values
     pointIntType _outputPoint;                                            // Output x and y values
     int _joystickXDirection;                                              // Corrected x value after applying _magnetXDirection
@@ -134,7 +366,12 @@ class LSJoystick {
     int _outerDeadzoneValue;                                              // The calculated upper deadzone value based on upper deadzone factor and maximum value JOY_INPUT_XY_MAX.
     int _rangeLevel;                                                      // The range level from 0 to 10 which is used as speed levels.
     int _rangeValue;                                                      // The calculated range value based on range level and an equation. This is maximum output value for each range level. (Cursor or gamepad)
+    int _accelerationLevel;                                               // The acceleration level from -10 to 10 which is used to select the response curve.
+    float _accelerationExponent;                                          // The exponent of the response curve for the acceleration level (1.0 = linear)
+    int32_t _responseTable[JOY_RESPONSE_TABLE_SIZE];                      // Output magnitude in fixed-point (Q16) for each input magnitude (deadzone, acceleration and scaling applied)
     float _inputRadius;                                                   // The minimum radius of operating area calculated using calibration points.
+    int32_t _inputScaleFixed;                                             // Output counts per mT of _inputRadius in fixed-point with _inputScaleShiftFixed fractional bits
+    int _inputScaleShiftFixed;                                            // Fractional bits of _inputScaleFixed
     bool _skipInputChange;                                                // The flag to low-pass filter the input changes 
     int _operatingMode;                                                   // Operating mode, gamepad or mouse  //TODO 2025-Mar-06 Remove - Joystick class should be independent of operating mode
 
@@ -150,6 +387,27 @@ class LSJoystick {
 // Return     : void
 //*********************************//
 LSJoystick::LSJoystick() {
+  _samplingEnabled = false;                                          // Sensor is read from update() until beginSampling()
+  _sampleDropCount = 0;
+  _lastSampleTime = 0;
+  _sensorAsync = false;                                              // Set up in begin()
+  _sensorReadLength = JOY_SENSOR_READ_XY_LENGTH;
+  _sensorPoint = {0.0, 0.0};
+  _sensorFrameCount = JOY_SENSOR_FRAME_COUNT_NONE;
+  _sensorFrameTime = 0;
+  _sensorFaultRun = 0;
+  _sensorRecoveryPending = false;
+  _sensorRecoveryTime = 0;
+  _sensorRecoveryCount = 0;
+  _spikePending = false;
+  _spikeFreePoint = {0.0, 0.0};
+  _calibrationMode = false;
+  _sweepActive = false;
+  memset(&_faultStats, 0, sizeof(_faultStats));
+  _sensorTemperature = JOY_SENSOR_TEMP_REFERENCE;
+  _temperatureReadCount = 0;
+  _temperatureReadTime = 0;
+  _temperatureUsedCount = 0;
   _joystickRawBuffer.begin(JOY_RAW_BUFF_SIZE);                       // Initialize _joystickRawBuffer
   _joystickInputBuffer.begin(JOY_INPUT_BUFF_SIZE);                   // Initialize _joystickInputBuffer
   _joystickOutputBuffer.begin(JOY_OUTPUT_BUFF_SIZE);                 // Initialize _joystickOutputBuffer
@@ -168,14 +426,31 @@ LSJoystick::LSJoystick() {
 void LSJoystick::begin() {
 
   _inputRadius = 0.0;                                                  // Initialize _inputRadius
+  _inputScaleFixed = 0;                                                // Initialize _inputScaleFixed
+  _inputScaleShiftFixed = 0;
+  _sectorValid = false;                                                // No input mapping until calibrated
+  _lastSector = 0;
+  clearRangeMap();
+  memset(_sweepRadius, 0, sizeof(_sweepRadius));
+  _sweepActive = false;
   _skipInputChange = false;                                            // Initialize _skipInputChange
   _operatingMode = g_operatingMode; //TODO 2025-Mar-06 Remove - Joystick class should be independent of operating mode
+  _accelerationLevel = JOY_ACCELERATION_LEVEL_DEFAULT;                 // Initialize _accelerationLevel
+  _accelerationExponent = 1.0;                                         // Initialize _accelerationExponent (linear)
+  _filterCutoff = CONF_JOY_FILTER_CUTOFF_DEFAULT;                      // Initialize smoothing filter
+  _filterBeta = CONF_JOY_FILTER_BETA_DEFAULT;
+  resetFilter();
+  resetTemperatureModel();
+  resetAutoCenter();
 
   _Tlv493dSensor.begin();  // TODO 2025-Feb-25 This will likely hang if it fails. Ideally replace with something that returns error/success.
+  _Tlv493dSensor.setAccessMode(Tlv493d::MASTERCONTROLLEDMODE);        // Each read triggers the next conversion, no wait for a power-up measurement
+  _sensorAsync = CONF_JOY_SENSOR_ASYNC && _sensorReader.begin(I2CADDR_TLV493D, CONF_JOY_SENSOR_I2C_CLOCK);
   setMagnetDirection(JOY_DIRECTION_DEFAULT, JOY_DIRECTION_DEFAULT);      // Set default magnet direction.
   setInnerDeadzone(JOY_OUTPUT_DEADZONE_STATUS, JOY_OUTPUT_DEADZONE_FACTOR);   // Set default deadzone status and deadzone factor.
   setOuterDeadzone(JOY_OUTPUT_DEADZONE_STATUS, 1.0 - JOY_OUTPUT_DEADZONE_FACTOR);   // Set default deadzone status and deadzone factor.
   setOutputRange(JOY_OUTPUT_RANGE_LEVEL);                               // Set default output range level or speed level.
+  setAccelerationLevel(JOY_ACCELERATION_LEVEL_DEFAULT);                 // Set default acceleration level and build the response table.
   clear();                                                              // Clear calibration array and _joystickOutputBuffer.
 }
 
@@ -196,9 +471,12 @@ void LSJoystick::clear() {
   _magnetInputCalibration[2] = {0.00, 0.00};
   _magnetInputCalibration[3] = {0.00, 0.00};
   _magnetInputCalibration[4] = {0.00, 0.00};
-
+  resetAutoCenter();
 
   _joystickRawBuffer.pushElement({0.0, 0.0});           // Initialize _joystickRawBuffer
+  _spikePending = false;
+  _filteredPoint = {0.0, 0.0};
+  _processedPoint = {0.0, 0.0};
   _joystickInputBuffer.pushElement({0, 0});            // Initialize _joystickInputBuffer
   _joystickOutputBuffer.pushElement({0, 0});           // Initialize _joystickOutputBuffer
   
@@ -285,8 +563,10 @@ void LSJoystick::setMagnetZDirection() {
 
   float zReading = 0.0;
   for (int i = 0 ; i < JOY_MAG_SAMPLE_SIZE ; i++){        // Get the average of 5 z direction reading 
+    g_i2cBusLock.lock();
     _Tlv493dSensor.updateData();
     zReading += _Tlv493dSensor.getZ();
+    g_i2cBusLock.unlock();
   }
   zReading = ((float) zReading) / JOY_MAG_SAMPLE_SIZE;
    
@@ -348,6 +628,8 @@ void LSJoystick::setInnerDeadzone(bool innerDeadzoneEnabled, float innerDeadzone
   } else {
     _innerDeadzoneValue = 0; 
   }    
+
+  updateResponseTable();
 }
 
 //*********************************//
@@ -385,6 +667,20 @@ void LSJoystick::setOuterDeadzone(bool outerDeadzoneEnabled, float outerDeadzone
     _outerDeadzoneValue = JOY_INPUT_XY_MAX; 
   } 
 
+  updateResponseTable();
+}
+
+//*********************************//
+// Function   : getOuterDeadzoneFactor 
+// 
+// Description: Get the outer deadzone factor.
+// 
+// Arguments :  void
+// 
+// Return     : deadzoneFactor  : float : deadzoneFactor from 0.01 to 1.0
+//*********************************//
+float LSJoystick::getOuterDeadzoneFactor(void){
+  return _outerDeadzoneFactor;  
 }
 
 //*********************************//
@@ -442,6 +738,111 @@ int LSJoystick::getMouseSpeedRange(){
   return _rangeValue;
 }
 
+//*********************************//
+// Function   : getAccelerationLevel
+// 
+// Description: Get the acceleration level ( -10 to 10 )
+// 
+// Arguments :  void
+// 
+// Return     : acceleration level : int : acceleration level ( -10 to 10 )
+//*********************************//
+int LSJoystick::getAccelerationLevel(){
+  return _accelerationLevel;
+}
+
+//*********************************//
+// Function   : setAccelerationLevel
+// 
+// Description: Set the acceleration level ( -10 to 10 ) and rebuild the response table.
+//              The level selects the response curve exponent from accProperty.
+//              Negative levels respond faster near the center, positive levels give finer control near the center.
+// 
+// Arguments :  accelerationLevel : int : acceleration level ( -10 to 10 )
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::setAccelerationLevel(int accelerationLevel){
+  if (USB_DEBUG) { Serial.print("USBDEBUG: setAccelerationLevel("); Serial.print(accelerationLevel); Serial.println(")"); }
+
+  accelerationLevel = constrain(accelerationLevel, CONF_JOY_ACCELERATION_LEVEL_MIN, CONF_JOY_ACCELERATION_LEVEL_MAX);
+
+  _accelerationLevel = accelerationLevel;
+  _accelerationExponent = accProperty[accelerationLevel - CONF_JOY_ACCELERATION_LEVEL_MIN].accCoefficient;
+
+  updateResponseTable();
+}
+
+//*********************************//
+// Function   : getFilterCutoff
+// 
+// Description: Get the smoothing filter cutoff frequency at rest
+// 
+// Arguments :  void
+// 
+// Return     : filterCutoff : float : Cutoff frequency in Hz (0 = filter off)
+//*********************************//
+float LSJoystick::getFilterCutoff(){
+  return _filterCutoff;
+}
+
+//*********************************//
+// Function   : setFilterCutoff
+// 
+// Description: Set the smoothing filter cutoff frequency at rest. A lower cutoff smooths more while the joystick is still.
+// 
+// Arguments :  filterCutoff : float : Cutoff frequency in Hz (0 = filter off)
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::setFilterCutoff(float filterCutoff){
+  _filterCutoff = constrain(filterCutoff, CONF_JOY_FILTER_CUTOFF_MIN, CONF_JOY_FILTER_CUTOFF_MAX);
+  resetFilter();
+}
+
+//*********************************//
+// Function   : getFilterBeta
+// 
+// Description: Get the smoothing filter speed coefficient
+// 
+// Arguments :  void
+// 
+// Return     : filterBeta : float : Cutoff increase in Hz per mT/s
+//*********************************//
+float LSJoystick::getFilterBeta(){
+  return _filterBeta;
+}
+
+//*********************************//
+// Function   : setFilterBeta
+// 
+// Description: Set the smoothing filter speed coefficient. A higher value lowers the lag during fast movement.
+// 
+// Arguments :  filterBeta : float : Cutoff increase in Hz per mT/s
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::setFilterBeta(float filterBeta){
+  _filterBeta = constrain(filterBeta, CONF_JOY_FILTER_BETA_MIN, CONF_JOY_FILTER_BETA_MAX);
+  resetFilter();
+}
+
+//*********************************//
+// Function   : resetFilter
+// 
+// Description: Restart the smoothing filter. The next reading passes through unchanged.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::resetFilter(){
+  _filterStarted = false;
+  _filterRawPoint = {0.0, 0.0};
+  _filterSpeed = {0.0, 0.0};
+  _filterTime = 0;
+}
+
 //*********************************//
 // Function   : getMinimumRadius 
 // 
@@ -477,7 +878,389 @@ void LSJoystick::setMinimumRadius(){
       _inputRadius = tempRadius; 
     }
   }
+  _inputScaleFixed = 0;                                                   // Scale used by the fixed-point math
+  if (_inputRadius > 0.0) {
+    _inputScaleShiftFixed = getFixedShift(JOY_INPUT_XY_MAX / _inputRadius);
+    _inputScaleFixed = toFixed(JOY_INPUT_XY_MAX / _inputRadius, _inputScaleShiftFixed, JOY_FIXED_VALUE_MAX);
+  }
   //Serial.println(_inputRadius);
+  setSectorTransform();                                                   // Calibration changed
+}
+
+//*********************************//
+// Function   : setSectorTransform 
+// 
+// Description: Build the input mapping from the calibration corners, so each reading is mapped with a few multiply-adds.
+//              The corners are sorted by angle around the center and split the plane into four sectors.
+//              Each sector gets the 2x2 linear map that takes its two corners to the matching diagonal output points
+//              (magnitude JOY_INPUT_XY_MAX). Every corner reaches full output, so no quadrant is limited
+//              by the weakest one, and the map is continuous because neighbouring sectors share a corner.
+//              If the corners don't form four sectors (not calibrated, or two corners in one quadrant),
+//              readings are mapped to the circle of _inputRadius instead.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::setSectorTransform() {
+  pointFloatType corner[JOY_SECTOR_NUMBER];
+  float cornerAngle[JOY_SECTOR_NUMBER];
+  int cornerOrder[JOY_SECTOR_NUMBER];
+  int diagonalMask = 0;
+
+  _sectorValid = false;
+  _lastSector = 0;
+
+  for (int i = 0; i < JOY_SECTOR_NUMBER; i++) {
+    if (magnitudePoint(_magnetInputCalibration[i + 1]) <= 0.0) {         // Corner not calibrated
+      return;
+    }
+    corner[i] = {_magnetInputCalibration[i + 1].x - _magnetInputCalibration[0].x,
+                 _magnetInputCalibration[i + 1].y - _magnetInputCalibration[0].y};
+    cornerAngle[i] = atan2(corner[i].y, corner[i].x);                    // Calibration only, never per reading
+    diagonalMask |= 1 << (((corner[i].x >= 0.0) ? 1 : 0) + ((corner[i].y >= 0.0) ? 2 : 0));
+
+    // Insertion sort of the corners by angle
+    int j = i;
+    while (j > 0 && cornerAngle[cornerOrder[j - 1]] > cornerAngle[i]) {
+      cornerOrder[j] = cornerOrder[j - 1];
+      j--;
+    }
+    cornerOrder[j] = i;
+  }
+  if (diagonalMask != 0x0F) {                                            // One corner in each quadrant
+    return;
+  }
+
+  float diagonalOutput = JOY_INPUT_XY_MAX / sqrt(2.0);
+  for (int k = 0; k < JOY_SECTOR_NUMBER; k++) {
+    pointFloatType firstCorner = corner[cornerOrder[k]];
+    pointFloatType secondCorner = corner[cornerOrder[(k + 1) % JOY_SECTOR_NUMBER]];
+    float determinant = firstCorner.x * secondCorner.y - secondCorner.x * firstCorner.y;
+    if (determinant <= 0.0) {                                            // Sector wider than 180 degrees
+      return;
+    }
+
+    // Sector coordinates of a reading: inverse of the corner matrix [firstCorner secondCorner]
+    float inverse[4] = { secondCorner.y / determinant, -secondCorner.x / determinant,
+                        -firstCorner.y / determinant,   firstCorner.x / determinant};
+
+    // Output points of the two corners
+    pointFloatType firstTarget = {(firstCorner.x >= 0.0) ? diagonalOutput : -diagonalOutput,
+                                  (firstCorner.y >= 0.0) ? diagonalOutput : -diagonalOutput};
+    pointFloatType secondTarget = {(secondCorner.x >= 0.0) ? diagonalOutput : -diagonalOutput,
+                                   (secondCorner.y >= 0.0) ? diagonalOutput : -diagonalOutput};
+
+    _sectorCorner[k] = firstCorner;
+    _sectorTransform[k][0] = firstTarget.x * inverse[0] + secondTarget.x * inverse[2];
+    _sectorTransform[k][1] = firstTarget.x * inverse[1] + secondTarget.x * inverse[3];
+    _sectorTransform[k][2] = firstTarget.y * inverse[0] + secondTarget.y * inverse[2];
+    _sectorTransform[k][3] = firstTarget.y * inverse[1] + secondTarget.y * inverse[3];
+
+    _sectorCornerFixed[k][0] = toFixed(firstCorner.x, JOY_FIXED_SECTOR_SHIFT, JOY_FIXED_VALUE_MAX);
+    _sectorCornerFixed[k][1] = toFixed(firstCorner.y, JOY_FIXED_SECTOR_SHIFT, JOY_FIXED_VALUE_MAX);
+  }
+
+  // One scale for all sectors that keeps the largest coefficient in 16 bits for the fixed-point math
+  float transformMax = 0.0;
+  for (int k = 0; k < JOY_SECTOR_NUMBER; k++) {
+    for (int i = 0; i < 4; i++) {
+      transformMax = max(transformMax, (float)fabs(_sectorTransform[k][i]));
+    }
+  }
+  _sectorShiftFixed = getFixedShift(transformMax);
+  for (int k = 0; k < JOY_SECTOR_NUMBER; k++) {
+    for (int i = 0; i < 4; i++) {
+      _sectorTransformFixed[k][i] = toFixed(_sectorTransform[k][i], _sectorShiftFixed, JOY_FIXED_VALUE_MAX);
+    }
+  }
+  _sectorValid = true;
+}
+
+//*********************************//
+// Function   : findSector 
+// 
+// Description: Find the sector holding a centered reading. A reading is in sector k if it is counterclockwise
+//              from the first corner and clockwise from the second one (two cross products).
+//              The sector of the previous reading is checked first, so a single check is usually enough.
+// 
+// Arguments :  inputX : float : Centered x reading (mT)
+//              inputY : float : Centered y reading (mT)
+// 
+// Return     : sector : int : Sector index, -1 if the sectors are not valid
+//*********************************//
+int LSJoystick::findSector(float inputX, float inputY) {
+  if (!_sectorValid) {
+    return -1;
+  }
+  for (int i = 0; i < JOY_SECTOR_NUMBER; i++) {
+    int k = (_lastSector + i) % JOY_SECTOR_NUMBER;
+    pointFloatType firstCorner = _sectorCorner[k];
+    pointFloatType secondCorner = _sectorCorner[(k + 1) % JOY_SECTOR_NUMBER];
+    if ((firstCorner.x * inputY - firstCorner.y * inputX) >= 0.0 && (inputX * secondCorner.y - inputY * secondCorner.x) >= 0.0) {
+      _lastSector = k;
+      return k;
+    }
+  }
+  return _lastSector;                                                     // Rounding on a sector edge
+}
+
+//*********************************//
+// Function   : findSectorFixed 
+// 
+// Description: Fixed-point version of findSector
+// 
+// Arguments :  inputX : int32_t : Centered x reading (fixed-point mT, at most JOY_FIXED_VALUE_MAX)
+//              inputY : int32_t : Centered y reading (same fractional bits as inputX)
+// 
+// Return     : sector : int : Sector index, -1 if the sectors are not valid
+//*********************************//
+int LSJoystick::findSectorFixed(int32_t inputX, int32_t inputY) {
+  if (!_sectorValid) {
+    return -1;
+  }
+  for (int i = 0; i < JOY_SECTOR_NUMBER; i++) {
+    int k = (_lastSector + i) % JOY_SECTOR_NUMBER;
+    const int32_t* firstCorner = _sectorCornerFixed[k];
+    const int32_t* secondCorner = _sectorCornerFixed[(k + 1) % JOY_SECTOR_NUMBER];
+    if ((firstCorner[0] * inputY - firstCorner[1] * inputX) >= 0 &&
+        (inputX * secondCorner[1] - inputY * secondCorner[0]) >= 0) {
+      _lastSector = k;
+      return k;
+    }
+  }
+  return _lastSector;
+}
+
+//*********************************//
+// Function   : beginRangeSweep 
+// 
+// Description: Start a range sweep. The user then circles the joystick along the edge of its range while
+//              update() passes every spike free reading to updateRangeSweep(), until endRangeSweep().
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::beginRangeSweep() {
+  memset(_sweepRadius, 0, sizeof(_sweepRadius));
+  _sweepActive = true;
+}
+
+//*********************************//
+// Function   : updateRangeSweep 
+// 
+// Description: Keep the radius of a reading from the center if it is the largest so far in its angle bin.
+// 
+// Arguments :  inputPoint : pointFloatType : Spike free raw reading (mT)
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::updateRangeSweep(pointFloatType inputPoint) {
+  pointFloatType center = getCompensatedCenter();
+  float sweepX = inputPoint.x - center.x;
+  float sweepY = inputPoint.y - center.y;
+  float sweepRadius = sqrt(sq(sweepX) + sq(sweepY));
+  if (sweepRadius < JOY_RANGE_MAP_RADIUS_MIN) {
+    return;
+  }
+  int bin = ((int)getRangePosition(sweepX, sweepY)) % JOY_RANGE_MAP_SIZE;
+  _sweepRadius[bin] = max(_sweepRadius[bin], sweepRadius);
+}
+
+//*********************************//
+// Function   : endRangeSweep 
+// 
+// Description: Build the range map from the sweep. Bins the sweep missed get the radius interpolated between the
+//              nearest recorded bins on either side. The range map is replaced only if at least
+//              JOY_RANGE_MAP_COVERAGE_MIN bins were recorded.
+// 
+// Arguments :  void
+// 
+// Return     : success : bool : True if the range map was replaced
+//*********************************//
+bool LSJoystick::endRangeSweep() {
+  _sweepActive = false;
+  int recordedNumber = 0;
+  int lastRecorded = -1;
+  for (int i = 0; i < JOY_RANGE_MAP_SIZE; i++) {
+    if (_sweepRadius[i] > 0.0) {
+      recordedNumber++;
+      lastRecorded = i;
+    }
+  }
+  if (recordedNumber < JOY_RANGE_MAP_COVERAGE_MIN) {
+    return false;
+  }
+
+  uint8_t rangeMap[JOY_RANGE_MAP_SIZE];
+  int previousRecorded = lastRecorded - JOY_RANGE_MAP_SIZE;              // Search wraps around
+  for (int i = 0; i < JOY_RANGE_MAP_SIZE; i++) {
+    float radius = _sweepRadius[i];
+    if (radius > 0.0) {
+      previousRecorded = i;
+    } else {
+      int nextRecorded = i + 1;
+      while (_sweepRadius[nextRecorded % JOY_RANGE_MAP_SIZE] <= 0.0) {
+        nextRecorded++;
+      }
+      float previousRadius = _sweepRadius[(previousRecorded + JOY_RANGE_MAP_SIZE) % JOY_RANGE_MAP_SIZE];
+      float nextRadius = _sweepRadius[nextRecorded % JOY_RANGE_MAP_SIZE];
+      radius = previousRadius + (nextRadius - previousRadius) * (i - previousRecorded) / (nextRecorded - previousRecorded);
+    }
+    rangeMap[i] = constrain((int)round(radius / JOY_RANGE_MAP_UNIT), 1, 255);
+  }
+  return setRangeMap(rangeMap);
+}
+
+//*********************************//
+// Function   : getRangeMap 
+// 
+// Description: Copy the range map, for example to store it in flash.
+// 
+// Arguments :  rangeMap : uint8_t* : destination of JOY_RANGE_MAP_SIZE radii in JOY_RANGE_MAP_UNIT
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::getRangeMap(uint8_t* rangeMap) {
+  memcpy(rangeMap, _rangeMap, JOY_RANGE_MAP_SIZE);
+}
+
+//*********************************//
+// Function   : setRangeMap 
+// 
+// Description: Load a range map and precompute the output scale of each bin.
+//              A map with an empty bin (all zero when no sweep was stored) is not used.
+// 
+// Arguments :  rangeMap : const uint8_t* : JOY_RANGE_MAP_SIZE radii in JOY_RANGE_MAP_UNIT
+// 
+// Return     : valid : bool : True if the range map is used
+//*********************************//
+bool LSJoystick::setRangeMap(const uint8_t* rangeMap) {
+  float rangeScaleMax = 0.0;
+  memcpy(_rangeMap, rangeMap, JOY_RANGE_MAP_SIZE);
+  _rangeMapValid = true;
+  for (int i = 0; i < JOY_RANGE_MAP_SIZE; i++) {
+    if (_rangeMap[i] == 0) {
+      _rangeMapValid = false;
+      return false;
+    }
+    _rangeScale[i] = JOY_INPUT_XY_MAX / (_rangeMap[i] * JOY_RANGE_MAP_UNIT);
+    rangeScaleMax = max(rangeScaleMax, _rangeScale[i]);
+  }
+  _rangeShiftFixed = getFixedShift(rangeScaleMax);
+  for (int i = 0; i < JOY_RANGE_MAP_SIZE; i++) {
+    _rangeScaleFixed[i] = toFixed(_rangeScale[i], _rangeShiftFixed, JOY_FIXED_VALUE_MAX);
+  }
+  return true;
+}
+
+//*********************************//
+// Function   : clearRangeMap 
+// 
+// Description: Stop using the range map. Input readings are mapped with the calibration corners.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::clearRangeMap() {
+  memset(_rangeMap, 0, sizeof(_rangeMap));
+  _rangeMapValid = false;
+}
+
+//*********************************//
+// Function   : isRangeMapValid 
+// 
+// Description: Is the range map used to map input readings?
+// 
+// Arguments :  void
+// 
+// Return     : valid : bool : True if a complete range map is loaded
+//*********************************//
+bool LSJoystick::isRangeMapValid() {
+  return _rangeMapValid;
+}
+
+//*********************************//
+// Function   : getRangePosition 
+// 
+// Description: Get the range map bin position of a centered reading from its pseudo-angle.
+//              The pseudo-angle grows monotonically with the angle from 0 (+x) through 1 (+y), 2 (-x) and 3 (-y)
+//              and is a ratio of the coordinates, so it costs one division instead of atan2.
+//              Bins are evenly spread in pseudo-angle, so the sweep and the lookup agree.
+// 
+// Arguments :  inputX : float : Centered x reading (mT)
+//              inputY : float : Centered y reading (mT)
+// 
+// Return     : position : float : Bin position (0 to JOY_RANGE_MAP_SIZE)
+//*********************************//
+float LSJoystick::getRangePosition(float inputX, float inputY) {
+  float pseudoAngle;
+  if (inputX == 0.0 && inputY == 0.0) {
+    return 0.0;
+  }
+  if (inputY >= 0.0) {
+    pseudoAngle = (inputX >= 0.0) ? inputY / (inputX + inputY) : 1.0 - inputX / (inputY - inputX);
+  } else {
+    pseudoAngle = (inputX < 0.0) ? 2.0 - inputY / (-inputX - inputY) : 3.0 + inputX / (inputX - inputY);
+  }
+  return pseudoAngle * (JOY_RANGE_MAP_SIZE / 4);
+}
+
+//*********************************//
+// Function   : getRangeScale 
+// 
+// Description: Get the output scale in the direction of a centered reading, interpolated between the two nearest bin centers.
+// 
+// Arguments :  inputX : float : Centered x reading (mT)
+//              inputY : float : Centered y reading (mT)
+// 
+// Return     : scale : float : Output counts per mT
+//*********************************//
+float LSJoystick::getRangeScale(float inputX, float inputY) {
+  float position = getRangePosition(inputX, inputY) - 0.5 + JOY_RANGE_MAP_SIZE;   // Bin centers are at 0.5, kept positive for the wrap
+  int firstBin = (int)position;
+  float weight = position - firstBin;
+  float firstScale = _rangeScale[firstBin % JOY_RANGE_MAP_SIZE];
+  float secondScale = _rangeScale[(firstBin + 1) % JOY_RANGE_MAP_SIZE];
+  return firstScale + (secondScale - firstScale) * weight;
+}
+
+//*********************************//
+// Function   : getRangeScaleFixed 
+// 
+// Description: Fixed-point version of getRangeScale. The pseudo-angle ratio is a single 32 bit division.
+// 
+// Arguments :  inputX : int32_t : Centered x reading (fixed-point mT, at most JOY_FIXED_VALUE_MAX)
+//              inputY : int32_t : Centered y reading (same fractional bits as inputX)
+// 
+// Return     : scale : int32_t : Output counts per mT with _rangeShiftFixed fractional bits
+//*********************************//
+int32_t LSJoystick::getRangeScaleFixed(int32_t inputX, int32_t inputY) {
+  int32_t quadrantStart;
+  int32_t numerator;
+  int32_t denominator;
+  if (inputX == 0 && inputY == 0) {
+    quadrantStart = 0; numerator = 0; denominator = 1;
+  } else if (inputY >= 0) {
+    if (inputX >= 0) { quadrantStart = 0; numerator = inputY;  denominator = inputX + inputY; }
+    else             { quadrantStart = 1; numerator = -inputX; denominator = inputY - inputX; }
+  } else {
+    if (inputX < 0)  { quadrantStart = 2; numerator = -inputY; denominator = -inputX - inputY; }
+    else             { quadrantStart = 3; numerator = inputX;  denominator = inputX - inputY; }
+  }
+
+  // Bin position in Q8, shifted by half a bin to the bin centers and kept positive for the wrap
+  const int32_t positionOne = 1L << JOY_FIXED_POSITION_SHIFT;
+  int32_t position = (quadrantStart * (JOY_RANGE_MAP_SIZE / 4) * positionOne)
+                     + (numerator * (JOY_RANGE_MAP_SIZE / 4) * positionOne) / denominator
+                     - positionOne / 2 + JOY_RANGE_MAP_SIZE * positionOne;
+  int firstBin = position >> JOY_FIXED_POSITION_SHIFT;
+  int32_t weight = position & (positionOne - 1);
+  int32_t firstScale = _rangeScaleFixed[firstBin % JOY_RANGE_MAP_SIZE];
+  int32_t secondScale = _rangeScaleFixed[(firstBin + 1) % JOY_RANGE_MAP_SIZE];
+  return firstScale + (((secondScale - firstScale) * weight) >> JOY_FIXED_POSITION_SHIFT);
 }
 
 
@@ -515,37 +1298,39 @@ void LSJoystick::evaluateInputCenter() {
   centerX = centerX / JOY_CENTER_BUFF_SIZE;
   centerY = centerY / JOY_CENTER_BUFF_SIZE;
   _magnetInputCalibration[0] = {centerX, centerY};
+  setReferenceTemperature();                            // The new center has no temperature drift
+  resetAutoCenter();
 }
 
 
 //*********************************//
 // Function   : updateInputCenterBuffer
 // 
-// Description: Update the compensation center point buffer by pushing new value into _joystickCenterBuffer.
+// Description: Update the compensation center point buffer by pushing the last spike free reading processed by
+//              update() into _joystickCenterBuffer.
 // 
 // Arguments :  void
 // 
 // Return     : void
 //*********************************//
 void LSJoystick::updateInputCenterBuffer() {
-  _Tlv493dSensor.updateData();
-  _joystickCenterBuffer.pushElement({_Tlv493dSensor.getY(), _Tlv493dSensor.getX()});   // Joystick direction mapping
+  _joystickCenterBuffer.pushElement(_spikeFreePoint);
 }
 
 
 //*********************************//
 // Function   : getInputMax 
 // 
-// Description: Get the max point of the input quadrant from _magnetInputCalibration array.
+// Description: Get the max point of the input quadrant from _magnetInputCalibration array, after updating it with
+//              the last spike free reading processed by update().
 // 
 // Arguments :  quad : int : input quadrant
 // 
 // Return     : max point : pointFloatType : The max point
 //*********************************//
 pointFloatType LSJoystick::getInputMax(int quad) {
-  _Tlv493dSensor.updateData();
-  // Get new x and y reading
-  pointFloatType tempCalibrationPoint = {_Tlv493dSensor.getY(), _Tlv493dSensor.getX()};
+  // Get the last x and y reading
+  pointFloatType tempCalibrationPoint = _spikeFreePoint;
 //  Serial.print("x:");
 //  Serial.print(tempCalibrationPoint.x);
 //  Serial.print("y:");
@@ -578,6 +1363,10 @@ pointFloatType LSJoystick::getInputMax(int quad) {
 void LSJoystick::setInputMax(int quad, pointFloatType inputPoint) {
  // Update the calibration point 
   _magnetInputCalibration[quad] = inputPoint;
+  if (quad == 0) {
+    setReferenceTemperature();
+    resetAutoCenter();
+  }
 }
 
 //*********************************//
@@ -594,10 +1383,30 @@ void LSJoystick::zeroInputMax(int quad) {
   _magnetInputCalibration[quad] = {0, 0};
 }
 
+//*********************************//
+// Function   : setCalibrationMode 
+// 
+// Description: Start or end calibration mode. Sampling keeps running during a calibration and its readings are read
+//              with updateInputCenterBuffer(), getInputMax() and the range sweep. The joystick is held in corners and
+//              the calibration center may be cleared, so the stillness test is held in reset and neither the
+//              temperature model nor the idle center correction learns from these readings.
+// 
+// Arguments :  calibrationMode : bool : True while a calibration is running
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::setCalibrationMode(bool calibrationMode) {
+  _calibrationMode = calibrationMode;
+  resetStillness();
+}
+
 //*********************************//
 // Function   : update 
 // 
-// Description: Set the new sensor readings, process data and push to _joystickOutputBuffer
+// Description: Set the new sensor readings, process data and push to _joystickOutputBuffer.
+//              When background sampling is running every queued sample is processed, oldest first,
+//              otherwise the sensor is read once. A sensor recovery requested by readSensor runs here once it is due,
+//              in the calling task rather than the sampling task.
 // 
 // Arguments :  void
 // 
@@ -605,46 +1414,786 @@ void LSJoystick::zeroInputMax(int quad) {
 //*********************************//
 void LSJoystick::update() {
 
-  _Tlv493dSensor.updateData();
-  // Get the new readings as a point
-  _rawPoint = {_Tlv493dSensor.getY(), _Tlv493dSensor.getX()};  // TODO 2025-Feb-25 This should be abstracted to a dedicated function   
-  
-  _skipInputChange = canSkipInputChange(_rawPoint);
-  _joystickRawBuffer.pushElement(_rawPoint);                  // Add raw points to _joystickRawBuffer : DON'T MOVE THIS
+  if (_sensorRecoveryPending && (long)(millis() - _sensorRecoveryTime) >= 0) {
+    recoverSensor();
+  }
 
+  if (_samplingEnabled) {
+    joystickSampleStruct sample;
+    while (_sampleQueue.pop(&sample)) {
+      update(sample.point, sample.sampleTime);
+    }
+    return;
+  }
 
-  if(!_skipInputChange){  // If latest measurement has changed more than the change threshold, process and add to output buffer 
-    _inputPoint = processInputReading(_rawPoint);             // Filtered and scaled input readings
-    _joystickInputBuffer.pushElement(_inputPoint);            // Add new input point to _joystickInputBuffer
-    _outputPoint = processOutputResponse(_inputPoint);        // Process output by applying deadzone, speed control, and linearization
-    _joystickOutputBuffer.pushElement(_outputPoint);          // Add new output point to _joystickOutputBuffer    
-  } 
+  // Get the new readings as a point and process them
+  pointFloatType sensorPoint = readSensor();
+  update(sensorPoint, micros());
 }
 
 //*********************************//
-// Function   : getXOut 
+// Function   : readSensor 
 // 
-// Description: Get the last processed output x value from _joystickOutputBuffer
+// Description: Read the sensor and map its axes to joystick directions.
+//              The I2C bus is held for the transfer as it is shared with the display.
+//              With _sensorAsync the registers are read by EasyDMA and the calling task sleeps until the
+//              transfer completes, so the CPU is free for other tasks. Only _sensorReadLength registers are read.
 // 
 // Arguments :  void
 // 
-// Return     : x value : int : The output x value 
-//*********************************//
-int LSJoystick::getXOut() {
-  return _joystickOutputBuffer.getLastElement().x;
+//              Faulty frames (bus errors, frozen conversions, implausible readings) are counted and replaced by
+//              the last good reading. If they persist a recovery is requested, which update() runs outside this task.
+// 
+// Return     : sensorPoint : pointFloatType : Raw x and y in mT (last good reading if the frame was faulty)
+//*********************************//
+pointFloatType LSJoystick::readSensor() {
+  g_i2cBusLock.lock();
+
+  int sensorStatus = JOY_SENSOR_STATUS_OK;
+  pointFloatType sensorPoint = _sensorPoint;
+  bool readTemperature = CONF_JOY_TEMP_COMPENSATION && (micros() - _temperatureReadTime) >= JOY_TEMP_READ_PERIOD;
+  float sensorTemperature = _sensorTemperature;
+
+  if (_sensorAsync) {
+    uint8_t readLength = readTemperature ? JOY_SENSOR_READ_FULL_LENGTH : _sensorReadLength;   // Temperature needs registers 3 and 6
+    if (_sensorReader.startRead(readLength) && _sensorReader.waitForRead(JOY_SENSOR_READ_TIMEOUT)) {
+      const uint8_t* sensorData = _sensorReader.getReadyBuffer();
+      uint8_t frameCount = (sensorData[3] >> 2) & 0x03;                     // Register 3 bits 3:2 count conversions
+      sensorStatus = checkFrameCount(frameCount == _sensorFrameCount);
+      _sensorFrameCount = frameCount;
+      sensorPoint = parseSensorReading(sensorData);
+      if (readTemperature) {
+        sensorTemperature = parseSensorTemperature(sensorData);
+      }
+    } else {
+      sensorStatus = JOY_SENSOR_STATUS_BUS_ERROR;
+    }
+  } else {
+    int libraryStatus = _Tlv493dSensor.updateData();                        // The library checks the frame counter too
+    if (libraryStatus == TLV493D_BUS_ERROR) {
+      sensorStatus = JOY_SENSOR_STATUS_BUS_ERROR;
+    } else {
+      sensorStatus = checkFrameCount(libraryStatus == TLV493D_FRAME_ERROR);
+    }
+    sensorPoint = {_Tlv493dSensor.getY(), _Tlv493dSensor.getX()};         // Joystick direction mapping
+    sensorTemperature = _Tlv493dSensor.getTemp();                           // The library reads all registers every time
+  }
+
+  if ((sensorStatus == JOY_SENSOR_STATUS_OK || sensorStatus == JOY_SENSOR_STATUS_REPEATED) &&
+      (abs(sensorPoint.x) > JOY_SENSOR_FIELD_MAX || abs(sensorPoint.y) > JOY_SENSOR_FIELD_MAX)) {
+    sensorStatus = JOY_SENSOR_STATUS_IMPLAUSIBLE;
+  }
+
+  updateSensorFault(sensorStatus);
+  if (sensorStatus == JOY_SENSOR_STATUS_OK || sensorStatus == JOY_SENSOR_STATUS_REPEATED) {   // A repeated frame holds the last conversion
+    _sensorPoint = sensorPoint;
+    if (readTemperature) {
+      _sensorTemperature = sensorTemperature;
+      _temperatureReadCount++;                                              // Published after the reading for the consumer
+      _temperatureReadTime = micros();
+    }
+  }
+  sensorPoint = _sensorPoint;
+
+  g_i2cBusLock.unlock();
+  return sensorPoint;
 }
 
 //*********************************//
-// Function   : getYOut 
+// Function   : checkFrameCount 
 // 
-// Description: Get the last processed output y value from _joystickOutputBuffer
+// Description: Get the status of a frame from its frame counter. In master controlled mode a conversion takes up
+//              to JOY_SENSOR_CONVERSION_PERIOD, so reading faster than that returns the same frame again (oversampling).
+//              Only a frame counter that has not changed for JOY_SENSOR_FROZEN_PERIODS conversion periods is frozen.
 // 
-// Arguments :  void
+// Arguments :  frameRepeated : bool : The frame counter is the same as in the last frame
 // 
-// Return     : x value : int : The output x value 
+// Return     : sensorStatus : int : JOY_SENSOR_STATUS_OK, JOY_SENSOR_STATUS_REPEATED or JOY_SENSOR_STATUS_FROZEN
 //*********************************//
-int LSJoystick::getYOut() {
-  return _joystickOutputBuffer.getLastElement().y;
+int LSJoystick::checkFrameCount(bool frameRepeated) {
+  unsigned long frameTime = micros();
+  if (!frameRepeated) {
+    _sensorFrameTime = frameTime;
+    return JOY_SENSOR_STATUS_OK;
+  }
+  if (frameTime - _sensorFrameTime >= (unsigned long)JOY_SENSOR_FROZEN_PERIODS * JOY_SENSOR_CONVERSION_PERIOD) {
+    return JOY_SENSOR_STATUS_FROZEN;
+  }
+  return JOY_SENSOR_STATUS_REPEATED;
+}
+
+//*********************************//
+// Function   : updateSensorFault 
+// 
+// Description: Count a sensor frame by status. After JOY_SENSOR_FAULT_LIMIT faulty frames in a row a recovery
+//              is requested. It is due at once for the first attempt and after JOY_SENSOR_RECOVERY_BACKOFF,
+//              doubled for each further attempt, so a disconnected sensor isn't re-initialized over and over.
+//              After JOY_SENSOR_RECOVERY_ATTEMPT_MAX attempts no more are made until the sensor sends a good frame.
+// 
+// Arguments :  sensorStatus : int : JOY_SENSOR_STATUS_*
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::updateSensorFault(int sensorStatus) {
+  switch (sensorStatus) {
+    case JOY_SENSOR_STATUS_OK:
+      _sensorFaultRun = 0;
+      _sensorRecoveryCount = 0;
+      return;
+    case JOY_SENSOR_STATUS_REPEATED:
+      return;
+    case JOY_SENSOR_STATUS_BUS_ERROR:
+      _faultStats.busErrorCount++;
+      break;
+    case JOY_SENSOR_STATUS_FROZEN:
+      _faultStats.frozenCount++;
+      break;
+    case JOY_SENSOR_STATUS_IMPLAUSIBLE:
+      _faultStats.implausibleCount++;
+      break;
+  }
+
+  _sensorFaultRun++;
+  if (_sensorFaultRun >= JOY_SENSOR_FAULT_LIMIT && !_sensorRecoveryPending && _sensorRecoveryCount < JOY_SENSOR_RECOVERY_ATTEMPT_MAX) {
+    unsigned long recoveryDelay = (_sensorRecoveryCount == 0) ? 0 : ((unsigned long)JOY_SENSOR_RECOVERY_BACKOFF << (_sensorRecoveryCount - 1));
+    _sensorRecoveryTime = millis() + recoveryDelay;
+    _sensorRecoveryPending = true;                                        // Published last for update()
+  }
+}
+
+//*********************************//
+// Function   : recoverSensor 
+// 
+// Description: Clear the I2C bus of a device holding SDA low, then re-initialize the sensor (reset, configuration
+//              and access mode). Called from update() in the loop task, never from the sampling task, so the
+//              sensor start-up delay doesn't stall sampling at high priority. Takes the I2C bus.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::recoverSensor() {
+  g_i2cBusLock.lock();
+  _sensorReader.recoverBus();
+  _Tlv493dSensor.begin();
+  _Tlv493dSensor.setAccessMode(Tlv493d::MASTERCONTROLLEDMODE);
+  _sensorFrameCount = JOY_SENSOR_FRAME_COUNT_NONE;
+  _sensorFaultRun = 0;
+  _sensorRecoveryCount++;
+  _faultStats.sensorResetCount++;
+  _sensorRecoveryPending = false;
+  g_i2cBusLock.unlock();
+}
+
+//*********************************//
+// Function   : parseSensorReading 
+// 
+// Description: Convert the first JOY_SENSOR_READ_XY_LENGTH sensor registers to x and y and map them to joystick directions.
+//              Register 0 and 1 hold the upper 8 bits of x and y, register 4 holds the lower 4 bits of both.
+// 
+// Arguments :  sensorData : const uint8_t* : Sensor registers starting at register 0
+// 
+// Return     : sensorPoint : pointFloatType : Raw x and y in mT
+//*********************************//
+pointFloatType LSJoystick::parseSensorReading(const uint8_t* sensorData) {
+  int16_t xRaw = ((int16_t) ((sensorData[0] << 8) | (sensorData[4] & 0xF0))) >> 4;          // 12 bit two's complement
+  int16_t yRaw = ((int16_t) ((sensorData[1] << 8) | ((sensorData[4] & 0x0F) << 4))) >> 4;
+  return {(float) (yRaw * JOY_SENSOR_MT_PER_LSB), (float) (xRaw * JOY_SENSOR_MT_PER_LSB)};  // Joystick direction mapping
+}
+
+//*********************************//
+// Function   : parseSensorTemperature 
+// 
+// Description: Convert the temperature sensor registers to C.
+//              Register 3 bits 7:4 hold the upper 4 bits of the temperature, register 6 holds the lower 8 bits.
+// 
+// Arguments :  sensorData : const uint8_t* : Sensor registers starting at register 0 (JOY_SENSOR_READ_FULL_LENGTH long)
+// 
+// Return     : temperature : float : Sensor temperature in C
+//*********************************//
+float LSJoystick::parseSensorTemperature(const uint8_t* sensorData) {
+  int16_t temperatureRaw = ((int16_t) (((sensorData[3] & 0xF0) << 8) | (sensorData[6] << 4))) >> 4;   // 12 bit two's complement
+  return (temperatureRaw - JOY_SENSOR_TEMP_OFFSET) * JOY_SENSOR_TEMP_PER_LSB + JOY_SENSOR_TEMP_REFERENCE;
+}
+
+//*********************************//
+// Function   : beginSampling 
+// 
+// Description: Start reading the sensor at a fixed rate, independent of loop() timing.
+//              A hardware timer interrupt wakes a high priority task which reads the sensor
+//              and pushes timestamped samples into _sampleQueue. update() consumes the queue.
+//              The read happens in a task rather than the interrupt because Wire can't be used from an interrupt.
+// 
+// Arguments :  sampleRate : int : Samples per second (JOY_SAMPLE_RATE_MIN to JOY_SAMPLE_RATE_MAX)
+// 
+// Return     : success : bool : False if the sampling task could not be created
+//*********************************//
+bool LSJoystick::beginSampling(int sampleRate) {
+
+  endSampling();
+  sampleRate = constrain(sampleRate, JOY_SAMPLE_RATE_MIN, JOY_SAMPLE_RATE_MAX);
+
+  if (_samplingTaskHandle == NULL) {
+    if (xTaskCreate(samplingTask, "joystick", JOY_SAMPLE_TASK_STACK_SIZE, this, JOY_SAMPLE_TASK_PRIORITY, &_samplingTaskHandle) != pdPASS) {
+      _samplingTaskHandle = NULL;
+      return false;
+    }
+  }
+
+  _sampleQueue.clear();
+  _sampleDropCount = 0;
+  _samplingEnabled = true;
+
+  JOY_SAMPLE_TIMER->TASKS_STOP = 1;
+  JOY_SAMPLE_TIMER->TASKS_CLEAR = 1;
+  JOY_SAMPLE_TIMER->MODE = TIMER_MODE_MODE_Timer;
+  JOY_SAMPLE_TIMER->BITMODE = TIMER_BITMODE_BITMODE_32Bit;
+  JOY_SAMPLE_TIMER->PRESCALER = JOY_SAMPLE_TIMER_PRESCALER;
+  JOY_SAMPLE_TIMER->CC[0] = JOY_SAMPLE_TIMER_FREQUENCY / sampleRate;
+  JOY_SAMPLE_TIMER->SHORTS = TIMER_SHORTS_COMPARE0_CLEAR_Msk;            // Restart the count on every compare so the period has no drift
+  JOY_SAMPLE_TIMER->EVENTS_COMPARE[0] = 0;
+  JOY_SAMPLE_TIMER->INTENSET = TIMER_INTENSET_COMPARE0_Msk;
+
+  NVIC_SetPriority(JOY_SAMPLE_TIMER_IRQN, JOY_SAMPLE_TIMER_IRQ_PRIORITY);
+  NVIC_ClearPendingIRQ(JOY_SAMPLE_TIMER_IRQN);
+  NVIC_EnableIRQ(JOY_SAMPLE_TIMER_IRQN);
+
+  JOY_SAMPLE_TIMER->TASKS_START = 1;
+  return true;
+}
+
+//*********************************//
+// Function   : endSampling 
+// 
+// Description: Stop background sampling. The sampling task stays blocked until sampling is started again.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::endSampling() {
+  JOY_SAMPLE_TIMER->TASKS_STOP = 1;
+  JOY_SAMPLE_TIMER->INTENCLR = TIMER_INTENCLR_COMPARE0_Msk;
+  NVIC_DisableIRQ(JOY_SAMPLE_TIMER_IRQN);
+  _samplingEnabled = false;
+}
+
+//*********************************//
+// Function   : isSampling 
+// 
+// Description: Is background sampling running?
+// 
+// Arguments :  void
+// 
+// Return     : sampling : bool : True if the sensor is read by the sampling task
+//*********************************//
+bool LSJoystick::isSampling() {
+  return _samplingEnabled;
+}
+
+//*********************************//
+// Function   : getSampleDropCount 
+// 
+// Description: Get the number of samples lost since sampling started.
+//              A sample is lost when _sampleQueue is full or when timer ticks pass while the bus is busy.
+// 
+// Arguments :  void
+// 
+// Return     : dropCount : unsigned long : Number of lost samples
+//*********************************//
+unsigned long LSJoystick::getSampleDropCount() {
+  return _sampleDropCount;
+}
+
+//*********************************//
+// Function   : getLastSampleTime 
+// 
+// Description: Get the time of the last processed sensor reading
+// 
+// Arguments :  void
+// 
+// Return     : sampleTime : unsigned long : micros() when the reading completed
+//*********************************//
+unsigned long LSJoystick::getLastSampleTime() {
+  return _lastSampleTime;
+}
+
+//*********************************//
+// Function   : getTemperature 
+// 
+// Description: Get the smoothed sensor temperature
+// 
+// Arguments :  void
+// 
+// Return     : temperature : float : Sensor temperature in C
+//*********************************//
+float LSJoystick::getTemperature() {
+  return _temperature;
+}
+
+//*********************************//
+// Function   : getReferenceTemperature 
+// 
+// Description: Get the sensor temperature at the last center reset. The center correction is zero at this temperature.
+// 
+// Arguments :  void
+// 
+// Return     : temperature : float : Sensor temperature in C
+//*********************************//
+float LSJoystick::getReferenceTemperature() {
+  return _referenceTemperature;
+}
+
+//*********************************//
+// Function   : getTemperatureSlope 
+// 
+// Description: Get the learned center drift per degree of temperature change
+// 
+// Arguments :  void
+// 
+// Return     : slope : pointFloatType : Center drift of x and y in mT per C
+//*********************************//
+pointFloatType LSJoystick::getTemperatureSlope() {
+  return _temperatureSlope;
+}
+
+//*********************************//
+// Function   : getCompensatedCenter 
+// 
+// Description: Get the calibrated center point plus the drift expected at the current temperature and the idle correction
+//              of the drift the temperature model doesn't explain. The calibrated center itself is never changed.
+// 
+// Arguments :  void
+// 
+// Return     : center : pointFloatType : The corrected center point in mT
+//*********************************//
+pointFloatType LSJoystick::getCompensatedCenter() {
+  return {_magnetInputCalibration[0].x + _centerOffset.x + _autoCenterShift.x,
+          _magnetInputCalibration[0].y + _centerOffset.y + _autoCenterShift.y};
+}
+
+//*********************************//
+// Function   : resetTemperatureModel 
+// 
+// Description: Forget the learned center drift. The center correction stays zero until the drift is learned again.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::resetTemperatureModel() {
+  _temperatureValid = false;
+  _referenceValid = false;
+  _temperature = JOY_SENSOR_TEMP_REFERENCE;
+  _referenceTemperature = JOY_SENSOR_TEMP_REFERENCE;
+  _slopeSumTT = 0.0;
+  _slopeSumXT = {0.0, 0.0};
+  _temperatureSlope = {0.0, 0.0};
+  _centerOffset = {0.0, 0.0};
+  resetStillness();
+}
+
+//*********************************//
+// Function   : setReferenceTemperature 
+// 
+// Description: The center point was just measured, so the current temperature becomes the reference and the correction restarts at zero.
+//              The learned drift is kept, but only with JOY_TEMP_PRIOR_WEIGHT so readings against the new reference take over quickly.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::setReferenceTemperature() {
+  _referenceTemperature = _temperature;
+  _referenceValid = _temperatureValid;                  // Otherwise taken from the first temperature reading
+  _slopeSumTT = min(_slopeSumTT, (float)JOY_TEMP_PRIOR_WEIGHT);
+  _slopeSumXT = {_temperatureSlope.x * _slopeSumTT, _temperatureSlope.y * _slopeSumTT};
+  _centerOffset = {0.0, 0.0};
+}
+
+//*********************************//
+// Function   : updateTemperatureModel 
+// 
+// Description: Learn how the center point drifts with temperature and update the center correction.
+//              While the joystick has been still (isStill) for JOY_TEMP_IDLE_TIME the resting mean is the center at the current temperature.
+//              Each new temperature reading then adds the drift from the calibrated center to a weighted least squares fit
+//              (through zero at the reference temperature), with older readings fading by JOY_TEMP_MODEL_DECAY.
+//              The learned drift moves towards the fit by at most JOY_TEMP_SLOPE_STEP_MAX per reading, so a few bad readings can't swing it.
+//              The idle correction (updateAutoCenter) holds the drift the model doesn't explain yet, so the part a new slope explains
+//              is taken off it and the corrected center doesn't move twice for the same drift.
+//              Temperature is read once every JOY_TEMP_READ_PERIOD, so the fit costs a few multiplications per second.
+// 
+// Arguments :  sampleTime : unsigned long : micros() of the reading just processed
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::updateTemperatureModel(unsigned long sampleTime) {
+  unsigned long temperatureReadCount = _temperatureReadCount;
+  if (temperatureReadCount == _temperatureUsedCount) {  // No new temperature reading
+    return;
+  }
+  _temperatureUsedCount = temperatureReadCount;
+
+  float temperature = _sensorTemperature;
+  _temperature = _temperatureValid ? _temperature + JOY_TEMP_SMOOTHING * (temperature - _temperature) : temperature;
+  _temperatureValid = true;
+  if (!_referenceValid) {
+    _referenceTemperature = _temperature;
+    _referenceValid = true;
+  }
+
+  float temperatureChange = _temperature - _referenceTemperature;
+  if (isStill(JOY_TEMP_IDLE_TIME, sampleTime) && abs(temperatureChange) >= JOY_TEMP_DELTA_MIN) {
+    // Total drift from the measured center
+    pointFloatType center = _magnetInputCalibration[0];
+    pointFloatType previousSlope = _temperatureSlope;
+    _slopeSumTT = JOY_TEMP_MODEL_DECAY * _slopeSumTT + sq(temperatureChange);
+    _slopeSumXT.x = JOY_TEMP_MODEL_DECAY * _slopeSumXT.x + (_stillMean.x - center.x) * temperatureChange;
+    _slopeSumXT.y = JOY_TEMP_MODEL_DECAY * _slopeSumXT.y + (_stillMean.y - center.y) * temperatureChange;
+    float slopeStepX = constrain(_slopeSumXT.x / _slopeSumTT - _temperatureSlope.x, -JOY_TEMP_SLOPE_STEP_MAX, JOY_TEMP_SLOPE_STEP_MAX);
+    float slopeStepY = constrain(_slopeSumXT.y / _slopeSumTT - _temperatureSlope.y, -JOY_TEMP_SLOPE_STEP_MAX, JOY_TEMP_SLOPE_STEP_MAX);
+    _temperatureSlope.x = constrain(_temperatureSlope.x + slopeStepX, -JOY_TEMP_SLOPE_MAX, JOY_TEMP_SLOPE_MAX);
+    _temperatureSlope.y = constrain(_temperatureSlope.y + slopeStepY, -JOY_TEMP_SLOPE_MAX, JOY_TEMP_SLOPE_MAX);
+
+#if CONF_JOY_AUTO_CENTER
+    // Hand the drift the new slope explains over from the idle correction
+    _autoCenterShift.x = constrain(_autoCenterShift.x - (_temperatureSlope.x - previousSlope.x) * temperatureChange, -JOY_AUTO_CENTER_SHIFT_MAX, JOY_AUTO_CENTER_SHIFT_MAX);
+    _autoCenterShift.y = constrain(_autoCenterShift.y - (_temperatureSlope.y - previousSlope.y) * temperatureChange, -JOY_AUTO_CENTER_SHIFT_MAX, JOY_AUTO_CENTER_SHIFT_MAX);
+#endif
+  }
+
+  _centerOffset = {_temperatureSlope.x * temperatureChange, _temperatureSlope.y * temperatureChange};
+}
+
+//*********************************//
+// Function   : resetStillness 
+// 
+// Description: Restart the stillness test. The joystick counts as moved at the last reading.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::resetStillness() {
+  _stillValid = false;
+  _stillSampleTime = _lastSampleTime;
+  _stillMean = {0.0, 0.0};
+  _stillVariance = 0.0;
+  _stillStartTime = _lastSampleTime;
+}
+
+//*********************************//
+// Function   : updateStillness 
+// 
+// Description: Add a reading to the exponential mean and variance of the readings (time constant JOY_STILL_TIME_CONSTANT,
+//              so the test doesn't depend on the sample rate). The joystick is still while the output is zero and the
+//              variance is at most JOY_STILL_VARIANCE_MAX, which sensor noise stays well below but a touch inside the
+//              deadzone doesn't. Used by both the temperature drift learning and the idle center correction.
+// 
+// Arguments :  inputPoint : pointFloatType : Spike free raw reading (mT)
+//              sampleTime : unsigned long : micros() of the reading
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::updateStillness(pointFloatType inputPoint, unsigned long sampleTime) {
+  if (!_stillValid) {                                   // The idle time counts from the first reading
+    _stillMean = inputPoint;
+    _stillVariance = 0.0;
+    _stillStartTime = sampleTime;
+    _stillValid = true;
+  } else {
+    float alpha = 1.0 - exp(-(float)(sampleTime - _stillSampleTime) / JOY_STILL_TIME_CONSTANT);
+    float deltaX = inputPoint.x - _stillMean.x;
+    float deltaY = inputPoint.y - _stillMean.y;
+    _stillMean.x += alpha * deltaX;
+    _stillMean.y += alpha * deltaY;
+    _stillVariance = (1.0 - alpha) * (_stillVariance + alpha * (sq(deltaX) + sq(deltaY)));
+  }
+  _stillSampleTime = sampleTime;
+
+  if (_outputPoint.x != 0 || _outputPoint.y != 0 || _stillVariance > JOY_STILL_VARIANCE_MAX) {
+    _stillStartTime = sampleTime;
+  }
+}
+
+//*********************************//
+// Function   : isStill 
+// 
+// Description: Has the joystick been still (zero output and resting variance) for at least stillTime?
+// 
+// Arguments :  stillTime : unsigned long : Time in us
+//              sampleTime : unsigned long : micros() of the last reading
+// 
+// Return     : still : bool : True if it has been still for stillTime
+//*********************************//
+bool LSJoystick::isStill(unsigned long stillTime, unsigned long sampleTime) {
+  return (sampleTime - _stillStartTime) >= stillTime;
+}
+
+//*********************************//
+// Function   : getAutoCenterShift 
+// 
+// Description: Get the idle correction of the center point: the drift since the center was measured that the
+//              temperature model doesn't explain
+// 
+// Arguments :  void
+// 
+// Return     : shift : pointFloatType : Center correction of x and y in mT
+//*********************************//
+pointFloatType LSJoystick::getAutoCenterShift() {
+  return _autoCenterShift;
+}
+
+//*********************************//
+// Function   : resetAutoCenter 
+// 
+// Description: The center point was just measured, so the idle correction restarts at zero with an empty window.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::resetAutoCenter() {
+  _autoCenterCount = 0;
+  _autoCenterStartTime = _lastSampleTime;
+  _autoCenterMean = {0.0, 0.0};
+  _autoCenterShift = {0.0, 0.0};
+}
+
+//*********************************//
+// Function   : updateAutoCenter 
+// 
+// Description: Correct slow center drift in the background.
+//              After the joystick has been still (isStill) for JOY_AUTO_CENTER_IDLE_TIME the readings are averaged in windows
+//              of JOY_AUTO_CENTER_WINDOW_TIME, so a correction takes the same time at any sample rate. Any output or movement
+//              restarts the window, and a light push inside the deadzone fails the stillness test, so it is not learned.
+//              The corrected center (getCompensatedCenter) then moves JOY_AUTO_CENTER_GAIN of the way to the mean.
+//              This is the one place the center follows the resting readings: the temperature model only predicts the drift
+//              and hands over what it explains (updateTemperatureModel). The correction stays in RAM apart from the calibration,
+//              a measured center (evaluateInputCenter, setInputMax) replaces it.
+// 
+// Arguments :  inputPoint : pointFloatType : Spike free raw reading (mT)
+//              sampleTime : unsigned long : micros() of the reading
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::updateAutoCenter(pointFloatType inputPoint, unsigned long sampleTime) {
+  if (!isStill(JOY_AUTO_CENTER_IDLE_TIME, sampleTime)) {
+    _autoCenterCount = 0;
+    return;
+  }
+
+  if (_autoCenterCount == 0) {
+    _autoCenterMean = {0.0, 0.0};
+    _autoCenterStartTime = sampleTime;
+  }
+  _autoCenterCount++;
+  _autoCenterMean.x += (inputPoint.x - _autoCenterMean.x) / _autoCenterCount;
+  _autoCenterMean.y += (inputPoint.y - _autoCenterMean.y) / _autoCenterCount;
+  if ((sampleTime - _autoCenterStartTime) < JOY_AUTO_CENTER_WINDOW_TIME) {
+    return;
+  }
+  _autoCenterCount = 0;
+
+  pointFloatType center = getCompensatedCenter();
+  _autoCenterShift.x = constrain(_autoCenterShift.x + JOY_AUTO_CENTER_GAIN * (_autoCenterMean.x - center.x), -JOY_AUTO_CENTER_SHIFT_MAX, JOY_AUTO_CENTER_SHIFT_MAX);
+  _autoCenterShift.y = constrain(_autoCenterShift.y + JOY_AUTO_CENTER_GAIN * (_autoCenterMean.y - center.y), -JOY_AUTO_CENTER_SHIFT_MAX, JOY_AUTO_CENTER_SHIFT_MAX);
+}
+
+//*********************************//
+// Function   : getFaultStats 
+// 
+// Description: Get the sensor fault and spike counters
+// 
+// Arguments :  void
+// 
+// Return     : faultStats : joystickFaultStruct : The counters
+//*********************************//
+joystickFaultStruct LSJoystick::getFaultStats() {
+  joystickFaultStruct faultStats = _faultStats;
+  faultStats.sampleDropCount = _sampleDropCount;
+  return faultStats;
+}
+
+//*********************************//
+// Function   : resetFaultStats 
+// 
+// Description: Clear the sensor fault and spike counters
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::resetFaultStats() {
+  memset(&_faultStats, 0, sizeof(_faultStats));
+  _sampleDropCount = 0;
+}
+
+//*********************************//
+// Function   : samplingTask 
+// 
+// Description: Body of the sampling task. Blocks until the sample timer interrupt gives a notification.
+// 
+// Arguments :  joystick : void* : The LSJoystick instance that owns the task
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::samplingTask(void* joystick) {
+  for (;;) {
+    uint32_t numTicks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);        // Take all pending ticks at once
+    ((LSJoystick*) joystick)->sampleSensor(numTicks);
+  }
+}
+
+//*********************************//
+// Function   : sampleSensor 
+// 
+// Description: Read the sensor once and push the sample to _sampleQueue. Runs in the sampling task.
+// 
+// Arguments :  numTicks : uint32_t : Timer ticks since the last sample (more than one if the bus was held)
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::sampleSensor(uint32_t numTicks) {
+  if (!_samplingEnabled) {
+    return;
+  }
+  if (numTicks > 1) {
+    _sampleDropCount += numTicks - 1;
+  }
+
+  joystickSampleStruct sample;
+  sample.point = readSensor();
+  sample.sampleTime = micros();
+  if (!_sampleQueue.push(sample)) {                                       // Keep the queued samples, update() will catch up
+    _sampleDropCount++;
+  }
+}
+
+//*********************************//
+// Function   : samplingInterrupt 
+// 
+// Description: Wake the sampling task. Called from the sample timer interrupt.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::samplingInterrupt() {
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  if (_samplingTaskHandle != NULL) {
+    vTaskNotifyGiveFromISR(_samplingTaskHandle, &higherPriorityTaskWoken);
+  }
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+TaskHandle_t LSJoystick::_samplingTaskHandle = NULL;
+
+//*********************************//
+// Function   : TIMER4_IRQHandler 
+// 
+// Description: Sample timer (JOY_SAMPLE_TIMER) compare interrupt
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+extern "C" void TIMER4_IRQHandler(void) {
+  if (JOY_SAMPLE_TIMER->EVENTS_COMPARE[0]) {
+    JOY_SAMPLE_TIMER->EVENTS_COMPARE[0] = 0;
+    (void) JOY_SAMPLE_TIMER->EVENTS_COMPARE[0];                           // Read back so the event is cleared before returning
+    LSJoystick::samplingInterrupt();
+  }
+}
+
+//*********************************//
+// Function   : update 
+// 
+// Description: Process a supplied raw reading taken now and push to _joystickOutputBuffer.
+//              This is the sensor independent part of update() and is used to replay recorded traces.
+// 
+// Arguments :  inputRawPoint : pointFloatType : Raw magnet reading in mT (already mapped to joystick directions)
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::update(pointFloatType inputRawPoint) {
+  update(inputRawPoint, micros());
+}
+
+//*********************************//
+// Function   : update 
+// 
+// Description: Process a supplied raw reading and push to _joystickOutputBuffer.
+//              The reading is smoothed by applyFilter before it is mapped.
+// 
+// Arguments :  inputRawPoint : pointFloatType : Raw magnet reading in mT (already mapped to joystick directions)
+//              sampleTime : unsigned long : micros() when the reading was taken
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::update(pointFloatType inputRawPoint, unsigned long sampleTime) {
+
+  _rawPoint = inputRawPoint;
+  _lastSampleTime = sampleTime;
+  _spikeFreePoint = rejectSpike(_rawPoint);                   // Compared with the previous raw readings : DON'T MOVE BELOW THE PUSH
+  _joystickRawBuffer.pushElement(_rawPoint);                  // Add raw points to _joystickRawBuffer
+
+  _filteredPoint = applyFilter(_spikeFreePoint, sampleTime);  // Smooth heavily at rest, lightly while moving
+  _skipInputChange = canSkipInputChange(_filteredPoint);
+
+  if(!_skipInputChange){  // If latest measurement has changed more than the change threshold, process and add to output buffer 
+    _processedPoint = _filteredPoint;
+#if CONF_JOY_FIXED_POINT_MATH
+    _inputPoint = processInputReadingFixed(_filteredPoint);   // Filtered and scaled input readings
+    _joystickInputBuffer.pushElement(_inputPoint);            // Add new input point to _joystickInputBuffer
+    _outputPoint = processOutputResponseFixed(_inputPoint);   // Process output by applying deadzone, speed control, and linearization
+#else
+    _inputPoint = processInputReading(_filteredPoint);        // Filtered and scaled input readings
+    _joystickInputBuffer.pushElement(_inputPoint);            // Add new input point to _joystickInputBuffer
+    _outputPoint = processOutputResponse(_inputPoint);        // Process output by applying deadzone, speed control, and linearization
+#endif
+    _joystickOutputBuffer.pushElement(_outputPoint);          // Add new output point to _joystickOutputBuffer    
+  } 
+
+  if (_sweepActive) {
+    updateRangeSweep(_spikeFreePoint);
+  }
+
+  if (_calibrationMode) {
+    resetStillness();                                         // Moved on purpose, nothing is learned
+  } else {
+    updateStillness(_spikeFreePoint, sampleTime);             // Shared by the temperature model and the idle center correction
+  }
+  updateTemperatureModel(sampleTime);                         // Center correction applies from the next reading
+#if CONF_JOY_AUTO_CENTER
+  updateAutoCenter(_spikeFreePoint, sampleTime);
+#endif
+}
+
+//*********************************//
+// Function   : getXOut 
+// 
+// Description: Get the last processed output x value from _joystickOutputBuffer
+// 
+// Arguments :  void
+// 
+// Return     : x value : int : The output x value 
+//*********************************//
+int LSJoystick::getXOut() {
+  return _joystickOutputBuffer.getLastElement().x;
+}
+
+//*********************************//
+// Function   : getYOut 
+// 
+// Description: Get the last processed output y value from _joystickOutputBuffer
+// 
+// Arguments :  void
+// 
+// Return     : x value : int : The output x value 
+//*********************************//
+int LSJoystick::getYOut() {
+  return _joystickOutputBuffer.getLastElement().y;
 }
 
 //*********************************//
@@ -661,6 +2210,20 @@ pointFloatType LSJoystick::getXYRaw() {
 }
 
 
+//*********************************//
+// Function   : getXYFiltered
+// 
+// Description: Get the last smoothed raw x and y values (input of processInputReading)
+// 
+// Arguments :  void
+// 
+// Return     : output point : pointFloatType : The smoothed x and y point in mT
+//*********************************//
+pointFloatType LSJoystick::getXYFiltered() {
+  return _filteredPoint;
+}
+
+
 //*********************************//
 // Function   : getXYIn 
 // 
@@ -688,6 +2251,24 @@ pointIntType LSJoystick::getXYOut() {
   return _joystickOutputBuffer.getLastElement();
 }
 
+//*********************************//
+// Function   : getOutputResponse 
+// 
+// Description: Process a mapped input point through the output response stage (deadzone, linearization 
+//              and scaling) without changing the joystick buffers. Used to verify the output response.
+// 
+// Arguments :  inputPoint : pointIntType : Mapped input point (-1024 to 1024)
+// 
+// Return     : output point : pointIntType : The output x and y point
+//*********************************//
+pointIntType LSJoystick::getOutputResponse(pointIntType inputPoint) {
+#if CONF_JOY_FIXED_POINT_MATH
+  return processOutputResponseFixed(inputPoint);
+#else
+  return processOutputResponse(inputPoint);
+#endif
+}
+
 
 //*********************************//
 //********Private******************//
@@ -697,22 +2278,15 @@ pointIntType LSJoystick::getXYOut() {
 //*********************************//
 // Function   : applyRadialDeadzone 
 // 
-// Description: Apply the radial deadzone to the output value 
+// Description: Apply the radial deadzone to the output magnitude
 // 
-// Arguments :  inputPoint : pointIntType : Input point coordinates
-//              inputPointMagnitude : float : Magnitude of input point
-//              inputPointAngle : float : Angle of input point
+// Arguments :  inputMagnitude : float : Magnitude of input point
 // 
-// Return     : outputPoint : pointIntType : Output with deadzone applied
+// Return     : outputMagnitude : float : Magnitude with deadzone applied (0 to JOY_INPUT_XY_MAX)
 //*********************************//
-pointIntType LSJoystick::applyRadialDeadzone(pointIntType inputPoint, float inputPointMagnitude, float inputPointAngle) {
+float LSJoystick::applyRadialDeadzone(float inputMagnitude) {
 
- 
-  pointIntType outputPoint = {0,0};
-
-   // Output the input if Deadzone is not enabled
-   // if Deadzone is not enabled, if it is enabled it will be overwritten
-  outputPoint = inputPoint;  
+  float outputMagnitude = inputMagnitude;
 
   int innerDeadzoneValue; 
   int outerDeadzoneValue; 
@@ -730,98 +2304,224 @@ pointIntType LSJoystick::applyRadialDeadzone(pointIntType inputPoint, float inpu
     outerDeadzoneValue = JOY_INPUT_XY_MAX;
   }
 
-  //float deadzoneScalingFactor = (inputPointMagnitude - innerDeadzoneValue) / (outerDeadzoneValue - innerDeadzoneValue);
-
   // Apply deadzone
 
-  if (inputPointMagnitude <= innerDeadzoneValue) {
+  if (inputMagnitude <= innerDeadzoneValue) {
     // No output
-    outputPoint = {0,0};
-  } else if (inputPointMagnitude >= outerDeadzoneValue) {
-    // Set x,y value of output point on circle of radius JOY_INPUT_XY_MAX at angle of input point
-    outputPoint = pointIntFromMagnitudeAngle(JOY_INPUT_XY_MAX, inputPointAngle);
-
-    //outputPoint.x = sgn(inputPoint.x) * abs(round(cos(inputPointAngle) * JOY_INPUT_XY_MAX));   
-    //outputPoint.y = sgn(inputPoint.y) * abs(round(sin(inputPointAngle) * JOY_INPUT_XY_MAX));   
-
-  } else { // (innerDeadzoneValue < inputPointMagnitude < outerDeadzoneValue)
+    outputMagnitude = 0.0;
+  } else if (inputMagnitude >= outerDeadzoneValue) {
+    // Output on circle of radius JOY_INPUT_XY_MAX
+    outputMagnitude = JOY_INPUT_XY_MAX;
+  } else { // (innerDeadzoneValue < inputMagnitude < outerDeadzoneValue)
     // Map the input magnitudes between the lower and outer deadzones to between 0 and the maximum value
-    
-    int outputMagnitude = mapRoundInt(inputPointMagnitude, _innerDeadzoneValue, _outerDeadzoneValue, 0, JOY_INPUT_XY_MAX);
-    outputPoint = pointIntFromMagnitudeAngle(outputMagnitude, inputPointAngle);
-
+    outputMagnitude = mapRoundInt(inputMagnitude, _innerDeadzoneValue, _outerDeadzoneValue, 0, JOY_INPUT_XY_MAX);
   }
 
- return outputPoint;
+ return outputMagnitude;
 }
 
 //*********************************//
 // Function   : canSkipInputChange 
 // 
-// Description: Check if the input change can be skipped  
+// Description: Check if the input change can be skipped.
+//              The reading is compared with the last processed reading, not the previous sample,
+//              so slow movements still add up at high sample rates.
 // 
-// Arguments :  inputPoint : pointFloatType : raw input reading
+// Arguments :  inputPoint : pointFloatType : smoothed input reading
 // 
 // Return     : skipInputChange : bool : skip processing if it's true
 //*********************************//
 bool LSJoystick::canSkipInputChange(pointFloatType inputPoint) {      
-  pointFloatType prevInputPoint = _joystickRawBuffer.getLastElement();           // Get the previous point from buffer 
 
   // If latest joystick measurement is less than JOY_INPUT_CHANGE_TOLERANCE (0.1 mT), then don't process 
-  bool skipInputChange = abs(_rawPoint.x - prevInputPoint.x) < JOY_INPUT_CHANGE_TOLERANCE 
-                      && abs(_rawPoint.y - prevInputPoint.y) < JOY_INPUT_CHANGE_TOLERANCE;
+  bool skipInputChange = abs(inputPoint.x - _processedPoint.x) < JOY_INPUT_CHANGE_TOLERANCE 
+                      && abs(inputPoint.y - _processedPoint.y) < JOY_INPUT_CHANGE_TOLERANCE;
 
   return skipInputChange;
 }
 
+//*********************************//
+// Function   : rejectSpike 
+// 
+// Description: Hampel filter. The reading is compared with the median of the previous JOY_SPIKE_WINDOW_SIZE raw readings.
+//              If either axis is more than JOY_SPIKE_THRESHOLD deviations away, the median is returned instead.
+//              The deviation is estimated from the median absolute deviation of the window (at least JOY_SPIKE_DEVIATION_MIN).
+//              An outlier that is within the same limits of the previous raw reading continues a real movement
+//              (a fast flick moves the joystick further in one sample than the window allows), so it is passed.
+//              A held outlier is only counted as a spike if the next reading doesn't confirm it, so a step is
+//              passed one sample late and not counted.
+// 
+// Arguments :  inputPoint : pointFloatType : raw input reading in mT
+// 
+// Return     : outputPoint : pointFloatType : the reading, or the window median if it was a spike
+//*********************************//
+pointFloatType LSJoystick::rejectSpike(pointFloatType inputPoint) {
+  if (_joystickRawBuffer.getLength() < JOY_SPIKE_WINDOW_SIZE) {
+    return inputPoint;
+  }
+
+  float xWindow[JOY_SPIKE_WINDOW_SIZE];
+  float yWindow[JOY_SPIKE_WINDOW_SIZE];
+  for (int i = 0; i < JOY_SPIKE_WINDOW_SIZE; i++) {
+    pointFloatType windowPoint = _joystickRawBuffer.getElement(i);
+    xWindow[i] = windowPoint.x;
+    yWindow[i] = windowPoint.y;
+  }
+  pointFloatType medianPoint = {getMedian(xWindow, JOY_SPIKE_WINDOW_SIZE), getMedian(yWindow, JOY_SPIKE_WINDOW_SIZE)};
+
+  for (int i = 0; i < JOY_SPIKE_WINDOW_SIZE; i++) {                        // Absolute deviations from the median
+    xWindow[i] = abs(xWindow[i] - medianPoint.x);
+    yWindow[i] = abs(yWindow[i] - medianPoint.y);
+  }
+  float xLimit = JOY_SPIKE_THRESHOLD * max((float)(JOY_SPIKE_MAD_SCALE * getMedian(xWindow, JOY_SPIKE_WINDOW_SIZE)), (float)JOY_SPIKE_DEVIATION_MIN);
+  float yLimit = JOY_SPIKE_THRESHOLD * max((float)(JOY_SPIKE_MAD_SCALE * getMedian(yWindow, JOY_SPIKE_WINDOW_SIZE)), (float)JOY_SPIKE_DEVIATION_MIN);
+
+  pointFloatType previousPoint = _joystickRawBuffer.getLastElement();
+  bool outlier = abs(inputPoint.x - medianPoint.x) > xLimit || abs(inputPoint.y - medianPoint.y) > yLimit;
+  bool continued = abs(inputPoint.x - previousPoint.x) <= xLimit && abs(inputPoint.y - previousPoint.y) <= yLimit;
+
+  if (_spikePending && !continued) {                                       // The held reading was not confirmed
+    _faultStats.spikeCount++;
+  }
+  _spikePending = outlier && !continued;
+  return _spikePending ? medianPoint : inputPoint;
+}
+
+//*********************************//
+// Function   : getMedian 
+// 
+// Description: Get the median of a small array. The array is sorted in place (insertion sort).
+// 
+// Arguments :  values : float* : the values
+//              size : int : number of values
+// 
+// Return     : median : float : the middle value (mean of the two middle values for an even size)
+//*********************************//
+float LSJoystick::getMedian(float* values, int size) {
+  for (int i = 1; i < size; i++) {
+    float value = values[i];
+    int j = i - 1;
+    while (j >= 0 && values[j] > value) {
+      values[j + 1] = values[j];
+      j--;
+    }
+    values[j + 1] = value;
+  }
+  return (size % 2) ? values[size / 2] : (values[size / 2 - 1] + values[size / 2]) / 2.0;
+}
+
+//*********************************//
+// Function   : applyFilter 
+// 
+// Description: Adaptive low-pass filter (One Euro filter) of the raw readings.
+//              The cutoff frequency rises with the filtered joystick speed:
+//              cutoff = _filterCutoff + _filterBeta * speed
+//              so jitter is removed at rest while fast movements are followed with little lag.
+//              Both axes use the same cutoff so the direction of movement is not distorted.
+// 
+// Arguments :  inputPoint : pointFloatType : raw input reading in mT
+//              sampleTime : unsigned long : micros() when the reading was taken
+// 
+// Return     : filteredPoint : pointFloatType : smoothed reading in mT
+//*********************************//
+pointFloatType LSJoystick::applyFilter(pointFloatType inputPoint, unsigned long sampleTime) {
+
+  unsigned long sampleInterval = sampleTime - _filterTime;
+
+  if (_filterCutoff <= 0.0 || !_filterStarted || sampleInterval > JOY_FILTER_RESET_TIME) {
+    _filterStarted = (_filterCutoff > 0.0);                                // Start (or restart after a gap) from this reading
+    _filterRawPoint = inputPoint;
+    _filterSpeed = {0.0, 0.0};
+    _filterTime = sampleTime;
+    return inputPoint;
+  }
+  if (sampleInterval == 0) {
+    return _filteredPoint;
+  }
+
+  float intervalSeconds = sampleInterval / 1000000.0;
+  _filterTime = sampleTime;
+
+  // Filtered speed in mT/s
+  float speedAlpha = getFilterAlpha(JOY_FILTER_DERIVATIVE_CUTOFF, intervalSeconds);
+  _filterSpeed.x += speedAlpha * ((inputPoint.x - _filterRawPoint.x) / intervalSeconds - _filterSpeed.x);
+  _filterSpeed.y += speedAlpha * ((inputPoint.y - _filterRawPoint.y) / intervalSeconds - _filterSpeed.y);
+  _filterRawPoint = inputPoint;
+
+  // Speed dependent cutoff
+  float cutoff = _filterCutoff + _filterBeta * magnitudePoint(_filterSpeed);
+  float pointAlpha = getFilterAlpha(cutoff, intervalSeconds);
+
+  pointFloatType filteredPoint;
+  filteredPoint.x = _filteredPoint.x + pointAlpha * (inputPoint.x - _filteredPoint.x);
+  filteredPoint.y = _filteredPoint.y + pointAlpha * (inputPoint.y - _filteredPoint.y);
+  return filteredPoint;
+}
+
+//*********************************//
+// Function   : getFilterAlpha 
+// 
+// Description: Smoothing factor of a first order low-pass filter: 1 / (1 + tau / interval), tau = 1 / (2 * PI * cutoff)
+// 
+// Arguments :  cutoff : float : cutoff frequency in Hz
+//              sampleInterval : float : time since the previous reading in s
+// 
+// Return     : alpha : float : smoothing factor (0 to 1)
+//*********************************//
+float LSJoystick::getFilterAlpha(float cutoff, float sampleInterval) {
+  float tau = 1.0 / (2.0 * PI * cutoff);
+  return 1.0 / (1.0 + tau / sampleInterval);
+}
+
 
 //*********************************//
 // Function   : linearizeOutput 
 // 
-// Description: Linearize raw joystick readings
+// Description: Linearize the output magnitude by applying the acceleration response curve
+//              ( JOY_INPUT_XY_MAX * (magnitude / JOY_INPUT_XY_MAX) ^ _accelerationExponent )
 // 
-// Arguments :  inputPoint : pointIntType : Input points 
+// Arguments :  inputMagnitude : float : Magnitude after deadzone (0 to JOY_INPUT_XY_MAX)
 // 
-// Return     : outputPoint : pointIntType : Output with linearization and speed control applied
+// Return     : outputMagnitude : float : Magnitude with response curve applied (0 to JOY_INPUT_XY_MAX)
 //*********************************//
-pointIntType LSJoystick::linearizeOutput(pointIntType inputPoint){                              
+float LSJoystick::linearizeOutput(float inputMagnitude){                              
   
-  // Linearize the input joystick values 
-  pointIntType linearizedPoint = {0,0};
+  float outputMagnitude = inputMagnitude;
 
-  linearizedPoint = inputPoint; //TODO 2025-Mar-07 Replace with linearization 
+  if (_accelerationExponent != 1.0 && inputMagnitude > 0.0) {
+    outputMagnitude = JOY_INPUT_XY_MAX * pow(inputMagnitude / JOY_INPUT_XY_MAX, _accelerationExponent);
+  }
     
-  return linearizedPoint;  
+  return outputMagnitude;  
 }
 
 //*********************************//
 // Function   : scaleOutput 
 // 
-// Description: Scales output value to CONF_JOY_OUTPUT_XY_MAX
+// Description: Scales output magnitude to CONF_JOY_OUTPUT_XY_MAX
 // 
-// Arguments :  inputPoint : pointIntType : Output without linearization
-//              inputPointMagnitude : float : Magnitude of input point
-//              inputPointAngle : float : Angle of input point
+// Arguments :  inputMagnitude : float : Magnitude of deadzoned point (0 to JOY_INPUT_XY_MAX)
 // 
-// Return     : outputPoint : pointIntType : Scaled output point
+// Return     : outputMagnitude : float : Scaled output magnitude
 //*********************************//
-pointIntType LSJoystick::scaleOutput(pointIntType inputPoint, float inputMagnitude, float inputAngle){                              
+float LSJoystick::scaleOutput(float inputMagnitude){                              
   
-  pointIntType outputPoint = {0,0};  // Initialize outputPoint
-
   // Map input magnitude (between 0 and 1024) to output magnitudes (between 0 and _rangeValue)
   float outputMagnitude = mapIntToFloat(inputMagnitude, 0, JOY_INPUT_XY_MAX, 0, CONF_JOY_OUTPUT_XY_MAX);
   outputMagnitude = constrain(outputMagnitude, 0, CONF_JOY_OUTPUT_XY_MAX);
-
-  outputPoint = pointIntFromMagnitudeAngle(outputMagnitude,inputAngle);
    
-  return outputPoint;  
+  return outputMagnitude;  
 }
 
 //*********************************//
 // Function   : processInputReading 
 // 
-// Description: Process input value and map the readings
+// Description: Process input value and map the readings.
+//              With a range map (see endRangeSweep) the centered reading is scaled by the range in its direction,
+//              looked up and interpolated from the map, so the edge of the range reaches full output in every direction.
+//              Otherwise it is mapped with the 2x2 transform of its calibration sector (see setSectorTransform),
+//              so every calibrated corner reaches full output. Readings beyond the range or corners are scaled back onto the
+//              output circle. Without either the reading is scaled by _inputRadius instead.
 // 
 // Arguments :  inputPoint : pointFloatType : Raw magnet input reading
 // 
@@ -829,36 +2529,44 @@ pointIntType LSJoystick::scaleOutput(pointIntType inputPoint, float inputMagnitu
 //*********************************//
 pointIntType LSJoystick::processInputReading(pointFloatType inputPoint) {
 
-  // Initialize limitPoint, centeredPoint and outputPoint
-  pointFloatType limitPoint = {0.00, 0.00};
+  // Initialize centeredPoint and outputPoint
   pointFloatType centeredPoint = {0.00, 0.00};
+  pointFloatType mappedPoint = {0.00, 0.00};
   pointIntType outputPoint = {0,0};
-  pointFloatType center = _magnetInputCalibration[0];  // Center / neutral point reading of joystick from calibration
+  pointFloatType center = getCompensatedCenter();      // Center / neutral point reading of joystick from calibration, corrected for temperature
+
+  if (_inputRadius <= 0.0) {                            // Not calibrated
+    return outputPoint;
+  }
   
   if ((sq(inputPoint.x) + sq(inputPoint.y)) >= sq(JOY_INPUT_DEADZONE)) {  //  TODO 2025-Mar-07 Look at this constant / fixed input deadzone
     // Center the input point
-    centeredPoint = {(inputPoint.x - center.x) * _joystickXDirection, 
-                     (inputPoint.y - center.y) * _joystickYDirection};
+    centeredPoint = {inputPoint.x - center.x, inputPoint.y - center.y};
   }
 
-  float thetaVal = atan2(centeredPoint.y, centeredPoint.x);         // Get the angle of the point
-
-  // Find the limiting point on perimeter of circle
-  limitPoint.x = sgn(centeredPoint.x) * abs(cos(thetaVal) * _inputRadius);
-  limitPoint.y = sgn(centeredPoint.y) * abs(sin(thetaVal) * _inputRadius);
+  int sector = _rangeMapValid ? -1 : findSector(centeredPoint.x, centeredPoint.y);
+  if (_rangeMapValid) {
+    float inputScale = getRangeScale(centeredPoint.x, centeredPoint.y);
+    mappedPoint = {centeredPoint.x * inputScale, centeredPoint.y * inputScale};
+  } else if (sector >= 0) {
+    const float* transform = _sectorTransform[sector];
+    mappedPoint.x = transform[0] * centeredPoint.x + transform[1] * centeredPoint.y;
+    mappedPoint.y = transform[2] * centeredPoint.x + transform[3] * centeredPoint.y;
+  } else {
+    float inputScale = JOY_INPUT_XY_MAX / _inputRadius;
+    mappedPoint = {centeredPoint.x * inputScale, centeredPoint.y * inputScale};
+  }
 
-  // Compare the magnitude of two points from center
   // Output point on perimeter of circle if it's outside
-  if ((sq(centeredPoint.x) + sq(centeredPoint.y)) >= sq(_inputRadius)) {
-    centeredPoint.x = limitPoint.x; 
-    centeredPoint.y = limitPoint.y; 
-//    Serial.print(centeredPoint.x);  
-//    Serial.print(",");  
-//    Serial.println(centeredPoint.y); 
-  }
-    // Scale the centered point to int ( -1024 to 1024 )
-    outputPoint.x = mapFloatInt(centeredPoint.x, -1*_inputRadius, _inputRadius, -1*JOY_INPUT_XY_MAX, JOY_INPUT_XY_MAX);
-    outputPoint.y = mapFloatInt(centeredPoint.y, -1*_inputRadius, _inputRadius, -1*JOY_INPUT_XY_MAX, JOY_INPUT_XY_MAX);
+  float mappedMagnitude = sqrt(sq(mappedPoint.x) + sq(mappedPoint.y));
+  if (mappedMagnitude > JOY_INPUT_XY_MAX) {
+    mappedPoint.x = mappedPoint.x * JOY_INPUT_XY_MAX / mappedMagnitude;
+    mappedPoint.y = mappedPoint.y * JOY_INPUT_XY_MAX / mappedMagnitude;
+  }
+
+  // Scale to int ( -1024 to 1024 ) in joystick directions
+  outputPoint.x = (int)round(mappedPoint.x) * _joystickXDirection;
+  outputPoint.y = (int)round(mappedPoint.y) * _joystickYDirection;
  
   return outputPoint;
 }
@@ -867,7 +2575,10 @@ pointIntType LSJoystick::processInputReading(pointFloatType inputPoint) {
 //*********************************//
 // Function   : processOutputResponse 
 // 
-// Description: Process output value by applying Deadzone and linearization
+// Description: Process output value by applying Deadzone and linearization.
+//              The deadzone, response curve and scaling only change the magnitude of the point, so the 
+//              output magnitude is looked up in _responseTable and applied as a single scale factor on 
+//              the x and y components.
 // 
 // Arguments :  inputPoint : pointIntType : Output before applying Deadzone and linearization
 // 
@@ -875,26 +2586,277 @@ pointIntType LSJoystick::processInputReading(pointFloatType inputPoint) {
 //*********************************//
 pointIntType LSJoystick::processOutputResponse(pointIntType inputPoint){
   
-  // Initialize outputPoint and deadzonedPoint
-  pointIntType outputPoint, deadzonedPoint, linearizedPoint = {0,0};
+  // Initialize outputPoint
+  pointIntType outputPoint = {0,0};
 
-  // Apply linearization
-  linearizedPoint = linearizeOutput(inputPoint);
+  float inputMagnitude = magnitudePoint(inputPoint);
+  if (inputMagnitude <= 0.0) {
+    return outputPoint;
+  }
 
-  float linearizedPointMagnitude = magnitudePoint(linearizedPoint);
-  float inputAngle = atan2(linearizedPoint.y, linearizedPoint.x); 
-  
-  // Apply Deadzone
-  deadzonedPoint = applyRadialDeadzone(linearizedPoint, linearizedPointMagnitude, inputAngle);
-  float deadzonedPointMagnitude = magnitudePoint(deadzonedPoint);
+  // Apply Deadzone, linearization and Scaling to output device range
+  float outputScale = getResponseMagnitude(inputMagnitude) / inputMagnitude;
 
-  // Apply Scaling to output device range
-  outputPoint = scaleOutput(deadzonedPoint, deadzonedPointMagnitude, inputAngle);
-  
+  outputPoint.x = round(inputPoint.x * outputScale);
+  outputPoint.y = round(inputPoint.y * outputScale);
+
+  return outputPoint;
+}
+
+//*********************************//
+// Function   : updateResponseTable 
+// 
+// Description: Rebuild _responseTable by applying the radial deadzone, the response curve and the 
+//              output scaling to every input magnitude from 0 to JOY_INPUT_XY_MAX.
+//              Called when the deadzone or acceleration level is changed.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSJoystick::updateResponseTable(){
+  float outputMagnitude;
+
+  for (int inputMagnitude = 0; inputMagnitude < JOY_RESPONSE_TABLE_SIZE; inputMagnitude++) {
+    outputMagnitude = scaleOutput(linearizeOutput(applyRadialDeadzone(inputMagnitude)));
+    _responseTable[inputMagnitude] = (int32_t)round(outputMagnitude * JOY_FIXED_POINT_ONE);
+  }
+}
+
+//*********************************//
+// Function   : getResponseMagnitude 
+// 
+// Description: Get the output magnitude of an input magnitude from _responseTable.
+//              The table has one entry per input count and the magnitude is truncated to whole counts
+//              the same way the deadzone mapping does, so no interpolation is needed.
+// 
+// Arguments :  inputMagnitude : float : Magnitude of input point
+// 
+// Return     : outputMagnitude : float : Output magnitude (0 to CONF_JOY_OUTPUT_XY_MAX)
+//*********************************//
+float LSJoystick::getResponseMagnitude(float inputMagnitude){
+  int tableIndex = min((int)inputMagnitude, JOY_RESPONSE_TABLE_SIZE - 1);
+
+  return (float)_responseTable[tableIndex] / JOY_FIXED_POINT_ONE;
+}
+
+//*********************************//
+// Function   : processInputReadingFixed 
+// 
+// Description: Fixed-point version of processInputReading using only 32 bit integer math (no 64 bit division
+//              or square root). The centered reading is converted to Q12, with fewer fractional bits for readings
+//              that don't fit in 16 bits, and mapped with the range map scale, sector transform or input radius scale,
+//              each stored with as many fractional bits as fit in 16 bits.
+//              The mapped point is kept in Q4 output counts. Points far outside the output circle lose low bits
+//              until their magnitude fits in 32 bits (their direction is kept), then points outside the circle
+//              are scaled back onto it. The result matches processInputReading within +/-1.
+// 
+// Arguments :  inputPoint : pointFloatType : Raw magnet input reading
+// 
+// Return     : outputPoint : pointIntType : Output with mapped reading
+//*********************************//
+pointIntType LSJoystick::processInputReadingFixed(pointFloatType inputPoint) {
+
+  pointIntType outputPoint = {0,0};
+  pointFloatType center = getCompensatedCenter();      // Center / neutral point reading of joystick from calibration, corrected for temperature
+
+  if (_inputScaleFixed <= 0) {                          // Not calibrated
+    return outputPoint;
+  }
+
+  // Center the input point and convert it to Q12. The deadzone test is the one processInputReading uses,
+  // since rounding the reading first would move the edge of the deadzone.
+  int32_t centeredX = 0;
+  int32_t centeredY = 0;
+  if ((sq(inputPoint.x) + sq(inputPoint.y)) >= sq(JOY_INPUT_DEADZONE)) {
+    centeredX = toFixed(inputPoint.x - center.x, JOY_FIXED_INPUT_SHIFT, JOY_FIXED_INPUT_LIMIT);
+    centeredY = toFixed(inputPoint.y - center.y, JOY_FIXED_INPUT_SHIFT, JOY_FIXED_INPUT_LIMIT);
+  }
+
+  // Drop fractional bits of large readings so both components fit in 16 bits (block floating point)
+  int inputShift = JOY_FIXED_INPUT_SHIFT;
+  uint32_t centeredMax = max(abs(centeredX), abs(centeredY));
+  if (centeredMax > JOY_FIXED_VALUE_MAX) {
+    int extraBits = (32 - __builtin_clz(centeredMax)) - 15;             // Bits above the 15 that fit
+    centeredX = shiftRoundInt(centeredX, extraBits);
+    centeredY = shiftRoundInt(centeredY, extraBits);
+    inputShift -= extraBits;
+  }
+
+  // Map to output counts with inputShift + mapShift fractional bits
+  int32_t mappedX;
+  int32_t mappedY;
+  int mapShift;
+  int sector = _rangeMapValid ? -1 : findSectorFixed(centeredX, centeredY);
+  if (_rangeMapValid) {
+    int32_t inputScale = getRangeScaleFixed(centeredX, centeredY);
+    mappedX = inputScale * centeredX;
+    mappedY = inputScale * centeredY;
+    mapShift = _rangeShiftFixed;
+  } else if (sector >= 0) {
+    const int32_t* transform = _sectorTransformFixed[sector];
+    mappedX = transform[0] * centeredX + transform[1] * centeredY;
+    mappedY = transform[2] * centeredX + transform[3] * centeredY;
+    mapShift = _sectorShiftFixed;
+  } else {
+    mappedX = _inputScaleFixed * centeredX;
+    mappedY = _inputScaleFixed * centeredY;
+    mapShift = _inputScaleShiftFixed;
+  }
+
+  // Convert to Q4 output counts
+  mappedX = shiftRoundInt(mappedX, inputShift + mapShift - JOY_FIXED_MAPPED_SHIFT);
+  mappedY = shiftRoundInt(mappedY, inputShift + mapShift - JOY_FIXED_MAPPED_SHIFT);
+
+  // Keep both components within 16 bits so the squared magnitude fits in 32 bits.
+  // A component above JOY_FIXED_VALUE_MAX is over 2048 counts, so the point stays outside the output circle.
+  while (abs(mappedX) > JOY_FIXED_VALUE_MAX || abs(mappedY) > JOY_FIXED_VALUE_MAX) {
+    mappedX /= 2;
+    mappedY /= 2;
+  }
+
+  // Output point on perimeter of circle if it's outside by dividing by its magnitude instead of the output range
+  int32_t mappedMagnitude = sqrtInt((uint32_t)(mappedX * mappedX) + (uint32_t)(mappedY * mappedY));
+  int32_t scaleDivisor = max(mappedMagnitude, (int32_t)(JOY_INPUT_XY_MAX << JOY_FIXED_MAPPED_SHIFT));
+
+  // Scale the mapped point to int ( -1024 to 1024 ) in joystick directions
+  outputPoint.x = divRoundInt(mappedX * JOY_INPUT_XY_MAX, scaleDivisor) * _joystickXDirection;
+  outputPoint.y = divRoundInt(mappedY * JOY_INPUT_XY_MAX, scaleDivisor) * _joystickYDirection;
+
+  return outputPoint;
+}
+
+//*********************************//
+// Function   : processOutputResponseFixed 
+// 
+// Description: Fixed-point version of processOutputResponse using only 32 bit integer math. The magnitude is
+//              calculated in Q5 with an integer square root, the output magnitude is read from _responseTable
+//              in Q10 and applied as a ratio of magnitudes on the x and y components, so no float math is needed.
+// 
+// Arguments :  inputPoint : pointIntType : Output before applying Deadzone and linearization (-1024 to 1024)
+// 
+// Return     : outputPoint : pointIntType : Processed Output with mapped reading
+//*********************************//
+pointIntType LSJoystick::processOutputResponseFixed(pointIntType inputPoint){
+
+  pointIntType outputPoint = {0,0};
+
+  uint32_t magnitudeSquared = (uint32_t)(inputPoint.x * inputPoint.x + inputPoint.y * inputPoint.y);
+  int32_t magnitudeFixed = sqrtInt(magnitudeSquared << (2 * JOY_FIXED_MAGNITUDE_SHIFT));  // Magnitude in fixed-point (Q5)
+
+  if (magnitudeFixed == 0) {
+    return outputPoint;
+  }
+
+  // Get the output magnitude from _responseTable in Q10
+  int32_t tableIndex = min(magnitudeFixed >> JOY_FIXED_MAGNITUDE_SHIFT, (int32_t)(JOY_RESPONSE_TABLE_SIZE - 1));
+  int32_t outputMagnitude = shiftRoundInt(_responseTable[tableIndex], JOY_FIXED_POINT_SHIFT - JOY_FIXED_RESPONSE_SHIFT);
+
+  // Apply Deadzone, linearization and Scaling to output device range: x * output / magnitude
+  int32_t scaleDivisor = magnitudeFixed << (JOY_FIXED_RESPONSE_SHIFT - JOY_FIXED_MAGNITUDE_SHIFT);
+  outputPoint.x = divRoundInt(inputPoint.x * outputMagnitude, scaleDivisor);
+  outputPoint.y = divRoundInt(inputPoint.y * outputMagnitude, scaleDivisor);
 
   return outputPoint;
 }
 
+//*********************************//
+// Function   : sqrtInt 
+// 
+// Description: Integer square root using the bitwise (digit-by-digit) method.
+// 
+// Arguments :  input : uint32_t : input value
+// 
+// Return     : output : uint32_t : Square root of input rounded down
+//*********************************//
+uint32_t LSJoystick::sqrtInt(uint32_t input) {
+  uint32_t output = 0;
+  uint32_t bit = 1UL << 30;             // The highest power of four <= input
+
+  while (bit > input) {
+    bit >>= 2;
+  }
+
+  while (bit != 0) {
+    if (input >= output + bit) {
+      input -= output + bit;
+      output = (output >> 1) + bit;
+    } else {
+      output >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return output;
+}
+
+//*********************************//
+// Function   : divRoundInt 
+// 
+// Description: Integer division rounded half away from zero (same rounding as round())
+// 
+// Arguments :  numerator   : int32_t : numerator
+//              denominator : int32_t : denominator (greater than zero)
+// 
+// Return     : output : int32_t : Rounded quotient
+//*********************************//
+int32_t LSJoystick::divRoundInt(int32_t numerator, int32_t denominator) {
+  if (numerator >= 0) {
+    return (numerator + denominator / 2) / denominator;
+  }
+  return -((-numerator + denominator / 2) / denominator);
+}
+
+//*********************************//
+// Function   : shiftRoundInt 
+// 
+// Description: Divide by a power of two with an arithmetic shift, rounded to nearest
+// 
+// Arguments :  input : int32_t : input value
+//              shift : int     : number of bits to shift right (0 to 30)
+// 
+// Return     : output : int32_t : input / 2^shift rounded
+//*********************************//
+int32_t LSJoystick::shiftRoundInt(int32_t input, int shift) {
+  if (shift <= 0) {
+    return input;
+  }
+  return (input + (1L << (shift - 1))) >> shift;
+}
+
+//*********************************//
+// Function   : getFixedShift 
+// 
+// Description: Get the number of fractional bits (at most JOY_FIXED_POINT_SHIFT) that keep a factor of up to
+//              valueMax within JOY_FIXED_VALUE_MAX. Used when a calibration is loaded, never per reading.
+// 
+// Arguments :  valueMax : float : Largest absolute value that will be converted
+// 
+// Return     : shift : int : Number of fractional bits
+//*********************************//
+int LSJoystick::getFixedShift(float valueMax) {
+  int shift = 0;
+  while (shift < JOY_FIXED_POINT_SHIFT && valueMax * (1L << (shift + 1)) <= JOY_FIXED_VALUE_MAX) {
+    shift++;
+  }
+  return shift;
+}
+
+//*********************************//
+// Function   : toFixed 
+// 
+// Description: Convert a value to fixed-point, rounded to nearest and limited to +/-valueMax
+// 
+// Arguments :  value    : float   : input value
+//              shift    : int     : number of fractional bits
+//              valueMax : int32_t : largest absolute result
+// 
+// Return     : output : int32_t : value * 2^shift
+//*********************************//
+int32_t LSJoystick::toFixed(float value, int shift, int32_t valueMax) {
+  float scaledValue = constrain(value * (1L << shift), -valueMax, valueMax);
+  return (int32_t)(scaledValue + ((scaledValue >= 0.0) ? 0.5 : -0.5));
+}
 
 //*********************************//
 // Function   : mapFloatInt 
@@ -28,6 +28,89 @@ using namespace Adafruit_LittleFS_Namespace;
 
 #define BUFFER_SIZE  512
 
+#define MEM_FLUSH_DELAY 2000                      // Quiet period in ms after the last settings change before it is written to flash
+
+#define MEM_TEMP_FILE_SUFFIX ".tmp"               // Files are written here first, then renamed over the original in one atomic step
+#define MEM_JOURNAL_FILE_SUFFIX ".log"            // Append-only journal of settings changes made since the last record write
+#define MEM_JOURNAL_COMPACT_SIZE 1024             // Journal size in bytes after which it is folded into a new settings record
+
+#define MEM_RECORD_MAGIC 0x534C4C57               // "WLLS" - identifies a binary settings record
+#define MEM_RECORD_VERSION 3                      // Increment when settingsStruct changes. Only append new fields.
+
+#define MEM_RECORD_OK 0                           // Settings record was read and verified
+#define MEM_RECORD_CREATED 1                      // No settings found, record was created from defaults
+#define MEM_RECORD_MIGRATED 2                     // Record was created from the legacy json settings file
+#define MEM_RECORD_UPGRADED 3                     // Record from an older schema version was extended with defaults
+#define MEM_RECORD_CORRUPT 4                      // Record failed verification and was replaced with defaults
+
+// Settings record header structure ( Stored in front of settingsStruct, followed by a CRC32 of header and settings )
+typedef struct
+{
+  uint32_t recordMagic;
+  uint16_t recordVersion;
+  uint16_t recordLength;                          // Size of the stored settingsStruct in bytes
+} settingsRecordHeaderStruct;
+
+// Settings journal entry structure ( Followed by the new value of the key and a CRC32 of entry and value )
+typedef struct
+{
+  uint8_t entryKey;                               // Index of the key in settingKeyProperty
+  uint8_t entryLength;                            // Size of the value in bytes
+} settingsJournalEntryStruct;
+
+#define MEM_SETTING_TYPE_INT 0
+#define MEM_SETTING_TYPE_FLOAT 1
+#define MEM_SETTING_TYPE_STRING 2
+#define MEM_SETTING_TYPE_POINT 3
+#define MEM_SETTING_TYPE_BYTES 4                  // Fixed length byte array, stored in json as a hex string
+
+// Settings key structure ( Maps a settings file key to its field in settingsStruct )
+typedef struct
+{
+  const char* settingKey;
+  uint8_t settingType;
+  uint16_t settingOffset;
+  uint16_t settingLength;                         // Size of MEM_SETTING_TYPE_BYTES values
+} settingKeyStruct;
+
+// Journal entries refer to keys by their index, so only append new keys to the end
+const settingKeyStruct settingKeyProperty[] = {
+  {"MN",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, modelNumber)},
+  {"VN1", MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, versionMajor)},
+  {"VN2", MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, versionMinor)},
+  {"VN3", MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, versionRevision)},
+  {"ID",  MEM_SETTING_TYPE_STRING, offsetof(settingsStruct, deviceID)},
+  {"OM",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, operatingMode)},
+  {"CM",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, communicationMode)},
+  {"SS",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, cursorSpeedLevel)},
+  {"SL",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, scrollLevel)},
+  {"PM",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, pressureMode)},
+  {"ST",  MEM_SETTING_TYPE_FLOAT,  offsetof(settingsStruct, sipThreshold)},
+  {"PT",  MEM_SETTING_TYPE_FLOAT,  offsetof(settingsStruct, puffThreshold)},
+  {"AV",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, accelerationLevel)},
+  {"IZ",  MEM_SETTING_TYPE_FLOAT,  offsetof(settingsStruct, innerDeadzone)},
+  {"OZ",  MEM_SETTING_TYPE_FLOAT,  offsetof(settingsStruct, outerDeadzone)},
+  {"CA0", MEM_SETTING_TYPE_POINT,  offsetof(settingsStruct, calibration) + 0 * sizeof(pointFloatType)},
+  {"CA1", MEM_SETTING_TYPE_POINT,  offsetof(settingsStruct, calibration) + 1 * sizeof(pointFloatType)},
+  {"CA2", MEM_SETTING_TYPE_POINT,  offsetof(settingsStruct, calibration) + 2 * sizeof(pointFloatType)},
+  {"CA3", MEM_SETTING_TYPE_POINT,  offsetof(settingsStruct, calibration) + 3 * sizeof(pointFloatType)},
+  {"CA4", MEM_SETTING_TYPE_POINT,  offsetof(settingsStruct, calibration) + 4 * sizeof(pointFloatType)},
+  {"SM",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, soundMode)},
+  {"LM",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, lightMode)},
+  {"LL",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, lightBrightnessLevel)},
+  {"DM",  MEM_SETTING_TYPE_INT,    offsetof(settingsStruct, debugMode)},
+  {"FC",  MEM_SETTING_TYPE_FLOAT,  offsetof(settingsStruct, filterCutoff)},
+  {"FB",  MEM_SETTING_TYPE_FLOAT,  offsetof(settingsStruct, filterBeta)},
+  {"CR",  MEM_SETTING_TYPE_BYTES,  offsetof(settingsStruct, rangeMap), sizeof(settingsStruct::rangeMap)}
+};
+
+#define MEM_SETTING_KEY_NUMBER (sizeof(settingKeyProperty) / sizeof(settingKeyProperty[0]))
+#define MEM_SETTING_KEY_ALL ((uint32_t)((1ULL << MEM_SETTING_KEY_NUMBER) - 1))
+
+static_assert(MEM_SETTING_KEY_NUMBER <= 32, "Settings dirty flags are stored in a uint32_t");
+static_assert(sizeof(settingsStruct::rangeMap) <= 255, "Journal entries store the value size in a uint8_t");
+static_assert(sizeof(settingsStruct::rangeMap) >= sizeof(settingsStruct::deviceID), "The journal replay buffer is sized for the largest value");
+
 JsonDocument doc;
 
 // Initialize FileSystem
@@ -37,21 +120,49 @@ class LSMemory {
   public:
     LSMemory();   
     void begin();                                                   
-    void initialize(String fileString, String jsonString);   
+    void initialize(String fileString, String jsonString, String legacyFileString);   
     void clear(String fileString);
     void format();
-    String readAll(String fileString);
-    void writeAll(String fileString, String jsonString);
-    JsonObject readObject(String fileString);
-    int readInt(String fileString, String key);
-    float readFloat(String fileString, String key);
-    String readString(String fileString, String key);
-    pointFloatType readPoint(String fileString, String key);
-    void writeObject(String fileString, String key, JsonObject obj);
-    void writeInt(String fileString, String key, int value);
-    void writeFloat(String fileString, String key, float value);
-    void writeString(String fileString, String key, String value);
-    void writePoint(String fileString, String key, pointFloatType value);
+    size_t readAll(const char* fileString, char* buffer, size_t length);
+    bool writeAll(String fileString, String jsonString);
+    JsonObject readObject(const char* fileString);
+    int readInt(const char* fileString, const char* key);
+    float readFloat(const char* fileString, const char* key);
+    void readString(const char* fileString, const char* key, char* value, size_t length);
+    pointFloatType readPoint(const char* fileString, const char* key);
+    void readBytes(const char* fileString, const char* key, uint8_t* value, size_t length);
+    void writeObject(const char* fileString, const char* key, JsonObject obj);
+    void writeInt(const char* fileString, const char* key, int value);
+    void writeFloat(const char* fileString, const char* key, float value);
+    void writeString(const char* fileString, const char* key, const char* value);
+    void writePoint(const char* fileString, const char* key, pointFloatType value);
+    void writeBytes(const char* fileString, const char* key, const uint8_t* value, size_t length);
+    void update();
+    void commit();
+    bool isDirty();
+    int getRecordStatus();
+  private:
+    int readRecord(String fileString);
+    bool writeRecord(String fileString);
+    bool appendJournal(String fileString, uint32_t keyMask);
+    bool replayJournal(String fileString);
+    bool compact();
+    bool switchFile(String tempFileString, String fileString);
+    size_t settingSize(const settingKeyStruct* setting);
+    void settingsFromJson(JsonObject obj);
+    void settingsToJson(JsonObject obj);
+    uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc);
+    String bytesToHex(const uint8_t* data, size_t length);
+    void hexToBytes(const char* hexString, uint8_t* data, size_t length);
+    const settingKeyStruct* findSettingKey(const char* fileString, const char* key);
+    void markDirty(uint32_t keyMask);
+    settingsStruct _settings;                     // RAM copy of the cached settings file
+    String _cacheFileString;                      // Name of the cached settings file
+    bool _cacheLoaded;
+    uint32_t _dirtyKeys;                          // One bit per settingKeyProperty entry with an unsaved change
+    size_t _journalSize;                          // Size of the settings journal in bytes
+    unsigned long _cacheChangeTime;               // Time of the last unsaved settings change in ms
+    int _recordStatus;                            // Result of reading the settings record at initialization
 };
 
 
@@ -65,7 +176,11 @@ class LSMemory {
 // Return     : void
 //*********************************//
 LSMemory::LSMemory() {
-
+  _cacheLoaded = false;
+  _dirtyKeys = 0;
+  _journalSize = 0;
+  _cacheChangeTime = 0;
+  _recordStatus = MEM_RECORD_OK;
 }
 
 //*********************************//
@@ -85,37 +200,45 @@ void LSMemory::begin() {
 //*********************************//
 // Function   : initialize 
 // 
-// Description: Initializes memory file.
+// Description: Loads the binary settings record into RAM and replays the journal of later changes. 
+//              If there is no valid record, it is created from the default json string, 
+//              overlaid with the legacy json settings file if one exists.
+//              The legacy file is removed once it has been migrated.
 // 
-// Arguments :  fileString : String : the name of the file
+// Arguments :  fileString : String : the name of the settings record file
 //              jsonString : String : the default json string with list of key and value pairs 
+//              legacyFileString : String : the name of the legacy json settings file
 // 
 // Return     : void
 //*********************************//
-void LSMemory::initialize(String fileString, String jsonString) {
-  const char* fileName = fileString.c_str();
+void LSMemory::initialize(String fileString, String jsonString, String legacyFileString) {
+  _cacheFileString = fileString;
+  _cacheLoaded = false;
+  _dirtyKeys = 0;
 
-  file.open(fileName, FILE_O_READ);
-  if ( file )
-  {
-    uint32_t readlen;
-    char buffer[BUFFER_SIZE] = { 0 };
-    readlen = file.read(buffer, sizeof(buffer));
+  memset(&_settings, 0, sizeof(_settings));       // Start from defaults so fields missing from older records or files are valid
+  deserializeJson(doc, jsonString);
+  settingsFromJson(doc.as<JsonObject>());
 
-    delay(5);
-    buffer[readlen] = 0;
-    file.close();
-    delay(5);
-  } else
-  {
-    if( file.open(fileName, FILE_O_WRITE) )
-    {
-      const char* jsonChar = jsonString.c_str();
-      file.write(jsonChar, strlen(jsonChar));
-      delay(1);
-      file.close();
-      delay(1);
+  InternalFS.remove((fileString + MEM_TEMP_FILE_SUFFIX).c_str());  // Left over from a write interrupted before its switch-over
+
+  _recordStatus = readRecord(fileString);
+  bool journalValid = replayJournal(fileString);
+  _cacheLoaded = true;
+  if (_recordStatus == MEM_RECORD_OK) {
+    if (!journalValid) {
+      compact();                                  // Drop the torn tail of an interrupted journal write
     }
+    return;
+  }
+
+  if (_recordStatus == MEM_RECORD_CREATED && InternalFS.exists(legacyFileString.c_str())) {
+    settingsFromJson(readObject(legacyFileString.c_str()));
+    _recordStatus = MEM_RECORD_MIGRATED;
+  }
+
+  if (compact() && _recordStatus == MEM_RECORD_MIGRATED) {
+    InternalFS.remove(legacyFileString.c_str());
   }
 }
 
@@ -130,6 +253,12 @@ void LSMemory::initialize(String fileString, String jsonString) {
 // Return     : void
 //*********************************//
 void LSMemory::clear(String fileString) {
+  if (_cacheLoaded && fileString == _cacheFileString) {
+    _cacheLoaded = false;                         // Pending changes are discarded with the file
+    _dirtyKeys = 0;
+    _journalSize = 0;
+    InternalFS.remove((fileString + MEM_JOURNAL_FILE_SUFFIX).c_str());
+  }
   const char* fileName = fileString.c_str();
   InternalFS.remove(fileName);
   file.close();
@@ -147,6 +276,9 @@ void LSMemory::clear(String fileString) {
 // Return     : void
 //*********************************//
 void LSMemory::format(){
+  _cacheLoaded = false;                           // Pending changes are discarded with the file system
+  _dirtyKeys = 0;
+  _journalSize = 0;
   InternalFS.format();
   delay(1);
 }
@@ -155,75 +287,101 @@ void LSMemory::format(){
 //*********************************//
 // Function   : readAll 
 // 
-// Description: Reads all Json data from the settings file and stores it in a buffer
+// Description: Reads all Json data from the settings file into a buffer.
+//              The settings record is exported as Json. Data that doesn't fit the buffer is cut off.
 // 
-// Arguments :  fileString : String : the name of the file
+// Arguments :  fileString : const char* : the name of the file
+//              buffer : char* : destination of the null terminated Json string
+//              length : size_t : size of the buffer in bytes
 // 
-// Return     : buffer : String array : Output from file
+// Return     : jsonLength : size_t : Length of the full Json string, larger than length - 1 if it was cut off
 //*********************************//
-String LSMemory::readAll(String fileString){
-  const char* fileName = fileString.c_str();
+size_t LSMemory::readAll(const char* fileString, char* buffer, size_t length){
+  if (length == 0) {
+    return 0;
+  }
+  if (_cacheLoaded && _cacheFileString == fileString) {
+    JsonObject obj = readObject(fileString);
+    serializeJson(obj, buffer, length);           // Export the settings record as json
+    return measureJson(obj);
+  }
 
-  file.open(fileName, FILE_O_READ);
-  uint32_t readlen;
-  char buffer[BUFFER_SIZE] = { 0 };
-  readlen = file.read(buffer, sizeof(buffer));
+  buffer[0] = 0;
+  if (!file.open(fileString, FILE_O_READ)) {
+    return 0;
+  }
+  size_t jsonLength = file.size();
+  uint32_t readlen = file.read(buffer, length - 1);
 
   delay(1);
   buffer[readlen] = 0;
   file.close();
   delay(1);
-  return buffer;
+  return jsonLength;
 }
 
 
 //*********************************//
 // Function   : writeAll 
 // 
-// Description: Replaces the entire settings file with new values
+// Description: Replaces the entire settings file with new values.
+//              The file is written in full before it replaces the old one, so a power loss keeps either version.
+//              For the settings record, the keys in the Json string are imported and written immediately.
 // 
 // Arguments :  fileString : String : the name of the file
 //              jsonString : String : a json string with list of key and value pairs 
 // 
-// Return     : void
+// Return     : success : bool : False if the Json string could not be imported
 //*********************************//
-void LSMemory::writeAll(String fileString, String jsonString){
+bool LSMemory::writeAll(String fileString, String jsonString){
 
-    const char* fileName = fileString.c_str();
+    if (_cacheLoaded && fileString == _cacheFileString) {
+      if (deserializeJson(doc, jsonString) || !doc.is<JsonObject>()) {
+        return false;
+      }
+      settingsFromJson(doc.as<JsonObject>());
+      _dirtyKeys = 0;
+      return compact();                           // Every key may have changed, so write a new record rather than journal entries
+    }
 
+    String tempFileString = fileString + MEM_TEMP_FILE_SUFFIX;
     const char* jsonChar = jsonString.c_str();
     
-    InternalFS.remove(fileName);
-    delay(1);
-    
-    file.open(fileName, FILE_O_WRITE);
-    delay(1);
-    
+    InternalFS.remove(tempFileString.c_str());
+    if (!file.open(tempFileString.c_str(), FILE_O_WRITE)) {
+      return false;
+    }
     file.write(jsonChar, strlen(jsonChar));
-    delay(1);
     file.close();
-
+    return switchFile(tempFileString, fileString);
 }
 
 
 //*********************************//
 // Function   : readObject 
 // 
-// Description: Reads the settings file and returns it as a Json Object
+// Description: Reads the settings file and returns it as a Json Object.
+//              The settings record is returned as a Json Object of its keys.
 // 
-// Arguments :  fileString : String : the name of the file
+// Arguments :  fileString : const char* : the name of the file
 // 
 // Return     : obj : JsonObject : A Json Object of the file contents
 //*********************************//
-JsonObject LSMemory::readObject(String fileString){
+JsonObject LSMemory::readObject(const char* fileString){
   
-  uint32_t readLenght;
-  const char* fileName = fileString.c_str();
+  if (_cacheLoaded && _cacheFileString == fileString) {
+    doc.clear();
+    JsonObject obj = doc.to<JsonObject>();
+    settingsToJson(obj);                          // Json view of the settings record
+    return obj;
+  }
+
+  uint32_t readLenght = 0;
   char buffer[BUFFER_SIZE] = { 0 };
-  file.open(fileName, FILE_O_READ);
-  delay(1);
-  readLenght = file.read(buffer, sizeof(buffer));
-  delay(1);
+  if (file.open(fileString, FILE_O_READ)) {
+    readLenght = file.read(buffer, sizeof(buffer) - 1);
+    file.close();
+  }
   buffer[readLenght] = 0;
   deserializeJson(doc, String(buffer));
   JsonObject obj = doc.as<JsonObject>();
@@ -236,12 +394,19 @@ JsonObject LSMemory::readObject(String fileString){
 // 
 // Description: Returns the value of the corresponding key within the settings file.
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json value
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json value
 // 
 // Return     : value : int : The returned value corresponding to the key.
 //*********************************//
-int LSMemory::readInt(String fileString, String key){
+int LSMemory::readInt(const char* fileString, const char* key){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    const uint8_t* field = (const uint8_t*)&_settings + setting->settingOffset;
+    if (setting->settingType == MEM_SETTING_TYPE_INT) { return *(const int*)field; }
+    if (setting->settingType == MEM_SETTING_TYPE_FLOAT) { return (int)*(const float*)field; }
+    return 0;
+  }
   int value = readObject(fileString)[key];
   return value;
 }
@@ -252,11 +417,18 @@ int LSMemory::readInt(String fileString, String key){
 // 
 // Description: Returns the value of the corresponding key within the settings file.
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json value
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json value
 // 
 // Return     : value : float : The returned value corresponding to the key.
-float LSMemory::readFloat(String fileString, String key){
+float LSMemory::readFloat(const char* fileString, const char* key){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    const uint8_t* field = (const uint8_t*)&_settings + setting->settingOffset;
+    if (setting->settingType == MEM_SETTING_TYPE_FLOAT) { return *(const float*)field; }
+    if (setting->settingType == MEM_SETTING_TYPE_INT) { return (float)*(const int*)field; }
+    return 0.0;
+  }
   float value = readObject(fileString)[key];
   return value;
 }
@@ -265,15 +437,22 @@ float LSMemory::readFloat(String fileString, String key){
 //*********************************//
 // Function   : readString 
 // 
-// Description: Returns the value of the corresponding key within the settings file.
+// Description: Copies the string of the corresponding key within the settings file.
+//              A string longer than the buffer is cut off.
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json value
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json value
+//              value : char* : destination of the null terminated string
+//              length : size_t : size of the destination in bytes
 // 
-// Return     : value : string : The returned value corresponding to the key.
-String LSMemory::readString(String fileString, String key){
-  String value = readObject(fileString)[key];
-  return value;
+// Return     : void
+void LSMemory::readString(const char* fileString, const char* key, char* value, size_t length){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    strlcpy(value, (setting->settingType == MEM_SETTING_TYPE_STRING) ? (const char*)&_settings + setting->settingOffset : "", length);
+    return;
+  }
+  strlcpy(value, readObject(fileString)[key] | "", length);
 }
 
 //*********************************//
@@ -281,44 +460,67 @@ String LSMemory::readString(String fileString, String key){
 // 
 // Description: Returns the value of the corresponding key within the settings file.
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json value
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json value
 // 
 // Return     : value : point : The returned value corresponding to the key.
-pointFloatType LSMemory::readPoint(String fileString, String key){
+pointFloatType LSMemory::readPoint(const char* fileString, const char* key){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    if (setting->settingType == MEM_SETTING_TYPE_POINT) { return *(const pointFloatType*)((const uint8_t*)&_settings + setting->settingOffset); }
+    return {0.0, 0.0};
+  }
   JsonObject obj = readObject(fileString);
   return {obj[key][0], obj[key][1]};
 }
 
+//*********************************//
+// Function   : readBytes 
+// 
+// Description: Copies the byte array of the corresponding key within the settings file. 
+//              Bytes missing from the file are returned as zero.
+// 
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json value
+//              value : uint8_t* : destination of the bytes
+//              length : size_t : the number of bytes to copy
+// 
+// Return     : void
+void LSMemory::readBytes(const char* fileString, const char* key, uint8_t* value, size_t length){
+  memset(value, 0, length);
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    if (setting->settingType == MEM_SETTING_TYPE_BYTES) {
+      memcpy(value, (const uint8_t*)&_settings + setting->settingOffset, min(length, (size_t)setting->settingLength));
+    }
+    return;
+  }
+  hexToBytes(readObject(fileString)[key].as<const char*>(), value, length);
+}
+
 
 //*********************************//
 // Function   : writeObject 
 // 
 // Description: General function for writing an individual attribute-value pair to the settings file
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json attribute
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json attribute
 //              obj : JsonObject : the Json Object value
 // 
 // Return     : void
 //*********************************//
-void LSMemory::writeObject(String fileString, String key, JsonObject obj){
+void LSMemory::writeObject(const char* fileString, const char* key, JsonObject obj){
+
+    if (_cacheLoaded && _cacheFileString == fileString) {
+      settingsFromJson(obj);                      // Keys that are not part of the settings record are ignored
+      markDirty(MEM_SETTING_KEY_ALL);
+      return;
+    }
 
-    const char* fileName = fileString.c_str();
-    
     String jsonString;
     serializeJson(obj, jsonString);
-    const char* jsonChar = jsonString.c_str();
-    
-    InternalFS.remove(fileName);
-    delay(1);
-    
-    file.open(fileName, FILE_O_WRITE);
-    delay(1);
-    
-    file.write(jsonChar, strlen(jsonChar));
-    delay(1);
-    file.close();
+    writeAll(fileString, jsonString);
 }
 
 
@@ -327,15 +529,23 @@ void LSMemory::writeObject(String fileString, String key, JsonObject obj){
 // 
 // Description: Writing an individual int value to the corresponding attribute-value pair given by the key to the settings file
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json attribute
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json attribute
 //              value : int : The integer to write
 // 
 // Return     : void
 //*********************************//
-void LSMemory::writeInt(String fileString, String key, int value){
+void LSMemory::writeInt(const char* fileString, const char* key, int value){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    uint8_t* field = (uint8_t*)&_settings + setting->settingOffset;
+    if (setting->settingType == MEM_SETTING_TYPE_INT) { *(int*)field = value; }
+    else if (setting->settingType == MEM_SETTING_TYPE_FLOAT) { *(float*)field = (float)value; }
+    markDirty(1UL << (setting - settingKeyProperty));
+    return;
+  }
   JsonObject obj = readObject(fileString);
-  obj[String(key)] = value;
+  obj[key] = value;
   writeObject(fileString,key,obj);
 }
 
@@ -344,15 +554,23 @@ void LSMemory::writeInt(String fileString, String key, int value){
 // 
 // Description: Writing an individual float value to the corresponding attribute-value pair given by the key to the settings file
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json attribute
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json attribute
 //              value : float : The float value to write
 // 
 // Return     : void
 //*********************************//
-void LSMemory::writeFloat(String fileString, String key, float value){
+void LSMemory::writeFloat(const char* fileString, const char* key, float value){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    uint8_t* field = (uint8_t*)&_settings + setting->settingOffset;
+    if (setting->settingType == MEM_SETTING_TYPE_FLOAT) { *(float*)field = value; }
+    else if (setting->settingType == MEM_SETTING_TYPE_INT) { *(int*)field = (int)value; }
+    markDirty(1UL << (setting - settingKeyProperty));
+    return;
+  }
   JsonObject obj = readObject(fileString);
-  obj[String(key)] = value;
+  obj[key] = value;
   writeObject(fileString,key,obj);
 }
 
@@ -361,15 +579,23 @@ void LSMemory::writeFloat(String fileString, String key, float value){
 // 
 // Description: Writing an individual string value to the corresponding attribute-value pair given by the key to the settings file
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json attribute
-//              value : string : The string to write to the settings file
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json attribute
+//              value : const char* : The string to write to the settings file
 // 
 // Return     : void
 //*********************************//
-void LSMemory::writeString(String fileString, String key, String value){
+void LSMemory::writeString(const char* fileString, const char* key, const char* value){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    if (setting->settingType == MEM_SETTING_TYPE_STRING) {
+      strlcpy((char*)&_settings + setting->settingOffset, value, sizeof(_settings.deviceID));
+    }
+    markDirty(1UL << (setting - settingKeyProperty));
+    return;
+  }
   JsonObject obj = readObject(fileString);
-  obj[String(key)] = value;
+  obj[key] = value;
   writeObject(fileString,key,obj);
 }
 
@@ -378,13 +604,21 @@ void LSMemory::writeString(String fileString, String key, String value){
 // 
 // Description: Writing an individual point value to the corresponding attribute-value pair given by the key to the settings file
 // 
-// Arguments :  fileString : String : the name of the file
-//              key : String : the key of the desired Json attribute
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json attribute
 //              value : pointFloatType : The point to write to the settings file
 // 
 // Return     : void
 //*********************************//
-void LSMemory::writePoint(String fileString, String key, pointFloatType value){
+void LSMemory::writePoint(const char* fileString, const char* key, pointFloatType value){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    if (setting->settingType == MEM_SETTING_TYPE_POINT) {
+      *(pointFloatType*)((uint8_t*)&_settings + setting->settingOffset) = value;
+    }
+    markDirty(1UL << (setting - settingKeyProperty));
+    return;
+  }
   JsonObject obj = readObject(fileString);
   JsonArray point = obj[key].to<JsonArray>();
   point.add(value.x);
@@ -392,4 +626,495 @@ void LSMemory::writePoint(String fileString, String key, pointFloatType value){
   writeObject(fileString,key,obj);
 }
 
-#endif 
+//*********************************//
+// Function   : writeBytes 
+// 
+// Description: Writing an individual byte array to the corresponding attribute-value pair given by the key to the settings file
+// 
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json attribute
+//              value : uint8_t* : The bytes to write to the settings file
+//              length : size_t : the number of bytes
+// 
+// Return     : void
+//*********************************//
+void LSMemory::writeBytes(const char* fileString, const char* key, const uint8_t* value, size_t length){
+  const settingKeyStruct* setting = findSettingKey(fileString, key);
+  if (setting != NULL) {
+    if (setting->settingType == MEM_SETTING_TYPE_BYTES) {
+      uint8_t* field = (uint8_t*)&_settings + setting->settingOffset;
+      memset(field, 0, setting->settingLength);
+      memcpy(field, value, min(length, (size_t)setting->settingLength));
+    }
+    markDirty(1UL << (setting - settingKeyProperty));
+    return;
+  }
+  JsonObject obj = readObject(fileString);
+  obj[key] = bytesToHex(value, length);
+  writeObject(fileString,key,obj);
+}
+
+//*********************************//
+// Function   : update 
+// 
+// Description: Writes pending settings changes to flash once no further change 
+//              has been made for MEM_FLUSH_DELAY ms. Call periodically.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSMemory::update(){
+  if (_dirtyKeys && (millis() - _cacheChangeTime >= MEM_FLUSH_DELAY)) {
+    commit();
+  }
+}
+
+//*********************************//
+// Function   : commit 
+// 
+// Description: Writes pending settings changes to flash immediately.
+//              Changed keys are appended to the journal, which is folded into a new settings record
+//              once it grows past MEM_JOURNAL_COMPACT_SIZE. Call before a reset so no change is lost.
+// 
+// Arguments :  void
+// 
+// Return     : void
+//*********************************//
+void LSMemory::commit(){
+  if (!_cacheLoaded || !_dirtyKeys) {
+    return;
+  }
+  uint32_t keyMask = _dirtyKeys;
+  _dirtyKeys = 0;
+
+  if (!appendJournal(_cacheFileString, keyMask)) {
+    compact();                                    // Journal could not be written, store everything in a new record instead
+    return;
+  }
+
+  if (_journalSize > MEM_JOURNAL_COMPACT_SIZE) {
+    compact();
+  }
+}
+
+//*********************************//
+// Function   : isDirty 
+// 
+// Description: Returns true if there are settings changes not yet written to flash.
+// 
+// Arguments :  void
+// 
+// Return     : dirty : bool : Pending changes status
+//*********************************//
+bool LSMemory::isDirty(){
+  return _dirtyKeys != 0;
+}
+
+//*********************************//
+// Function   : getRecordStatus 
+// 
+// Description: Returns how the settings record was loaded at initialization.
+// 
+// Arguments :  void
+// 
+// Return     : status : int : MEM_RECORD_OK, MEM_RECORD_CREATED, MEM_RECORD_MIGRATED, MEM_RECORD_UPGRADED or MEM_RECORD_CORRUPT
+//*********************************//
+int LSMemory::getRecordStatus(){
+  return _recordStatus;
+}
+
+//*********************************//
+// Function   : readRecord 
+// 
+// Description: Reads the binary settings record into the RAM settings and verifies its CRC.
+//              Records from an older schema version only overwrite the fields they contain.
+// 
+// Arguments :  fileString : String : the name of the settings record file
+// 
+// Return     : status : int : MEM_RECORD_OK, MEM_RECORD_CREATED, MEM_RECORD_UPGRADED or MEM_RECORD_CORRUPT
+//*********************************//
+int LSMemory::readRecord(String fileString){
+  const char* fileName = fileString.c_str();
+  if (!InternalFS.exists(fileName) || !file.open(fileName, FILE_O_READ)) {
+    return MEM_RECORD_CREATED;
+  }
+
+  settingsRecordHeaderStruct header;
+  settingsStruct record;
+  uint32_t recordCrc = 0;
+  bool recordRead = false;
+
+  if (file.read(&header, sizeof(header)) == sizeof(header) &&
+      header.recordMagic == MEM_RECORD_MAGIC &&
+      header.recordVersion <= MEM_RECORD_VERSION &&
+      header.recordLength <= sizeof(record)) {
+    memcpy(&record, &_settings, sizeof(record));  // Fields missing from an older record keep their defaults
+    recordRead = file.read(&record, header.recordLength) == header.recordLength &&
+                 file.read(&recordCrc, sizeof(recordCrc)) == sizeof(recordCrc);
+  }
+  file.close();
+
+  if (!recordRead) {
+    return MEM_RECORD_CORRUPT;
+  }
+
+  uint32_t crc = crc32((const uint8_t*)&header, sizeof(header), 0);
+  crc = crc32((const uint8_t*)&record, header.recordLength, crc);
+  if (crc != recordCrc) {
+    return MEM_RECORD_CORRUPT;
+  }
+
+  record.deviceID[sizeof(record.deviceID) - 1] = 0;
+  memcpy(&_settings, &record, sizeof(_settings));
+  return (header.recordVersion == MEM_RECORD_VERSION && header.recordLength == sizeof(record)) ? MEM_RECORD_OK : MEM_RECORD_UPGRADED;
+}
+
+//*********************************//
+// Function   : writeRecord 
+// 
+// Description: Writes the RAM settings to flash as a binary settings record.
+//              The record is written to a temporary file that then replaces the old record,
+//              so a power loss leaves either the old or the new record in place.
+// 
+// Arguments :  fileString : String : the name of the settings record file
+// 
+// Return     : success : bool : True if the record was written
+//*********************************//
+bool LSMemory::writeRecord(String fileString){
+  settingsRecordHeaderStruct header = { MEM_RECORD_MAGIC, MEM_RECORD_VERSION, sizeof(settingsStruct) };
+  uint32_t crc = crc32((const uint8_t*)&header, sizeof(header), 0);
+  crc = crc32((const uint8_t*)&_settings, sizeof(_settings), crc);
+
+  String tempFileString = fileString + MEM_TEMP_FILE_SUFFIX;
+  InternalFS.remove(tempFileString.c_str());
+  if (!file.open(tempFileString.c_str(), FILE_O_WRITE)) {
+    return false;
+  }
+  size_t writeLength = file.write((const uint8_t*)&header, sizeof(header));
+  writeLength += file.write((const uint8_t*)&_settings, sizeof(_settings));
+  writeLength += file.write((const uint8_t*)&crc, sizeof(crc));
+  file.close();
+  if (writeLength != sizeof(header) + sizeof(_settings) + sizeof(crc)) {
+    InternalFS.remove(tempFileString.c_str());
+    return false;
+  }
+  return switchFile(tempFileString, fileString);
+}
+
+//*********************************//
+// Function   : appendJournal 
+// 
+// Description: Appends the current values of the given keys to the settings journal.
+//              Opening a file for writing continues at its end, so earlier entries are never rewritten.
+// 
+// Arguments :  fileString : String : the name of the settings record file
+//              keyMask : uint32_t : one bit per settingKeyProperty entry to append
+// 
+// Return     : success : bool : True if all entries were written
+//*********************************//
+bool LSMemory::appendJournal(String fileString, uint32_t keyMask){
+  if (!file.open((fileString + MEM_JOURNAL_FILE_SUFFIX).c_str(), FILE_O_WRITE)) {
+    return false;
+  }
+  bool journalWritten = true;
+  for (unsigned int i = 0; i < MEM_SETTING_KEY_NUMBER; i++) {
+    if (!(keyMask & (1UL << i))) {
+      continue;
+    }
+    const settingKeyStruct* setting = &settingKeyProperty[i];
+    const uint8_t* field = (const uint8_t*)&_settings + setting->settingOffset;
+    settingsJournalEntryStruct entry = { (uint8_t)i, (uint8_t)settingSize(setting) };
+    uint32_t crc = crc32((const uint8_t*)&entry, sizeof(entry), 0);
+    crc = crc32(field, entry.entryLength, crc);
+
+    size_t writeLength = file.write((const uint8_t*)&entry, sizeof(entry));
+    writeLength += file.write(field, entry.entryLength);
+    writeLength += file.write((const uint8_t*)&crc, sizeof(crc));
+    _journalSize += writeLength;
+    if (writeLength != sizeof(entry) + entry.entryLength + sizeof(crc)) {
+      journalWritten = false;
+      break;
+    }
+  }
+  file.close();
+  return journalWritten;
+}
+
+//*********************************//
+// Function   : replayJournal 
+// 
+// Description: Applies the entries of the settings journal to the RAM settings in the order they were written.
+//              Replay stops at the first entry that is incomplete or fails its CRC, which is where a write was interrupted.
+// 
+// Arguments :  fileString : String : the name of the settings record file
+// 
+// Return     : valid : bool : False if the journal ends in an invalid entry
+//*********************************//
+bool LSMemory::replayJournal(String fileString){
+  _journalSize = 0;
+  if (!file.open((fileString + MEM_JOURNAL_FILE_SUFFIX).c_str(), FILE_O_READ)) {
+    return true;
+  }
+  _journalSize = file.size();
+  bool journalValid = true;
+  settingsJournalEntryStruct entry;
+  uint8_t value[sizeof(_settings.rangeMap)];      // Largest settings value
+  uint32_t entryCrc;
+
+  while (file.available() > 0) {
+    if (file.read(&entry, sizeof(entry)) != sizeof(entry) ||
+        entry.entryKey >= MEM_SETTING_KEY_NUMBER ||
+        entry.entryLength != settingSize(&settingKeyProperty[entry.entryKey]) ||
+        file.read(value, entry.entryLength) != entry.entryLength ||
+        file.read(&entryCrc, sizeof(entryCrc)) != sizeof(entryCrc) ||
+        crc32(value, entry.entryLength, crc32((const uint8_t*)&entry, sizeof(entry), 0)) != entryCrc) {
+      journalValid = false;
+      break;
+    }
+    memcpy((uint8_t*)&_settings + settingKeyProperty[entry.entryKey].settingOffset, value, entry.entryLength);
+  }
+  file.close();
+  _settings.deviceID[sizeof(_settings.deviceID) - 1] = 0;
+  return journalValid;
+}
+
+//*********************************//
+// Function   : compact 
+// 
+// Description: Writes the RAM settings as a new settings record and removes the journal it replaces.
+//              If power is lost before the journal is removed, replaying it on the new record gives the same values.
+// 
+// Arguments :  void
+// 
+// Return     : success : bool : True if the record was written
+//*********************************//
+bool LSMemory::compact(){
+  if (!writeRecord(_cacheFileString)) {
+    return false;
+  }
+  InternalFS.remove((_cacheFileString + MEM_JOURNAL_FILE_SUFFIX).c_str());
+  _journalSize = 0;
+  return true;
+}
+
+//*********************************//
+// Function   : switchFile 
+// 
+// Description: Replaces a file with a completely written temporary file in one atomic rename.
+// 
+// Arguments :  tempFileString : String : the name of the temporary file
+//              fileString : String : the name of the file to replace
+// 
+// Return     : success : bool : True if the file was replaced
+//*********************************//
+bool LSMemory::switchFile(String tempFileString, String fileString){
+  return InternalFS.rename(tempFileString.c_str(), fileString.c_str());
+}
+
+//*********************************//
+// Function   : settingSize 
+// 
+// Description: Returns the size of the value of a settings key.
+// 
+// Arguments :  setting : settingKeyStruct* : the settings key
+// 
+// Return     : size : size_t : The size in bytes
+//*********************************//
+size_t LSMemory::settingSize(const settingKeyStruct* setting){
+  switch (setting->settingType) {
+    case MEM_SETTING_TYPE_FLOAT:
+      return sizeof(float);
+    case MEM_SETTING_TYPE_STRING:
+      return sizeof(_settings.deviceID);
+    case MEM_SETTING_TYPE_POINT:
+      return sizeof(pointFloatType);
+    case MEM_SETTING_TYPE_BYTES:
+      return setting->settingLength;
+    default:
+      return sizeof(int);
+  }
+}
+
+//*********************************//
+// Function   : settingsFromJson 
+// 
+// Description: Copies the known keys of a Json Object into the RAM settings. Missing keys are left unchanged.
+// 
+// Arguments :  obj : JsonObject : Json Object with settings key and value pairs
+// 
+// Return     : void
+//*********************************//
+void LSMemory::settingsFromJson(JsonObject obj){
+  for (unsigned int i = 0; i < MEM_SETTING_KEY_NUMBER; i++) {
+    const settingKeyStruct* setting = &settingKeyProperty[i];
+    uint8_t* field = (uint8_t*)&_settings + setting->settingOffset;
+    JsonVariant value = obj[setting->settingKey];
+    if (value.isNull()) {
+      continue;
+    }
+    switch (setting->settingType) {
+      case MEM_SETTING_TYPE_INT:
+        *(int*)field = value.as<int>();
+        break;
+      case MEM_SETTING_TYPE_FLOAT:
+        *(float*)field = value.as<float>();
+        break;
+      case MEM_SETTING_TYPE_STRING:
+        strlcpy((char*)field, value.is<const char*>() ? value.as<const char*>() : "", sizeof(_settings.deviceID));
+        break;
+      case MEM_SETTING_TYPE_POINT:
+        *(pointFloatType*)field = {value[0].as<float>(), value[1].as<float>()};
+        break;
+      case MEM_SETTING_TYPE_BYTES:
+        hexToBytes(value.as<const char*>(), field, setting->settingLength);
+        break;
+    }
+  }
+}
+
+//*********************************//
+// Function   : settingsToJson 
+// 
+// Description: Adds all RAM settings to a Json Object as key and value pairs.
+// 
+// Arguments :  obj : JsonObject : Json Object to fill
+// 
+// Return     : void
+//*********************************//
+void LSMemory::settingsToJson(JsonObject obj){
+  for (unsigned int i = 0; i < MEM_SETTING_KEY_NUMBER; i++) {
+    const settingKeyStruct* setting = &settingKeyProperty[i];
+    const uint8_t* field = (const uint8_t*)&_settings + setting->settingOffset;
+    switch (setting->settingType) {
+      case MEM_SETTING_TYPE_INT:
+        obj[setting->settingKey] = *(const int*)field;
+        break;
+      case MEM_SETTING_TYPE_FLOAT:
+        obj[setting->settingKey] = *(const float*)field;
+        break;
+      case MEM_SETTING_TYPE_STRING:
+        obj[setting->settingKey] = (const char*)field;
+        break;
+      case MEM_SETTING_TYPE_POINT:
+        {
+          JsonArray point = obj[setting->settingKey].to<JsonArray>();
+          point.add(((const pointFloatType*)field)->x);
+          point.add(((const pointFloatType*)field)->y);
+          break;
+        }
+      case MEM_SETTING_TYPE_BYTES:
+        obj[setting->settingKey] = bytesToHex(field, setting->settingLength);
+        break;
+    }
+  }
+}
+
+//*********************************//
+// Function   : crc32 
+// 
+// Description: Calculates the CRC-32 (IEEE 802.3) of a block of data. 
+//              Pass the previous result as crc to continue over several blocks.
+// 
+// Arguments :  data : uint8_t* : the data
+//              length : size_t : the number of bytes
+//              crc : uint32_t : 0, or the CRC of the preceding data
+// 
+// Return     : crc : uint32_t : The CRC of all data so far
+//*********************************//
+uint32_t LSMemory::crc32(const uint8_t* data, size_t length, uint32_t crc){
+  crc = ~crc;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+//*********************************//
+// Function   : bytesToHex 
+// 
+// Description: Converts a byte array to a string of two hex digits per byte, for the json settings.
+// 
+// Arguments :  data : uint8_t* : the bytes
+//              length : size_t : the number of bytes
+// 
+// Return     : hexString : String : The hex digits
+//*********************************//
+String LSMemory::bytesToHex(const uint8_t* data, size_t length){
+  const char hexDigits[] = "0123456789ABCDEF";
+  String hexString;
+  hexString.reserve(length * 2);
+  for (size_t i = 0; i < length; i++) {
+    hexString += hexDigits[data[i] >> 4];
+    hexString += hexDigits[data[i] & 0x0F];
+  }
+  return hexString;
+}
+
+//*********************************//
+// Function   : hexToBytes 
+// 
+// Description: Converts a string of two hex digits per byte back to bytes. 
+//              Bytes past the end of the string, or with an invalid digit, are set to zero.
+// 
+// Arguments :  hexString : const char* : the hex digits (may be NULL)
+//              data : uint8_t* : destination of the bytes
+//              length : size_t : the number of bytes
+// 
+// Return     : void
+//*********************************//
+void LSMemory::hexToBytes(const char* hexString, uint8_t* data, size_t length){
+  memset(data, 0, length);
+  if (hexString == NULL) {
+    return;
+  }
+  for (size_t i = 0; i < length && hexString[2 * i] != '\0' && hexString[2 * i + 1] != '\0'; i++) {
+    int highDigit = isxdigit(hexString[2 * i]) ? (isdigit(hexString[2 * i]) ? hexString[2 * i] - '0' : toupper(hexString[2 * i]) - 'A' + 10) : -1;
+    int lowDigit = isxdigit(hexString[2 * i + 1]) ? (isdigit(hexString[2 * i + 1]) ? hexString[2 * i + 1] - '0' : toupper(hexString[2 * i + 1]) - 'A' + 10) : -1;
+    if (highDigit < 0 || lowDigit < 0) {
+      break;
+    }
+    data[i] = (highDigit << 4) | lowDigit;
+  }
+}
+
+//*********************************//
+// Function   : findSettingKey 
+// 
+// Description: Looks up a key of the cached settings file.
+// 
+// Arguments :  fileString : const char* : the name of the file
+//              key : const char* : the key of the desired Json value
+// 
+// Return     : setting : settingKeyStruct* : The key entry, or NULL if the file or key is not cached
+//*********************************//
+const settingKeyStruct* LSMemory::findSettingKey(const char* fileString, const char* key){
+  if (!_cacheLoaded || _cacheFileString != fileString) {
+    return NULL;
+  }
+  for (unsigned int i = 0; i < MEM_SETTING_KEY_NUMBER; i++) {
+    if (strcmp(key, settingKeyProperty[i].settingKey) == 0) {
+      return &settingKeyProperty[i];
+    }
+  }
+  return NULL;
+}
+
+//*********************************//
+// Function   : markDirty 
+// 
+// Description: Flags settings keys as changed and restarts the flush delay.
+// 
+// Arguments :  keyMask : uint32_t : one bit per settingKeyProperty entry that changed
+// 
+// Return     : void
+//*********************************//
+void LSMemory::markDirty(uint32_t keyMask){
+  _dirtyKeys |= keyMask;
+  _cacheChangeTime = millis();
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+/*
+* File: LSSampleQueue.h
+* Firmware: Willow
+* Developed by: MakersMakingChange
+* Version: v1.0rc (April 4 2025)
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Header definition
+#ifndef _LSSAMPLEQUEUE_H
+#define _LSSAMPLEQUEUE_H
+
+#include <atomic>
+
+// Lock-free single producer, single consumer queue.
+// One task (or interrupt) may push while another pops without disabling interrupts or taking a lock.
+// N must be a power of two. One slot is never used so that a full queue can be told apart from an empty one.
+template<typename T, int N>
+class LSSampleQueue {
+  public:
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "LSSampleQueue size must be a power of two");
+
+    LSSampleQueue();
+    bool push(const T& element);          // Producer side. Returns false if the queue is full.
+    bool pop(T* element);                 // Consumer side. Returns false if the queue is empty.
+    int getLength();                      // Number of elements waiting (approximate while the producer is running)
+    void clear();                         // Consumer side. Drop all waiting elements.
+
+  private:
+    T _data[N];
+    std::atomic<uint32_t> _head;          // Next slot to write, only written by the producer
+    std::atomic<uint32_t> _tail;          // Next slot to read, only written by the consumer
+};
+
+//*********************************//
+// Function   : LSSampleQueue
+//
+// Description: Construct an empty LSSampleQueue
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+template<typename T, int N>
+LSSampleQueue<T, N>::LSSampleQueue() : _head(0), _tail(0) {
+}
+
+//*********************************//
+// Function   : push
+//
+// Description: Add an element to the queue. Must only be called from the producer.
+//
+// Arguments :  element : const T& : Element to add
+//
+// Return     : success : bool : False if the queue was full and the element was dropped
+//*********************************//
+template<typename T, int N>
+bool LSSampleQueue<T, N>::push(const T& element) {
+  uint32_t head = _head.load(std::memory_order_relaxed);
+  uint32_t next = (head + 1) & (N - 1);
+  if (next == _tail.load(std::memory_order_acquire)) {
+    return false;
+  }
+  _data[head] = element;
+  _head.store(next, std::memory_order_release);    // Publish the element after it has been written
+  return true;
+}
+
+//*********************************//
+// Function   : pop
+//
+// Description: Remove the oldest element from the queue. Must only be called from the consumer.
+//
+// Arguments :  element : T* : Destination of the removed element
+//
+// Return     : success : bool : False if the queue was empty
+//*********************************//
+template<typename T, int N>
+bool LSSampleQueue<T, N>::pop(T* element) {
+  uint32_t tail = _tail.load(std::memory_order_relaxed);
+  if (tail == _head.load(std::memory_order_acquire)) {
+    return false;
+  }
+  *element = _data[tail];
+  _tail.store((tail + 1) & (N - 1), std::memory_order_release);   // Release the slot after it has been read
+  return true;
+}
+
+//*********************************//
+// Function   : getLength
+//
+// Description: Get the number of elements waiting in the queue
+//
+// Arguments :  void
+//
+// Return     : length : int : Number of elements
+//*********************************//
+template<typename T, int N>
+int LSSampleQueue<T, N>::getLength() {
+  return (_head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire)) & (N - 1);
+}
+
+//*********************************//
+// Function   : clear
+//
+// Description: Drop all waiting elements. Must only be called from the consumer.
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+template<typename T, int N>
+void LSSampleQueue<T, N>::clear() {
+  _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+#endif
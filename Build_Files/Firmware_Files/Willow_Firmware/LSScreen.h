@@ -24,6 +24,7 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "LSBusLock.h"
 
 #define CONF_SCREEN_WIDTH 128  // OLED display width, in pixels
 #define CONF_SCREEN_HEIGHT 64  // OLED display height, in pixels
@@ -38,6 +39,7 @@
 #define CURSOR_SP_MENU 4
 #define MORE_MENU 5
 #define SAFEMODE_MENU 6
+#define MESSAGE_PAGE 7  // Timed message, inputs are ignored until the next page is shown
 
 // Calibration pages
 #define CENTER_RESET_PAGE 21
@@ -57,6 +59,14 @@
 #define INFO_PAGE 57
 
 #define SCROLL_DELAY_MILLIS 100 // [ms] This controls the scroll speed of long menu items //TODO 2025-Feb-28 Make this user adjustable
+#define SCROLL_START_DELAY_MILLIS 200 // [ms] Pause before a long menu item starts scrolling
+
+#define CENTER_RESET_COMPLETE_DURATION 2000 // [ms] How long the center reset complete page is shown
+#define CALIB_COMPLETE_DURATION 1500        // [ms] How long the calibration complete page is shown
+#define EXIT_PAGE_DURATION 500              // [ms] How long the exiting page is shown
+#define CHANGE_MODE_DURATION 2000           // [ms] How long the changing mode page is shown before the mode is changed
+#define FULL_CALIB_WARNING_DURATION 3000    // [ms] How long the full calibration warning is shown before its confirmation
+#define FACTORY_RESET_WARNING_DURATION 2000 // [ms] How long the factory reset warning is shown before its confirmation
 
 #define _MODE_MOUSE_USB 1
 #define _MODE_MOUSE_BT 2
@@ -114,8 +124,9 @@ public:
 
 private:
   Adafruit_SSD1306 _display = Adafruit_SSD1306(CONF_SCREEN_WIDTH, CONF_SCREEN_HEIGHT, &Wire, OLED_RESET);
+  void flushDisplay();  // Send the frame buffer to the display while holding the I2C bus
 
-  LSTimer<void> _screenStateTimer;  // Timer with a callback function
+  LSTimer<CONF_SCREEN_TIMER_SIZE> _screenStateTimer;  // Timer with a callback function
   int _screenStateTimerId;          // Timer ID for screen
   int _screenTimeoutTimerId;        // Timer ID to trigger next screen based on time
 
@@ -156,6 +167,7 @@ private:
   uint8_t _hardwareErrorCode = 0; 
 
   void displayMenu();
+  void returnToMenu();
   void displayCursor();
   void scrollLongText();
   void drawCentreString(const String &buf, int y);
@@ -167,18 +179,21 @@ private:
   void modeMenu();
   void confirmModeChange();
   void changeMode();
+  void applyModeChange();
   void cursorSpeedMenu();
   void scrollSpeedMenu();
   void bluetoothMenu();
   void moreMenu();
   void fullCalibrationPage();
   void fullCalibrationConfirmPage();
+  void fullCalibrationConfirmMenu();
   void centerReset();
   void soundMenu();
   void lightBrightMenu();
   void restartConfirmPage();
   void factoryResetConfirm1Page();
   void factoryResetConfirm2Page();
+  void factoryResetConfirm2Menu();
   void factoryResetPage();
   void hardwareErrorPage();
 
@@ -241,7 +256,11 @@ LSScreen::LSScreen() {
 //*********************************//
 void LSScreen::begin() {
 
-  if (_display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS)) {  // SSD1306_SWITCHCAPVCC = generate display voltage from 3.3V internally
+  g_i2cBusLock.lock();
+  bool displayStarted = _display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS);  // SSD1306_SWITCHCAPVCC = generate display voltage from 3.3V internally
+  g_i2cBusLock.unlock();
+
+  if (displayStarted) {
     g_displayConnected = true;
   } else {
     Serial.println(F("ERROR: Display SSD1306 allocation failed"));
@@ -252,7 +271,7 @@ void LSScreen::begin() {
 
   setupDisplay();  // Clear screen
   _display.setTextWrap(false);
-  _display.display();
+  flushDisplay();
 
   _operatingMode = getOperatingMode(false, false);  // TODO JDMc 2025-Jan-24 These should be moved to update function so they are updated if changed through serial API
   _communicationMode = getCommunicationMode(false, false);
@@ -328,7 +347,7 @@ void LSScreen::activateMenu() {
 void LSScreen::deactivateMenu() {
   _isActive = false;
   clear();
-  _display.display();
+  flushDisplay();
 }
 
 //*********************************//
@@ -364,7 +383,7 @@ void LSScreen::splashScreen() {
   drawCentreString(willowVersionStr, 32);
   drawCentreString("Makers Making Change", 54);
 
-  _display.display();
+  flushDisplay();
 }
 
 //*********************************//
@@ -417,7 +436,7 @@ void LSScreen::splashScreen2() {
       _display.println("Error");
   }
 
-  _display.display();
+  flushDisplay();
 
   if (USB_DEBUG){
     //delay(2000);  //TODO - 2025-FEB-21 Why is this delay here?
@@ -445,6 +464,10 @@ void LSScreen::splashScreen2() {
 void LSScreen::nextMenuItem() {
   _lastActivityMillis = millis();
 
+  if (_currentMenu == MESSAGE_PAGE) {
+    return;
+  }
+
   if (_scrollOn) {
     _display.setCursor(0, _selectedLine * 16);
     _display.print("                                   ");
@@ -481,6 +504,10 @@ void LSScreen::nextMenuItem() {
 void LSScreen::selectMenuItem() {
   _lastActivityMillis = millis();
 
+  if (_currentMenu == MESSAGE_PAGE) {
+    return;
+  }
+
   _countMenuScroll = 0;
   switch (_currentMenu) {
     case MAIN_MENU:
@@ -512,12 +539,12 @@ void LSScreen::selectMenuItem() {
         _currentSelection = 0;
         mainMenu();
       } else {
+        _currentMenu = MESSAGE_PAGE;
         setupDisplay();
         _display.println("Exiting");
-        _display.display();
-        delay(500);  // TODO: remove delay
+        flushDisplay();
 
-        deactivateMenu();
+        _screenTimeoutTimerId = _screenStateTimer.setTimeout(EXIT_PAGE_DURATION, &LSScreen::deactivateMenu, this);
       }
       break;
     case CALIB_MENU:
@@ -570,7 +597,7 @@ void LSScreen::selectMenuItem() {
           _cursorSpMenuText[0] = "Speed: " + String(_cursorSpeedLevel) + " ";
           _display.setCursor(0, 0);
           _display.print(_cursorSpMenuText[0]);
-          _display.display();
+          flushDisplay();
           break;
         case 1:  // Decrease
           decreaseCursorSpeed(true, false);
@@ -578,7 +605,7 @@ void LSScreen::selectMenuItem() {
           _cursorSpMenuText[0] = "Speed: " + String(_cursorSpeedLevel) + " ";
           _display.setCursor(0, 0);
           _display.print(_cursorSpMenuText[0]);
-          _display.display();
+          flushDisplay();
           break;
         case 2:  // Back
           _currentMenu = MAIN_MENU;
@@ -644,7 +671,7 @@ void LSScreen::selectMenuItem() {
           _lightBrightMenuText[0] = "Lights: " + String(_lightBrightLevel) + " ";
           _display.setCursor(0, 0);
           _display.print(_lightBrightMenuText[0]);
-          _display.display();
+          flushDisplay();
           break;
         case 1:  // Decrease
           _lightBrightLevel = getLightBrightnessLevel(false, false);
@@ -654,7 +681,7 @@ void LSScreen::selectMenuItem() {
           _lightBrightMenuText[0] = "Lights: " + String(_lightBrightLevel) + " ";
           _display.setCursor(0, 0);
           _display.print(_lightBrightMenuText[0]);
-          _display.display();
+          flushDisplay();
           break;
         case 2:  // Back
           _currentMenu = MORE_MENU;
@@ -674,7 +701,7 @@ void LSScreen::selectMenuItem() {
           _scrollSpMenuText[0] = "Speed: " + String(_scrollSpeedLevel) + " ";
           _display.setCursor(0, 0);
           _display.print(_scrollSpMenuText[0]);
-          _display.display();
+          flushDisplay();
           break;
         case 1:  // Decrease
           _scrollSpeedLevel = getScrollLevel(false, false);
@@ -684,7 +711,7 @@ void LSScreen::selectMenuItem() {
           _scrollSpMenuText[0] = "Speed: " + String(_scrollSpeedLevel) + " ";
           _display.setCursor(0, 0);
           _display.print(_scrollSpMenuText[0]);
-          _display.display();
+          flushDisplay();
           break;
         case 2:  // Back
           _currentMenu = MORE_MENU;
@@ -779,6 +806,21 @@ void LSScreen::selectMenuItem() {
 //****************************************//
 
 
+//*********************************//
+// Function   : flushDisplay
+//
+// Description: Send the frame buffer to the display. The I2C bus is shared with the joystick sampling task.
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSScreen::flushDisplay() {
+  g_i2cBusLock.lock();
+  _display.display();
+  g_i2cBusLock.unlock();
+}
+
 //*********************************//
 // Function   : setupDisplay
 //
@@ -799,6 +841,23 @@ void LSScreen::setupDisplay() {
 }
 
 
+//*********************************//
+// Function   : returnToMenu
+//
+// Description: Shows the main menu again after a timed page, or clears the display if the menu is not active
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSScreen::returnToMenu() {
+  if (_isActive) {
+    mainMenu();
+  } else {
+    deactivateMenu();
+  }
+}
+
 //*********************************//
 // Function   : displayMenu
 //
@@ -823,7 +882,7 @@ void LSScreen::displayMenu() {
     modeMenuHighlight();
   }
 
-  _display.display();
+  flushDisplay();
 
   //_currentSelection = 0;
   displayCursor();
@@ -863,7 +922,7 @@ void LSScreen::displayCursor() {
     }
   }
 
-  _display.display();
+  flushDisplay();
 
   _selectedLine = _cursorStart + _currentSelection;
   _selectedText = _currentMenuText[_selectedLine];
@@ -872,8 +931,7 @@ void LSScreen::displayCursor() {
     //Serial.println("Long text");
     _scrollOn = true;
     _scrollPos = 12;
-    delay(200);  // TODO: remove delay
-    scrollLongText();
+    _scrollDelayTimer = millis() + SCROLL_START_DELAY_MILLIS - SCROLL_DELAY_MILLIS;  // update() starts scrolling once the pause is over
   } else {
     _scrollOn = false;
   }
@@ -896,7 +954,7 @@ void LSScreen::scrollLongText() {
   _display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);  // Draw white text on solid black background
   _display.setTextWrap(false);
 
-  if (millis() - _scrollDelayTimer >= SCROLL_DELAY_MILLIS) {
+  if ((long)(millis() - _scrollDelayTimer) >= SCROLL_DELAY_MILLIS) {  // Signed, the scroll start pause sets the time ahead
     _scrollDelayTimer = millis();
 
     // Clear previous text by writing over it with blank text
@@ -909,7 +967,7 @@ void LSScreen::scrollLongText() {
 
     _display.setCursor(0, _cursorPos * CHAR_PIXEL_HEIGHT_S2);
     _display.print(">");
-    _display.display();
+    flushDisplay();
 
     _scrollPos = _scrollPos - scrollPixelsPerLoop;
     
@@ -1045,7 +1103,7 @@ void LSScreen::modeMenuHighlight() {
       break;
   }
 
-  _display.display();
+  flushDisplay();
   _display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);  // Reset text colour to white on black
 }
 
@@ -1072,21 +1130,34 @@ void LSScreen::confirmModeChange() {
 //*********************************//
 // Function   : changeMode
 //
-// Description: Format and display Change Mode Menu
+// Description: Format and display Change Mode Page, the mode is changed once it has been shown
 //
 // Arguments :  void
 //
 // Return     : void
 //*********************************//
 void LSScreen::changeMode() {
+  _currentMenu = MESSAGE_PAGE;
   setupDisplay();
   _display.println("Changing");
   _display.println("mode.");
   _display.println("Release");
   _display.println("joystick.");
-  _display.display();
-  delay(2000);
+  flushDisplay();
 
+  _screenTimeoutTimerId = _screenStateTimer.setTimeout(CHANGE_MODE_DURATION, &LSScreen::applyModeChange, this);
+}
+
+//*********************************//
+// Function   : applyModeChange
+//
+// Description: Save the selected communication and operating modes and restart the device
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSScreen::applyModeChange() {
   if (_communicationMode != _tempCommunicationMode) {
     _communicationMode = _tempCommunicationMode;
     setCommunicationMode(false, false, _tempCommunicationMode);  // Sets new communication mode, saves in memory
@@ -1191,7 +1262,7 @@ void LSScreen::centerResetPage(void) {
   _display.println("not move");
   _display.println("joystick");
 
-  _display.display();
+  flushDisplay();
 
   // Perform cursor center
   showCenterResetComplete = true;
@@ -1216,15 +1287,9 @@ void LSScreen::centerResetCompletePage(void) {
   _display.println("reset");
   _display.println("complete");
 
-  _display.display();
-
-  delay(2000);
+  flushDisplay();
 
-  if (_isActive) {
-    mainMenu();
-  } else {
-    deactivateMenu();
-  }
+  _screenTimeoutTimerId = _screenStateTimer.setTimeout(CENTER_RESET_COMPLETE_DURATION, &LSScreen::returnToMenu, this);
 }
 
 //*********************************//
@@ -1243,7 +1308,7 @@ void LSScreen::fullCalibrationPage(void) {
   _display.println("on screen");
   _display.println("prompts");
 
-  _display.display();
+  flushDisplay();
 
   setJoystickCalibration(false, false);
 }
@@ -1292,14 +1357,9 @@ void LSScreen::fullCalibrationPrompt(int stepNum) {
     case 6:  // Complete
       _display.println("Joystick");
       _display.println("calibrated");
-      _display.display();
+      flushDisplay();
 
-      delay(1500);
-      if (_isActive) {
-        mainMenu();
-      } else {
-        deactivateMenu();
-      }
+      _screenTimeoutTimerId = _screenStateTimer.setTimeout(CALIB_COMPLETE_DURATION, &LSScreen::returnToMenu, this);
       break;
     case CONF_JOY_CALIB_ERROR:  // One or more values were too low to be replaced, flag error message
       _display.println("Movement");
@@ -1308,7 +1368,7 @@ void LSScreen::fullCalibrationPrompt(int stepNum) {
       _display.println("to default.");
   }
 
-  _display.display();
+  flushDisplay();
 }
 
 // ----- MORE SETTINGS MENUS ----- //
@@ -1369,22 +1429,34 @@ void LSScreen::lightBrightMenu(void) {
 //*********************************//
 // Function   : fullCalibrationConfirmPage
 //
-// Description: Format and display Full Calibration Confirmation Page
+// Description: Format and display Full Calibration Warning, followed by its confirmation menu
 //
 // Arguments :  void
 //
 // Return     : void
 //*********************************//
 void LSScreen::fullCalibrationConfirmPage(void) {
+  _currentMenu = MESSAGE_PAGE;
   setupDisplay();
   _display.println("Incorrect");
   _display.println("full calib.");
   _display.println("may cause");
   _display.println("drift.");
-  _display.display();
-  delay(3000);  //TODO 2025-Feb-28 Assess removal of delay
+  flushDisplay();
 
+  _screenTimeoutTimerId = _screenStateTimer.setTimeout(FULL_CALIB_WARNING_DURATION, &LSScreen::fullCalibrationConfirmMenu, this);
+}
 
+//*********************************//
+// Function   : fullCalibrationConfirmMenu
+//
+// Description: Format and display Full Calibration Confirmation Menu
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSScreen::fullCalibrationConfirmMenu(void) {
   _currentMenu = FULL_CALIB_CONFIRM_PAGE;
   _currentMenuLength = _fullCalibrationConfirmLen;
   _currentMenuText = _fullCalibrationConfirmText;
@@ -1443,7 +1515,7 @@ void LSScreen::factoryResetConfirm1Page(void) {
 //*********************************//
 // Function   : factoryResetConfirm2Page
 //
-// Description: Format and display Factory Reset Confirmation Page 2
+// Description: Format and display Factory Reset Warning, followed by Factory Reset Confirmation Menu 2
 //
 // Arguments :  void
 //
@@ -1452,15 +1524,27 @@ void LSScreen::factoryResetConfirm1Page(void) {
 void LSScreen::factoryResetConfirm2Page(void) {
   if (USB_DEBUG) { Serial.println("USBDEBUG: LSScreen::factoryResetConfirm2Page()"); }
 
+  _currentMenu = MESSAGE_PAGE;
   setupDisplay();
   _display.println("This will");
   _display.println("erase all");
   _display.println("custom");
   _display.println("settings");
-  _display.display();
-  delay(2000); // TODO 2025-Feb-28 replace with timer.
+  flushDisplay();
 
+  _screenTimeoutTimerId = _screenStateTimer.setTimeout(FACTORY_RESET_WARNING_DURATION, &LSScreen::factoryResetConfirm2Menu, this);
+}
 
+//*********************************//
+// Function   : factoryResetConfirm2Menu
+//
+// Description: Format and display Factory Reset Confirmation Menu 2
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSScreen::factoryResetConfirm2Menu(void) {
   _currentMenu = FACTORY_RESET_CONFIRM2_PAGE;
   _currentMenuLength = _factoryResetConfirm2Len;
   _currentMenuText = _factoryResetConfirm2Text;
@@ -1506,7 +1590,7 @@ void LSScreen::testPage(unsigned int usbConnectDelay) {
   _display.println(_testScreenAttempt);
 
   _display.println(usbConnectDelay);
-  _display.display();
+  flushDisplay();
 }
 
 //*********************************//
@@ -1526,7 +1610,7 @@ void LSScreen::noUsbPage(void) {
   _display.println("Use menu");
   _display.println("to change");
   _display.println("modes.");
-  _display.display();
+  flushDisplay();
 }
 
 //*********************************//
@@ -1559,7 +1643,7 @@ void LSScreen::hardwareErrorPage() {
   sprintf(buffer, "ERROR-%03u", _hardwareErrorCode);
   _safeModeReasonText = String(buffer);
 
-  _display.display();
+  flushDisplay();
     
 }
 
@@ -1582,7 +1666,7 @@ void LSScreen::errorPageI2C() {
   _display.println("detected.");
   //_display.println("Contact Maker.");
   
-  _display.display();
+  flushDisplay();
 
   _screenStateTimerId = _screenStateTimer.setTimeout(CONF_SAFEMODE_MENU_TIMEOUT, &LSScreen::safeModeMenu, this);
 }
@@ -1608,7 +1692,7 @@ void LSScreen::errorPageCable() {
   _display.println("detected.");
   _display.println("Try cable.");
 
-  _display.display();
+  flushDisplay();
 
   _screenStateTimerId = _screenStateTimer.setTimeout(2*CONF_SAFEMODE_MENU_TIMEOUT, &LSScreen::safeModeMenu, this);
 
@@ -1632,7 +1716,7 @@ void LSScreen::warningUSBDebugOn(void) {
   _display.println("USB_DEBUG=1");
   _display.println("Set to 0");
   _display.println("for user.");
-  _display.display();
+  flushDisplay();
 
   _screenStateTimerId = _screenStateTimer.setTimeout(CONF_SPLASH_SCREEN_DURATION, clearSplashScreen);
 }
@@ -1655,7 +1739,7 @@ void LSScreen::restartPage() {
   _display.println("RESTARTING...");
   _display.println("");
 
-  _display.display();
+  flushDisplay();
 
   const int RESTART_TIMEOUT = 3000;
   _screenStateTimerId = _screenStateTimer.setTimeout(RESTART_TIMEOUT, clearSplashScreen);
@@ -1679,7 +1763,7 @@ void LSScreen::factoryResetPage() {
   _display.println("RESET...");
   _display.println("");
 
-  _display.display();
+  flushDisplay();
   const int RESET_TIMEOUT = 3000;
   _screenStateTimerId = _screenStateTimer.setTimeout(RESET_TIMEOUT, clearSplashScreen);
 }
@@ -1708,7 +1792,7 @@ void LSScreen::connectionTimingPage(unsigned long before, unsigned long after) {
   _display.setTextSize(2);
   _display.println(after);
 
-  _display.display();
+  flushDisplay();
 }
 
 
@@ -1761,7 +1845,7 @@ void LSScreen::safeModePage(int safeModeReason) {
   }
   _display.println("");
 
-  _display.display();
+  flushDisplay();
 }
 
 //*********************************//
@@ -1806,7 +1890,7 @@ void LSScreen::print4LineString(String s1, String s2, String s3, String s4) {
   _display.println(s2);
   _display.println(s3);
   _display.println(s4);
-  _display.display();
+  flushDisplay();
 }
 
 //*********************************//
@@ -47,6 +47,10 @@ void activateTest(int inputTest) {
       testWatchdog();
       break;
 
+    case (CONF_TEST_MODE_JOYSTICK_BENCHMARK):
+      testJoystickBenchmark();
+      break;
+
   } // end switch inputTest
   Serial.println("Test Complete");
 }
@@ -168,10 +172,12 @@ void testBuzzer() {
 
   Serial.println("TEST_MODE_BUZZER: Playing ready sounds.");
   buzzer.playReadySound();
+  buzzer.finish();
   delay(1000);
 
   Serial.println("TEST_MODE_BUZZER: Playing error sound.");
   buzzer.playErrorSound();
+  buzzer.finish();
   delay(1000);
 
   Serial.println("TEST_MODE_BUZZER: Playing corner calibration sound.");
@@ -184,6 +190,7 @@ void testBuzzer() {
 
   Serial.println("TEST_MODE_BUZZER: Playing shutdown sound.");
   buzzer.playShutdownSound();
+  buzzer.finish();
   delay(1000);
 
   // TODO Test Sound levels
@@ -223,3 +230,147 @@ void testWatchdog() {
   
   Serial.println("WATCHDOG TEST COMPLETE");
 }  // end testBuzzer()
+
+//***GET BENCHMARK TRACE POINT FUNCTION***//
+// Function   : getBenchmarkTracePoint
+//
+// Description: This function returns one sample of the joystick replay trace.
+//              The trace is deterministic and covers rest noise, a slow sweep inside the operating
+//              circle, a fast sweep outside of it (clamped) and ramps along the axes and diagonals.
+//              The final sample is the center point so the joystick output returns to zero after the replay.
+//
+// Parameters : sampleIndex : int : The index of the sample (0 to CONF_TEST_BENCHMARK_SAMPLE_NUMBER - 1)
+//              noiseSeed : unsigned long* : Pseudo random state used for the rest noise
+//
+// Return     : tracePoint : pointFloatType : The raw magnet reading in mT
+//****************************************//
+pointFloatType getBenchmarkTracePoint(int sampleIndex, unsigned long* noiseSeed) {
+  pointFloatType center = {CONF_TEST_BENCHMARK_CENTER_X, CONF_TEST_BENCHMARK_CENTER_Y};
+  pointFloatType tracePoint = center;
+
+  // Linear congruential generator so the noise is the same on every run
+  *noiseSeed = (*noiseSeed * 1103515245UL) + 12345UL;
+  float noise = ((float)((*noiseSeed >> 16) & 0xFF) / 255.0 - 0.5) * 0.3;  // +/- 0.15 mT
+
+  int segmentLength = CONF_TEST_BENCHMARK_SAMPLE_NUMBER / 4;
+  int segmentIndex = sampleIndex % segmentLength;
+  float segmentAngle = 2.0 * PI * segmentIndex / segmentLength;
+
+  if (sampleIndex == CONF_TEST_BENCHMARK_SAMPLE_NUMBER - 1) {
+    tracePoint = center;                                                      // Return to rest
+  } else if (sampleIndex < segmentLength) {
+    tracePoint = {center.x + noise, center.y - noise};                         // Rest with sensor noise
+  } else if (sampleIndex < 2 * segmentLength) {
+    tracePoint = {center.x + 8.0 * cos(segmentAngle), center.y + 8.0 * sin(segmentAngle)};    // Slow sweep inside circle
+  } else if (sampleIndex < 3 * segmentLength) {
+    tracePoint = {center.x + 20.0 * cos(3.0 * segmentAngle), center.y + 20.0 * sin(3.0 * segmentAngle)};  // Fast sweep outside circle
+  } else {
+    float rampMagnitude = 20.0 * segmentIndex / segmentLength;
+    float rampAngle = (PI / 4.0) * (segmentIndex % 8);                        // Axes and diagonals
+    tracePoint = {center.x + rampMagnitude * cos(rampAngle) + noise, center.y + rampMagnitude * sin(rampAngle)};
+  }
+
+  return tracePoint;
+}
+
+//***TEST JOYSTICK BENCHMARK FUNCTION***//
+// Function   : testJoystickBenchmark
+//
+// Description: This function replays a raw magnet trace through the joystick processing pipeline
+//              (LSJoystick::update(point)) and reports the per-sample latency, throughput and an
+//              output checksum. A fixed calibration and default deadzone and speed settings are used
+//              while replaying, so the checksum only changes if the pipeline output changes.
+//              The stored settings are restored when the test is complete.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void testJoystickBenchmark() {
+
+  Serial.println("JOYSTICK BENCHMARK TEST ACTIVATED");
+
+  // Save the center point since it is not stored in memory
+  pointFloatType savedCenter = js.getInputCenter();
+
+  // Load the fixed benchmark calibration and settings
+  js.setInputMax(0, {CONF_TEST_BENCHMARK_CENTER_X, CONF_TEST_BENCHMARK_CENTER_Y});
+  js.setInputMax(1, {CONF_TEST_BENCHMARK_CENTER_X - CONF_TEST_BENCHMARK_CORNER, CONF_TEST_BENCHMARK_CENTER_Y + CONF_TEST_BENCHMARK_CORNER});
+  js.setInputMax(2, {CONF_TEST_BENCHMARK_CENTER_X + CONF_TEST_BENCHMARK_CORNER, CONF_TEST_BENCHMARK_CENTER_Y + CONF_TEST_BENCHMARK_CORNER});
+  js.setInputMax(3, {CONF_TEST_BENCHMARK_CENTER_X + CONF_TEST_BENCHMARK_CORNER, CONF_TEST_BENCHMARK_CENTER_Y - CONF_TEST_BENCHMARK_CORNER});
+  js.setInputMax(4, {CONF_TEST_BENCHMARK_CENTER_X - CONF_TEST_BENCHMARK_CORNER, CONF_TEST_BENCHMARK_CENTER_Y - CONF_TEST_BENCHMARK_CORNER});
+  js.setMinimumRadius();
+  js.clearRangeMap();  // The trace is mapped with the test corners
+  js.setInnerDeadzone(true, CONF_JOY_DEADZONE_INNER_DEFAULT);
+  js.setOuterDeadzone(true, CONF_JOY_DEADZONE_OUTER_DEFAULT);
+  js.setOutputRange(CONF_JOY_CURSOR_SPEED_LEVEL_DEFAULT);
+  js.setAccelerationLevel(JOY_ACCELERATION_LEVEL_DEFAULT);
+  js.setFilterCutoff(0.0);  // The replay has no sample timing, so the smoothing filter is off
+
+  Serial.print("TEST_MODE_JOYSTICK_BENCHMARK: Samples:");
+  Serial.print(CONF_TEST_BENCHMARK_SAMPLE_NUMBER);
+  Serial.print(" Runs:");
+  Serial.print(CONF_TEST_BENCHMARK_RUN_NUMBER);
+  Serial.print(" Magnet Z direction:");
+  Serial.println(js.getMagnetZDirection());
+
+  unsigned long noiseSeed;
+  unsigned long sampleStartTime;
+  unsigned long sampleTime;
+  unsigned long sampleTimeMin = 0xFFFFFFFFUL;
+  unsigned long sampleTimeMax = 0;
+  unsigned long sampleTimeTotal = 0;
+  unsigned long outputChecksum = 2166136261UL;                              // FNV-1a offset basis
+  pointFloatType tracePoint;
+  pointIntType outputPoint;
+
+  for (int runIndex = 0; runIndex < CONF_TEST_BENCHMARK_RUN_NUMBER; runIndex++) {
+    noiseSeed = 1;
+    for (int sampleIndex = 0; sampleIndex < CONF_TEST_BENCHMARK_SAMPLE_NUMBER; sampleIndex++) {
+      tracePoint = getBenchmarkTracePoint(sampleIndex, &noiseSeed);
+
+      sampleStartTime = micros();
+      js.update(tracePoint);
+      sampleTime = micros() - sampleStartTime;
+
+      sampleTimeMin = min(sampleTimeMin, sampleTime);
+      sampleTimeMax = max(sampleTimeMax, sampleTime);
+      sampleTimeTotal += sampleTime;
+
+      // Only the first run is part of the checksum, the remaining runs are for timing
+      if (runIndex == 0) {
+        outputPoint = js.getXYOut();
+        outputChecksum = (outputChecksum ^ (uint16_t)outputPoint.x) * 16777619UL;  // FNV-1a prime
+        outputChecksum = (outputChecksum ^ (uint16_t)outputPoint.y) * 16777619UL;
+      }
+    }
+    watchdogLoop();  // Feed the watchdog between runs
+  }
+
+  unsigned long sampleNumber = (unsigned long)CONF_TEST_BENCHMARK_SAMPLE_NUMBER * CONF_TEST_BENCHMARK_RUN_NUMBER;
+
+  Serial.print("TEST_MODE_JOYSTICK_BENCHMARK: Latency min/avg/max (us):");
+  Serial.print(sampleTimeMin);
+  Serial.print("/");
+  Serial.print((float)sampleTimeTotal / sampleNumber);
+  Serial.print("/");
+  Serial.println(sampleTimeMax);
+
+  Serial.print("TEST_MODE_JOYSTICK_BENCHMARK: Throughput (samples/s):");
+  Serial.println((sampleTimeTotal > 0) ? (1000000.0 * sampleNumber / sampleTimeTotal) : 0.0);
+
+  Serial.print("TEST_MODE_JOYSTICK_BENCHMARK: Output checksum:");
+  Serial.println(outputChecksum, HEX);
+
+  // Restore the stored calibration and settings
+  js.setInputMax(0, savedCenter);
+  getJoystickCalibration(false, false);
+  getJoystickRangeMap(false, false);
+  getJoystickInnerDeadzone(false, false);
+  getJoystickOuterDeadzone(false, false);
+  getCursorSpeed(false, false);
+  getJoystickAcceleration(false, false);
+  getJoystickFilterCutoff(false, false);
+
+  Serial.println("JOYSTICK BENCHMARK TEST COMPLETE");
+}  // end testJoystickBenchmark()
@@ -22,11 +22,37 @@
 #ifndef _LSTIMER_H
 #define _LSTIMER_H
 
-
-template<typename T>
+#define TIMER_CATCHUP_BURST 0                                                     // Run once for every missed period, back to back, until caught up
+#define TIMER_CATCHUP_COALESCE 1                                                  // Run once for all missed periods and stay on the period grid
+#define TIMER_CATCHUP_SKIP 2                                                      // Drop the run when whole periods were missed and wait for the next period
+
+#define TIMER_HISTOGRAM_BINS 10                                                   // Number of callback execution time histogram bins
+#define TIMER_HISTOGRAM_FIRST_BIN_SHIFT 6                                         // First bin counts callbacks under 2^6 = 64 us, each following bin doubles, the last bin is 16.4 ms and over
+
+// Timer statistics structure ( Lateness and execution time of the runs since the timer was set up or the statistics were reset )
+typedef struct {
+  unsigned long numSamples;                                                       // Number of runs measured
+  unsigned long latenessMin;                                                      // Minimum time a run was late (ms)
+  unsigned long latenessAverage;                                                  // Average time a run was late (ms)
+  unsigned long latenessMax;                                                      // Maximum time a run was late (ms)
+  unsigned long missedPeriods;                                                    // Number of periods that were coalesced or skipped
+  unsigned long executionTimeAverage;                                             // Average callback execution time (us)
+  unsigned long executionTimeMax;                                                 // Maximum callback execution time (us)
+  unsigned long activeTimeAverage;                                                // Average time the core was awake during a callback (us, 0 unless CONF_TIMER_PROFILE_CYCLES)
+  unsigned long activeTimeMax;                                                    // Maximum time the core was awake during a callback (us, 0 unless CONF_TIMER_PROFILE_CYCLES)
+} timerStatsStruct;
+
+// Payload of timers without callback parameters
+typedef struct {
+} timerNoPayloadStruct;
+
+class LSTimerObject;                                                              // Placeholder class used to store member function callbacks of any class
+
+
+template<int N, typename Payload = timerNoPayloadStruct>
 class LSTimer {
   private:
-    const static int MAX_TIMERS = 10;                                             // Maximum number of timers
+    const static int MAX_TIMERS = N;                                              // Maximum number of timers
     const static int RUN_FOREVER = 0;                                             // Flag used for timer that should run continously                 
     const static int RUN_ONCE = 1;                                                // Flag used for timer that should only run once
     const static int DEFCALL_DONTRUN = 0;                                         // Don't call the callback function
@@ -34,12 +60,20 @@ class LSTimer {
     const static int DEFCALL_RUNANDDEL = 2;                                       // Call the callback function and delete the timer
     const static int MAX_INT = 65535;                                             // Maximum integer used to prevent overrun
     typedef void (*timerCallbackPtr)(void);                                       // Define a function pointer type for a callback function with no parameters.
-    typedef void (*timerCallbackParamPtr)(T *);                                   // Define a function pointer type for a callback function with parameters.
-    typedef struct {                                                              // Define timer structure
+    typedef void (*timerCallbackParamPtr)(Payload *);                             // Define a function pointer type for a callback function with parameters.
+    typedef void (LSTimerObject::*timerCallbackMethodPtr)(void);                  // Define a member function pointer type, member callbacks are stored as this type
+    struct timer_t;
+    typedef void (*timerInvokePtr)(timer_t *);                                    // Define a function pointer type for the function that calls the callback of a timer
+    struct timer_t {                                                              // Define timer structure
       unsigned long previousTime;                                                 // Last time the timer was triggered 
-      void* callback;                                                             // Pointer to the callback function
-      T* param;                                                                   // Pointer to the function parameter
-      boolean hasParam;                                                           // Check if callback takes a parameter
+      timerInvokePtr invoke;                                                      // Calls the callback with its parameters, NULL if the slot is free
+      union {
+        timerCallbackPtr function;                                                // Callback function
+        timerCallbackParamPtr functionParam;                                      // Callback function with parameters
+        timerCallbackMethodPtr method;                                            // Callback member function
+      } callback;
+      void* object;                                                               // Object the member function is called on
+      Payload payload;                                                            // Callback function parameters, stored in the timer
       unsigned long intervalTime;                                                 // Time between triggers
       unsigned maxNumRuns;                                                        // Number of runs to be executed
       unsigned numRuns;                                                           // Number of executed runs
@@ -47,22 +81,50 @@ class LSTimer {
       unsigned long startDelayTime;                                               // Initial start delay
       boolean startDelayEnabled;                                                  // Check if offset is enabled
       unsigned toBeCalled;                                                        // Deferred function call
-    } timer_t;
+      unsigned catchupPolicy;                                                     // What to do with missed periods (TIMER_CATCHUP_*)
+      unsigned long numSamples;                                                   // Number of runs measured
+      unsigned long latenessMin;                                                  // Minimum time a run was late (ms)
+      unsigned long latenessMax;                                                  // Maximum time a run was late (ms)
+      unsigned long latenessTotal;                                                // Sum of the lateness of all measured runs (ms)
+      unsigned long missedPeriods;                                                // Number of periods that were coalesced or skipped
+      unsigned long executionTimeMax;                                             // Maximum callback execution time (us)
+      uint64_t executionTimeTotal;                                                // Sum of the callback execution times (us)
+      unsigned long activeTimeMax;                                                // Maximum time the core was awake during a callback (us)
+      uint64_t activeTimeTotal;                                                   // Sum of the times the core was awake during the callbacks (us)
+      unsigned long executionTimeHistogram[TIMER_HISTOGRAM_BINS];                 // Number of callbacks in each execution time bin
+    };
     
     int numTimers; 
+    unsigned long nextDeadlineTime;                                               // Time the next timer is due (ms)
+    boolean deadlineValid;                                                        // Check if nextDeadlineTime is up to date with the timer slots
+    boolean deadlineSet;                                                          // Check if an enabled timer is due at nextDeadlineTime
     int findFirstFreeSlot();                                                      // Find the first available slot
-    int setupTimer(unsigned long interval, unsigned long startDelay, boolean on, boolean hasParam, unsigned n, void* f, T* p);  
+    int setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, timerInvokePtr invoke);
+    int setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, timerCallbackPtr f);
+    int setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, timerCallbackParamPtr f, const Payload& p);
+    template <typename ObjType> int setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, void (ObjType::*method)(), ObjType* obj);
+    static void invokeFunction(timer_t* t) { t->callback.function(); }           // Call a callback function
+    static void invokeFunctionParam(timer_t* t) { t->callback.functionParam(&t->payload); }  // Call a callback function with the parameters stored in the timer
+    template <typename ObjType> static void invokeMethod(timer_t* t) {            // Call a member function callback on its object
+      (static_cast<ObjType*>(t->object)->*reinterpret_cast<void (ObjType::*)()>(t->callback.method))();
+    }
+    static unsigned long profileStart();                                          // Cycle count taken before a callback
+    static unsigned long profileElapsed(unsigned long start);                     // Time the core was awake since the profileStart cycle count (us)
     
   public:
+    const static unsigned long NO_DEADLINE = 0xFFFFFFFFUL;                        // Returned by nextDeadline when no timers are set
     LSTimer();                                                                    // Constructor
     void run();                                                                   // Check whether timers should be triggered and call callbacks. Must be called inside loop()
+    unsigned long nextDeadline();                                                 // Time until the next timer is due (ms)
     int setInterval(unsigned long interval, unsigned long startDelay, timerCallbackPtr f);   // Call function f every interval milliseconds, start in startDelay milliseconds
-    int setInterval(unsigned long interval, unsigned long startDelay, timerCallbackParamPtr f, T* p);
+    int setInterval(unsigned long interval, unsigned long startDelay, timerCallbackParamPtr f, const Payload& p);
+    template <typename ObjType> int setInterval(unsigned long interval, unsigned long startDelay, void (ObjType::*method)(), ObjType* obj);
     int setTimeout(unsigned long startDelay, timerCallbackPtr f);                 // Call function f once after interval milliseconds
-    int setTimeout(unsigned long startDelay, timerCallbackParamPtr f, T* p);      // Call function f once after interval milliseconds with parameters p
+    int setTimeout(unsigned long startDelay, timerCallbackParamPtr f, const Payload& p);  // Call function f once after interval milliseconds with parameters p
     template <typename ObjType> int setTimeout(unsigned long interval, void (ObjType::*method)(), ObjType* obj);  // Overloaded function to handle calls from within class
     int setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackPtr f); // Call function f every interval milliseconds for n times, start in startDelay milliseconds
-    int setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackParamPtr f, T* p);
+    int setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackParamPtr f, const Payload& p);
+    template <typename ObjType> int setTimer(unsigned long interval, unsigned long startDelay, unsigned n, void (ObjType::*method)(), ObjType* obj);
     int startTimer();                                                             // Start a timer 
     unsigned long elapsedTime(int timerId);                                       // Time elapsed for specificed timer
     int deleteTimer(int timerId);                                                 // Destroy the specified timer
@@ -74,6 +136,10 @@ class LSTimer {
     int getNumTimers();                                                           // Returns the number of used timers
     int getNumAvailableTimers() { return MAX_TIMERS - numTimers; };               // Returns the number of available timers
     int getNumRuns(int timerId);                                                  // Returns the number of executed runs
+    void setCatchupPolicy(int timerId, unsigned policy);                          // Sets what the specified timer does with missed periods
+    timerStatsStruct getStats(int timerId);                                       // Returns the lateness and execution time statistics of the specified timer
+    void resetStats(int timerId);                                                 // Clears the statistics of the specified timer
+    void getHistogram(int timerId, unsigned long* histogram);                     // Copies the execution time histogram of the specified timer
     timer_t timer[MAX_TIMERS];                                                    // Array of timer structures                                                 
                                                              
 };
@@ -88,8 +154,8 @@ class LSTimer {
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-LSTimer<T>::LSTimer() { // TODO 2025-Feb-07 Consider adding overridden function with size argument for better memory manager
+template<int N, typename Payload>
+LSTimer<N, Payload>::LSTimer() {
     unsigned long current_millis = millis();
 
    for (int i = 0; i < MAX_TIMERS; i++) {
@@ -98,32 +164,98 @@ LSTimer<T>::LSTimer() { // TODO 2025-Feb-07 Consider adding overridden function
     }
 
     numTimers = 0;
+    nextDeadlineTime = current_millis;
+    deadlineValid = false;
+    deadlineSet = false;
+
+#if CONF_TIMER_PROFILE_CYCLES
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;                               // Enable the trace unit and start the DWT cycle counter
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+
+//*********************************//
+// Function   : profileStart 
+// 
+// Description: Returns the DWT cycle count before a callback is called if CONF_TIMER_PROFILE_CYCLES is set.
+//              The cycle counter stops while the core sleeps, so it measures the time the core was awake,
+//              not the execution time. The execution time is always measured with micros().
+//
+// Arguments :  void
+// 
+// Return     : unsigned long : Cycle count, 0 if CONF_TIMER_PROFILE_CYCLES is not set
+//*********************************//
+template<int N, typename Payload>
+unsigned long LSTimer<N, Payload>::profileStart() {
+#if CONF_TIMER_PROFILE_CYCLES
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+
+//*********************************//
+// Function   : profileElapsed 
+// 
+// Description: Returns the time the core was awake since a profileStart cycle count.
+//
+// Arguments :  unsigned long : start : Cycle count returned by profileStart
+// 
+// Return     : unsigned long : Awake time (us), 0 if CONF_TIMER_PROFILE_CYCLES is not set
+//*********************************//
+template<int N, typename Payload>
+unsigned long LSTimer<N, Payload>::profileElapsed(unsigned long start) {
+#if CONF_TIMER_PROFILE_CYCLES
+    return (DWT->CYCCNT - start) / (SystemCoreClock / 1000000);
+#else
+    return 0;
+#endif
 }
 
 //*********************************//
 // Function   : run 
 // 
-// Description: This function checks to see which timers should be run and runs them
+// Description: This function checks to see which timers should be run and runs them.
+//              The time of the next due enabled timer is kept from the previous scan, so the
+//              call returns without scanning the timer slots until that time is reached.
+//              Disabled timers don't set the deadline, enabling a timer starts a new scan.
 //
 // Arguments :  void
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-void LSTimer<T>::run() {
+template<int N, typename Payload>
+void LSTimer<N, Payload>::run() {
     int i;  // Timer index
     unsigned long current_millis; //  Current time
     unsigned long delay_millis;  //  
+    unsigned long elapsed_millis;  //  Time since the timer was last triggered
+    unsigned long remaining_millis;  //  Time until the timer is due
+    unsigned long late_millis;  //  Time the timer is late
+    unsigned long num_periods;  //  Number of periods that have passed
+    unsigned long start_micros;  //  Time before the callback was called (us)
+    unsigned long start_cycles;  //  Cycle count before the callback was called
+    int histogram_bin;  //  Execution time histogram bin
+    unsigned long execution_micros;  //  Callback execution time (us)
+    unsigned long active_micros;  //  Time the core was awake during the callback (us)
+    unsigned long next_millis = NO_DEADLINE;  //  Time until the first timer is due
 
     // Get the current time
     current_millis = millis();
 
+    // Nothing is due before the next deadline, or nothing is enabled
+    if (numTimers == 0 || (deadlineValid && (!deadlineSet || (long)(current_millis - nextDeadlineTime) < 0))) {
+        return;
+    }
+
     // Determine which timers should be called
     for (i = 0; i < MAX_TIMERS; i++) {
 
         timer[i].toBeCalled = DEFCALL_DONTRUN;  // Default case is not to run
 
-        if (timer[i].callback != NULL) {
+        if (timer[i].invoke != NULL) {
 
             if ((timer[i].numRuns == 0) && timer[i].startDelayEnabled) {  // If offset is enabled, use offset as delay for first run
               delay_millis = timer[i].startDelayTime;
@@ -131,14 +263,40 @@ void LSTimer<T>::run() {
               delay_millis = timer[i].intervalTime;
             } 
             
+            elapsed_millis = current_millis - timer[i].previousTime;
+
             // Check if it's time to process timer
-            if ((current_millis - timer[i].previousTime) >= delay_millis) {
+            if (elapsed_millis >= delay_millis) {
 
-                // Update the time the timer was triggered
-                timer[i].previousTime += delay_millis;  //  TODO shouldn't this be the actual triggered time, e.g., current_millis (vs, idealized trigger time when current-prev = delay) (should also be moved to where function is actually called?)
+                late_millis = elapsed_millis - delay_millis;
 
-                // Check if the timer callback has to be executed
+                // Number of periods passed, the first run and zero delays count as one
+                if (timer[i].numRuns == 0 || delay_millis == 0 || timer[i].catchupPolicy == TIMER_CATCHUP_BURST) {
+                  num_periods = 1;
+                } else {
+                  num_periods = elapsed_millis / delay_millis;
+                }
+
+                // Update the time the timer was due. Advancing by whole periods keeps the timer on its period grid, so it doesn't drift.
+                timer[i].previousTime += num_periods * delay_millis;
+
+                // Skip the run if whole periods were missed
+                boolean skipRun = (timer[i].catchupPolicy == TIMER_CATCHUP_SKIP && num_periods > 1);
                 if (timer[i].enabled) {
+                  timer[i].missedPeriods += skipRun ? num_periods : (num_periods - 1);
+                }
+
+                // Check if the timer callback has to be executed
+                if (timer[i].enabled && !skipRun) {
+
+                    // Update lateness statistics
+                    if (timer[i].numSamples == 0 || late_millis < timer[i].latenessMin) {
+                      timer[i].latenessMin = late_millis;
+                    }
+                    if (late_millis > timer[i].latenessMax) {
+                      timer[i].latenessMax = late_millis;
+                    }
+                    timer[i].latenessTotal += late_millis;
 
                     //  If a timer is triggered, increment the number of runs
                     if (timer[i].numRuns == (MAX_INT-1)) { // -1 ensures that even / odd remain consistent
@@ -160,19 +318,57 @@ void LSTimer<T>::run() {
                         timer[i].toBeCalled = DEFCALL_RUNANDDEL;
                     }
                 }
+
+                // The following runs use the interval time
+                delay_millis = timer[i].intervalTime;
+            }
+
+            // Keep the earliest time a remaining enabled timer is due
+            if (timer[i].enabled && timer[i].toBeCalled != DEFCALL_RUNANDDEL) {
+                elapsed_millis = current_millis - timer[i].previousTime;
+                remaining_millis = (elapsed_millis >= delay_millis) ? 0 : (delay_millis - elapsed_millis);
+                if (remaining_millis < next_millis) {
+                    next_millis = remaining_millis;
+                }
             }
         }
     }
 
+    // Callbacks that add or restart timers invalidate the deadline again
+    nextDeadlineTime = current_millis + next_millis;
+    deadlineSet = (next_millis != NO_DEADLINE);
+    deadlineValid = true;
+
     //  Trigger the timers that needs to be run
     for (i = 0; i < MAX_TIMERS; i++) {
       
       if (timer[i].toBeCalled != DEFCALL_DONTRUN){    // Check if timer should be run, if not equal to DONTRUN (either RUNONLY or RUNANDDEL)
-          if (timer[i].hasParam) {
-            (*(timerCallbackParamPtr)timer[i].callback)(timer[i].param);
-          } else {
-            (*(timerCallbackPtr)timer[i].callback)();
+          start_micros = micros();
+          start_cycles = profileStart();
+          timer[i].invoke(&timer[i]);
+          active_micros = profileElapsed(start_cycles);
+          execution_micros = micros() - start_micros;
+
+          // Update execution time statistics
+          if (execution_micros > timer[i].executionTimeMax) {
+            timer[i].executionTimeMax = execution_micros;
+          }
+          timer[i].executionTimeTotal += execution_micros;
+          if (active_micros > timer[i].activeTimeMax) {
+            timer[i].activeTimeMax = active_micros;
           }
+          timer[i].activeTimeTotal += active_micros;
+          timer[i].numSamples++;
+
+          // Log2 histogram bin, counted from the first bin bound
+          histogram_bin = 0;
+          if ((execution_micros >> TIMER_HISTOGRAM_FIRST_BIN_SHIFT) > 0) {
+            histogram_bin = 32 - __builtin_clz(execution_micros >> TIMER_HISTOGRAM_FIRST_BIN_SHIFT);
+          }
+          if (histogram_bin >= TIMER_HISTOGRAM_BINS) {
+            histogram_bin = TIMER_HISTOGRAM_BINS - 1;
+          }
+          timer[i].executionTimeHistogram[histogram_bin]++;
 
           if (timer[i].toBeCalled == DEFCALL_RUNANDDEL){  // Check if timer should be deleted 
             deleteTimer(i);
@@ -183,6 +379,40 @@ void LSTimer<T>::run() {
 }
 
 
+//*********************************//
+// Function   : nextDeadline 
+// 
+// Description: This function returns the time until the next timer is due, which is how long the caller
+//              can wait before calling run() again. Disabled timers are not included.
+//
+// Arguments :  void
+// 
+// Return     : unsigned long : Time until the next timer is due (ms), 0 if a timer is due, NO_DEADLINE if no timers are enabled
+//*********************************//
+template<int N, typename Payload>
+unsigned long LSTimer<N, Payload>::nextDeadline() {
+    unsigned long current_millis = millis();
+
+    if (numTimers == 0) {
+        return NO_DEADLINE;
+    }
+
+    if (!deadlineValid) {
+        return 0;
+    }
+
+    if (!deadlineSet) {
+        return NO_DEADLINE;
+    }
+
+    if ((long)(current_millis - nextDeadlineTime) >= 0) {
+        return 0;
+    }
+
+    return nextDeadlineTime - current_millis;
+}
+
+
 //*********************************//
 // Function   : findFirstFreeSlot 
 // 
@@ -192,8 +422,8 @@ void LSTimer<T>::run() {
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-int LSTimer<T>::findFirstFreeSlot() {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::findFirstFreeSlot() {
     // All slots are used
     if (numTimers >= MAX_TIMERS) {
         return -1;
@@ -201,7 +431,7 @@ int LSTimer<T>::findFirstFreeSlot() {
 
     // return the first slot with no callback (i.e. free)
     for (int i = 0; i < MAX_TIMERS; i++) {
-        if (timer[i].callback == NULL) {
+        if (timer[i].invoke == NULL) {
             return i;
         }
     }
@@ -214,20 +444,18 @@ int LSTimer<T>::findFirstFreeSlot() {
 //*********************************//
 // Function   : setupTimer 
 // 
-// Description: Set up timer
+// Description: Set up timer in the first free slot
 //
 // Arguments :  unsigned long : interval : interval timey (ms)
 //           :  unsigned long : startDelay : start delay time (ms)
 //           :  boolean : on : whether start delay is enabled 
-//           :  boolean : h : Whether callback has parameters
 //           :  unsigned : n : Maximum number of runs 
-//           :  void* : f : callback Function
-//           :  T* : p : Callback function parameters
+//           :  timerInvokePtr : invoke : Function that calls the callback of the timer
 // 
 // Return     : int : Timer index
 //*********************************//
-template<typename T>
-int LSTimer<T>::setupTimer(unsigned long interval, unsigned long startDelay, boolean on, boolean h, unsigned n, void* f, T* p) {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, timerInvokePtr invoke) {
     int freeTimerIndex;
 
     freeTimerIndex = findFirstFreeSlot();
@@ -236,23 +464,107 @@ int LSTimer<T>::setupTimer(unsigned long interval, unsigned long startDelay, boo
         return -1;
     }
 
-    if (f == NULL) {
-        return -1;
-    }
-
     timer[freeTimerIndex].intervalTime = interval;
-    timer[freeTimerIndex].callback = f;
-    timer[freeTimerIndex].param = p;
-    timer[freeTimerIndex].hasParam = h;
+    timer[freeTimerIndex].invoke = invoke;
+    timer[freeTimerIndex].object = NULL;
     timer[freeTimerIndex].maxNumRuns = n;
     timer[freeTimerIndex].numRuns = 0;
     timer[freeTimerIndex].enabled = true;
     timer[freeTimerIndex].startDelayTime = startDelay;
     timer[freeTimerIndex].startDelayEnabled = on;
     timer[freeTimerIndex].previousTime = millis();
+    timer[freeTimerIndex].catchupPolicy = TIMER_CATCHUP_BURST;
+    resetStats(freeTimerIndex);
 
     numTimers++;
+    deadlineValid = false;  // The new timer may be due before the current deadline
+
+    return freeTimerIndex;
+}
+
+
+//*********************************//
+// Function   : setupTimer 
+// 
+// Description: Set up timer with a callback function
+//
+// Arguments :  unsigned long : interval : interval timey (ms)
+//           :  unsigned long : startDelay : start delay time (ms)
+//           :  boolean : on : whether start delay is enabled 
+//           :  unsigned : n : Maximum number of runs 
+//           :  timerCallbackPtr : f : callback Function
+// 
+// Return     : int : Timer index
+//*********************************//
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, timerCallbackPtr f) {
+    if (f == NULL) {
+        return -1;
+    }
+
+    int freeTimerIndex = setupTimer(interval, startDelay, on, n, &invokeFunction);
+    if (freeTimerIndex >= 0) {
+        timer[freeTimerIndex].callback.function = f;
+    }
+    return freeTimerIndex;
+}
+
+
+//*********************************//
+// Function   : setupTimer 
+// 
+// Description: Set up timer with a callback function with parameters. The parameters are copied into the timer.
+//
+// Arguments :  unsigned long : interval : interval timey (ms)
+//           :  unsigned long : startDelay : start delay time (ms)
+//           :  boolean : on : whether start delay is enabled 
+//           :  unsigned : n : Maximum number of runs 
+//           :  timerCallbackParamPtr : f : callback Function
+//           :  Payload : p : Callback function parameters
+// 
+// Return     : int : Timer index
+//*********************************//
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, timerCallbackParamPtr f, const Payload& p) {
+    if (f == NULL) {
+        return -1;
+    }
+
+    int freeTimerIndex = setupTimer(interval, startDelay, on, n, &invokeFunctionParam);
+    if (freeTimerIndex >= 0) {
+        timer[freeTimerIndex].callback.functionParam = f;
+        timer[freeTimerIndex].payload = p;
+    }
+    return freeTimerIndex;
+}
+
+
+//*********************************//
+// Function   : setupTimer 
+// 
+// Description: Set up timer with a member function callback
+//
+// Arguments :  unsigned long : interval : interval timey (ms)
+//           :  unsigned long : startDelay : start delay time (ms)
+//           :  boolean : on : whether start delay is enabled 
+//           :  unsigned : n : Maximum number of runs 
+//           :  void (ObjType::*)() : method : callback member function
+//           :  ObjType* : obj : Object the member function is called on
+// 
+// Return     : int : Timer index
+//*********************************//
+template<int N, typename Payload>
+template<typename ObjType>
+int LSTimer<N, Payload>::setupTimer(unsigned long interval, unsigned long startDelay, boolean on, unsigned n, void (ObjType::*method)(), ObjType* obj) {
+    if (method == NULL || obj == NULL) {
+        return -1;
+    }
 
+    int freeTimerIndex = setupTimer(interval, startDelay, on, n, &invokeMethod<ObjType>);
+    if (freeTimerIndex >= 0) {
+        timer[freeTimerIndex].callback.method = reinterpret_cast<timerCallbackMethodPtr>(method);
+        timer[freeTimerIndex].object = obj;
+    }
     return freeTimerIndex;
 }
 
@@ -268,9 +580,9 @@ int LSTimer<T>::setupTimer(unsigned long interval, unsigned long startDelay, boo
 // 
 // Return     : int : Timer index
 //*********************************//
-template<typename T>
-int LSTimer<T>::setInterval(unsigned long interval, unsigned long startDelay, timerCallbackPtr f) {
-    return setupTimer(interval, startDelay, true, false, RUN_FOREVER, (void *)f, NULL);
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setInterval(unsigned long interval, unsigned long startDelay, timerCallbackPtr f) {
+    return setupTimer(interval, startDelay, true, RUN_FOREVER, f);
 }
 
 
@@ -281,85 +593,89 @@ int LSTimer<T>::setInterval(unsigned long interval, unsigned long startDelay, ti
 //
 // Arguments :  unsigned long : interval : Time between timer runs (ms)
 //           :  unsigned long : startDelay : Time to delay between start of timer and first run
-//           :  timerCallbackPtr : f : Function called when timer runs
-//           :  T* : p : Function parameters
+//           :  timerCallbackParamPtr : f : Function called when timer runs
+//           :  Payload : p : Function parameters, copied into the timer
 // 
 // Return     : int : Timer index
 //*********************************//
-template<typename T>
-int LSTimer<T>::setInterval(unsigned long interval, unsigned long startDelay, timerCallbackParamPtr f, T* p) {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setInterval(unsigned long interval, unsigned long startDelay, timerCallbackParamPtr f, const Payload& p) {
   return setupTimer(interval, // delay
                     startDelay, // startDelay
                     true, // startDelay enabled
-                    true, // has parameter
                     RUN_FOREVER, //  Keep running
-                    (void *)f, //  Callback function
+                    f, //  Callback function
                     p); // Callback function parameter
 }
 
 
 //*********************************//
-// Function   : setTimeout 
+// Function   : setInterval 
 // 
-// Description: This function sets up a timer to run forever every interval ms after a startDelay
+// Description: This function sets up a timer to call a member function forever every interval ms after a startDelay
 //
 // Arguments :  unsigned long : interval : Time between timer runs (ms)
-//           :  timerCallbackPtr : f : Function called when timer runs
+//           :  unsigned long : startDelay : Time to delay between start of timer and first run
+//           :  void (ObjType::*)() : method : Member function called when timer runs
+//           :  ObjType* : obj : Object the member function is called on
 // 
 // Return     : int : Timer index
 //*********************************//
-template<typename T>
-int LSTimer<T>::setTimeout(unsigned long interval, timerCallbackPtr f) {
-    return setupTimer(interval, 0, false, false, RUN_ONCE, (void *)f, NULL);
+template<int N, typename Payload>
+template<typename ObjType>
+int LSTimer<N, Payload>::setInterval(unsigned long interval, unsigned long startDelay, void (ObjType::*method)(), ObjType* obj) {
+    return setupTimer(interval, startDelay, true, RUN_FOREVER, method, obj);
 }
 
 
 //*********************************//
 // Function   : setTimeout 
 // 
-// Description: This function sets up a timer to run forever every interval ms after a startDelay
+// Description: This function sets up a timer to run once after interval ms
 //
-// Arguments :  unsigned long : interval : Time between timer runs (ms)
+// Arguments :  unsigned long : interval : Time before the timer runs (ms)
 //           :  timerCallbackPtr : f : Function called when timer runs
-//           :  T* : p : Function parameters
 // 
 // Return     : int : Timer index
 //*********************************//
-template<typename T>
-int LSTimer<T>::setTimeout(unsigned long interval, timerCallbackParamPtr f, T* p) {
-  return setupTimer(interval, 0, false, true, RUN_ONCE, (void *)f, p);
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setTimeout(unsigned long interval, timerCallbackPtr f) {
+    return setupTimer(interval, 0, false, RUN_ONCE, f);
 }
 
-template <typename ObjType>
-struct TimerCallbackHelper {
-    static void callback(void* context) {
-        auto* instance = static_cast<ObjType*>(context);
-        (instance->*method)();
-    }
-    static void (ObjType::*method)();  // Store method pointer
-};
 
-template <typename ObjType>
-void (ObjType::*TimerCallbackHelper<ObjType>::method)() = nullptr;
+//*********************************//
+// Function   : setTimeout 
+// 
+// Description: This function sets up a timer to run once after interval ms with callback parameters
+//
+// Arguments :  unsigned long : interval : Time before the timer runs (ms)
+//           :  timerCallbackParamPtr : f : Function called when timer runs
+//           :  Payload : p : Function parameters, copied into the timer
+// 
+// Return     : int : Timer index
+//*********************************//
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setTimeout(unsigned long interval, timerCallbackParamPtr f, const Payload& p) {
+  return setupTimer(interval, 0, false, RUN_ONCE, f, p);
+}
 
 
 //*********************************//
 // Function   : setTimeout 
 // 
-// Description: This function sets up a timer to run forever every interval ms after a startDelay
+// Description: This function sets up a timer to call a member function once after interval ms
 //
-// Arguments :  unsigned long : interval : Time between timer runs (ms)
-//           :  timerCallbackPtr : f : Function called when timer runs
-//           :  T* : p : Function parameters
-//           :  
+// Arguments :  unsigned long : interval : Time before the timer runs (ms)
+//           :  void (ObjType::*)() : method : Member function called when timer runs
+//           :  ObjType* : obj : Object the member function is called on
 // 
 // Return     : int : Timer index
 //*********************************//
-template <typename T>
-template <typename ObjType>
-int LSTimer<T>::setTimeout(unsigned long interval, void (ObjType::*method)(), ObjType* obj) {
-    TimerCallbackHelper<ObjType>::method = method;  // Store method pointer
-    return setTimeout(interval, TimerCallbackHelper<ObjType>::callback, obj);
+template<int N, typename Payload>
+template<typename ObjType>
+int LSTimer<N, Payload>::setTimeout(unsigned long interval, void (ObjType::*method)(), ObjType* obj) {
+    return setupTimer(interval, 0, false, RUN_ONCE, method, obj);
 }
 
 
@@ -375,9 +691,9 @@ int LSTimer<T>::setTimeout(unsigned long interval, void (ObjType::*method)(), Ob
 // 
 // Return     : int : Timer index (identifier for the timer)
 //*********************************//
-template<typename T>
-int LSTimer<T>::setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackPtr f) {
-  return setupTimer(interval, startDelay, true, false, n, (void *)f, NULL);
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackPtr f) {
+  return setupTimer(interval, startDelay, true, n, f);
 }
 
 
@@ -389,14 +705,34 @@ int LSTimer<T>::setTimer(unsigned long interval, unsigned long startDelay, unsig
 // Arguments :  unsigned long : interval : Time between function calls (ms)
 //             unsigned long : startDelay : Delay before the first call (ms)
 //             unsigned n     : n         : Number of times to call the function
-//             timerCallbackPtr : f         : Function to be called repeatedly
-//             p
+//             timerCallbackParamPtr : f  : Function to be called repeatedly
+//             Payload : p                : Function parameters, copied into the timer
 // 
 // Return     : int : Timer index (identifier for the timer)
 //*********************************//
-template<typename T>
-int LSTimer<T>::setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackParamPtr f, T* p) {
-  return setupTimer(interval, startDelay, true, true, n, (void *)f, p);
+template<int N, typename Payload>
+int LSTimer<N, Payload>::setTimer(unsigned long interval, unsigned long startDelay, unsigned n, timerCallbackParamPtr f, const Payload& p) {
+  return setupTimer(interval, startDelay, true, n, f, p);
+}
+
+
+//*********************************//
+// Function   : setTimer 
+// 
+// Description: This function sets up a timer to call the specified member function every interval (ms), up to n times.
+//
+// Arguments :  unsigned long : interval : Time between function calls (ms)
+//             unsigned long : startDelay : Delay before the first call (ms)
+//             unsigned n     : n         : Number of times to call the function
+//             void (ObjType::*)() : method : Member function to be called repeatedly
+//             ObjType* : obj             : Object the member function is called on
+// 
+// Return     : int : Timer index (identifier for the timer)
+//*********************************//
+template<int N, typename Payload>
+template<typename ObjType>
+int LSTimer<N, Payload>::setTimer(unsigned long interval, unsigned long startDelay, unsigned n, void (ObjType::*method)(), ObjType* obj) {
+  return setupTimer(interval, startDelay, true, n, method, obj);
 }
 
 
@@ -409,8 +745,8 @@ int LSTimer<T>::setTimer(unsigned long interval, unsigned long startDelay, unsig
 // 
 // Return     : int : freeTimerIndex : Index of first free timer
 //*********************************//
-template<typename T>
-int LSTimer<T>::startTimer() {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::startTimer() {
     int freeTimerIndex;
 
     freeTimerIndex = findFirstFreeSlot();
@@ -419,9 +755,8 @@ int LSTimer<T>::startTimer() {
     }
 
     timer[freeTimerIndex].intervalTime = 0;
-    timer[freeTimerIndex].callback = 0;
-    timer[freeTimerIndex].param = 0;
-    timer[freeTimerIndex].hasParam = 0;
+    timer[freeTimerIndex].invoke = NULL;
+    timer[freeTimerIndex].object = NULL;
     timer[freeTimerIndex].maxNumRuns = 1;
     timer[freeTimerIndex].enabled = true;
     timer[freeTimerIndex].startDelayTime = 0;
@@ -443,9 +778,9 @@ int LSTimer<T>::startTimer() {
 // 
 // Return     : unsigned long : Time elasped since last run
 //*********************************//
-template<typename T>
-unsigned long LSTimer<T>::elapsedTime(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+unsigned long LSTimer<N, Payload>::elapsedTime(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         return 0;
     }
 
@@ -467,9 +802,9 @@ unsigned long LSTimer<T>::elapsedTime(int timerId) {
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-int LSTimer<T>::deleteTimer(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::deleteTimer(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         Serial.print("ERROR: Invalid Timer ID: ");
         Serial.println(timerId);
         return -1; // ERROR: Invalid timer ID
@@ -483,7 +818,7 @@ int LSTimer<T>::deleteTimer(int timerId) {
     }
 
     // Don't decrease the number of timers if the slot is already empty
-    if (timer[timerId].callback != NULL) {
+    if (timer[timerId].invoke != NULL) {
         memset(&timer[timerId], 0, sizeof (timer_t));
         timer[timerId].previousTime = millis();
 
@@ -503,9 +838,9 @@ int LSTimer<T>::deleteTimer(int timerId) {
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-void LSTimer<T>::restartTimer(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+void LSTimer<N, Payload>::restartTimer(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         Serial.print("ERROR: Invalid Timer ID: ");
         Serial.println(timerId);
         return;
@@ -513,6 +848,7 @@ void LSTimer<T>::restartTimer(int timerId) {
 
     timer[timerId].previousTime = millis();
     timer[timerId].numRuns = 0;
+    deadlineValid = false;  // The start delay may be shorter than the current deadline
 }
 
 
@@ -525,9 +861,9 @@ void LSTimer<T>::restartTimer(int timerId) {
 // 
 // Return     : boolean : true - timer enabled, false - timer disabled
 //*********************************//
-template<typename T>
-boolean LSTimer<T>::isEnabled(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+boolean LSTimer<N, Payload>::isEnabled(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         Serial.print("ERROR: Invalid Timer ID: ");
         Serial.println(timerId);
         return false;
@@ -540,21 +876,26 @@ boolean LSTimer<T>::isEnabled(int timerId) {
 //*********************************//
 // Function   : enable 
 // 
-// Description: Enable the specified timer
+// Description: Enable the specified timer. A timer that was disabled before its first run
+//              counts its start delay from now.
 //
 // Arguments :  int : timerId : Index of the timer to enable
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-void LSTimer<T>::enable(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+void LSTimer<N, Payload>::enable(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         Serial.print("ERROR: Invalid Timer ID: ");
         Serial.println(timerId);
         return;
     }
 
+    if (!timer[timerId].enabled && timer[timerId].numRuns == 0) {
+        timer[timerId].previousTime = millis();
+    }
     timer[timerId].enabled = true;
+    deadlineValid = false;  // The timer may be due before the current deadline
 }
 
 
@@ -567,9 +908,9 @@ void LSTimer<T>::enable(int timerId) {
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-void LSTimer<T>::disable(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+void LSTimer<N, Payload>::disable(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         Serial.print("ERROR: Invalid Timer ID: ");
         Serial.println(timerId);
         return;
@@ -588,15 +929,15 @@ void LSTimer<T>::disable(int timerId) {
 // 
 // Return     : void
 //*********************************//
-template<typename T>
-void LSTimer<T>::toggle(int timerId) {
-    if (timerId >= MAX_TIMERS) {
+template<int N, typename Payload>
+void LSTimer<N, Payload>::toggle(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
         Serial.print("ERROR: Invalid Timer ID: ");
         Serial.println(timerId);
         return;
     }
 
-    timer[timerId].enabled = !timer[timerId].enabled;
+    (timer[timerId].enabled) ? disable(timerId) : enable(timerId);
 }
 
 
@@ -609,8 +950,8 @@ void LSTimer<T>::toggle(int timerId) {
 // 
 // Return     : int : numTimers : Number of timers
 //*********************************//
-template<typename T>
-int LSTimer<T>::getNumTimers() {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::getNumTimers() {
     return numTimers;
 }
 
@@ -622,11 +963,127 @@ int LSTimer<T>::getNumTimers() {
 //
 // Arguments :  int : timerId : Index of timer to get number of runs
 // 
-// Return     : int : numRuns : The number of times the timer has been activated.
+// Return     : int : numRuns : The number of times the timer has been activated, 0 for an invalid timer ID.
 //*********************************//
-template<typename T>
-int LSTimer<T>::getNumRuns(int timerId) {
+template<int N, typename Payload>
+int LSTimer<N, Payload>::getNumRuns(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
+        return 0;
+    }
+
     return timer[timerId].numRuns;
 }
 
+
+//*********************************//
+// Function   : setCatchupPolicy 
+// 
+// Description: Sets what the specified timer does when run() is called late and periods were missed.
+//              TIMER_CATCHUP_BURST runs once for every missed period, back to back. This is the default.
+//              TIMER_CATCHUP_COALESCE runs once for all missed periods.
+//              TIMER_CATCHUP_SKIP doesn't run until the next period when whole periods were missed.
+//
+// Arguments :  int : timerId : Index of timer
+//           :  unsigned : policy : Catch-up policy (TIMER_CATCHUP_*)
+// 
+// Return     : void
+//*********************************//
+template<int N, typename Payload>
+void LSTimer<N, Payload>::setCatchupPolicy(int timerId, unsigned policy) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
+        Serial.print("ERROR: Invalid Timer ID: ");
+        Serial.println(timerId);
+        return;
+    }
+    if (policy > TIMER_CATCHUP_SKIP) {
+        Serial.print("ERROR: Invalid Catch-up Policy: ");
+        Serial.println(policy);
+        return;
+    }
+
+    timer[timerId].catchupPolicy = policy;
+}
+
+
+//*********************************//
+// Function   : getStats 
+// 
+// Description: Returns the lateness and callback execution time statistics of the specified timer.
+//
+// Arguments :  int : timerId : Index of timer
+// 
+// Return     : timerStatsStruct : Statistics of the runs since the timer was set up or the statistics were reset
+//*********************************//
+template<int N, typename Payload>
+timerStatsStruct LSTimer<N, Payload>::getStats(int timerId) {
+    timerStatsStruct stats;
+    memset(&stats, 0, sizeof (timerStatsStruct));
+
+    if (timerId < 0 || timerId >= MAX_TIMERS || timer[timerId].numSamples == 0) {
+        return stats;
+    }
+
+    stats.numSamples = timer[timerId].numSamples;
+    stats.latenessMin = timer[timerId].latenessMin;
+    stats.latenessAverage = timer[timerId].latenessTotal / timer[timerId].numSamples;
+    stats.latenessMax = timer[timerId].latenessMax;
+    stats.missedPeriods = timer[timerId].missedPeriods;
+    stats.executionTimeAverage = (unsigned long)(timer[timerId].executionTimeTotal / timer[timerId].numSamples);
+    stats.executionTimeMax = timer[timerId].executionTimeMax;
+    stats.activeTimeAverage = (unsigned long)(timer[timerId].activeTimeTotal / timer[timerId].numSamples);
+    stats.activeTimeMax = timer[timerId].activeTimeMax;
+    return stats;
+}
+
+
+//*********************************//
+// Function   : resetStats 
+// 
+// Description: Clears the lateness and execution time statistics of the specified timer.
+//
+// Arguments :  int : timerId : Index of timer
+// 
+// Return     : void
+//*********************************//
+template<int N, typename Payload>
+void LSTimer<N, Payload>::resetStats(int timerId) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
+        return;
+    }
+
+    timer[timerId].numSamples = 0;
+    timer[timerId].latenessMin = 0;
+    timer[timerId].latenessMax = 0;
+    timer[timerId].latenessTotal = 0;
+    timer[timerId].missedPeriods = 0;
+    timer[timerId].executionTimeMax = 0;
+    timer[timerId].executionTimeTotal = 0;
+    timer[timerId].activeTimeMax = 0;
+    timer[timerId].activeTimeTotal = 0;
+    memset(timer[timerId].executionTimeHistogram, 0, sizeof (timer[timerId].executionTimeHistogram));
+}
+
+
+//*********************************//
+// Function   : getHistogram 
+// 
+// Description: Copies the callback execution time histogram of the specified timer.
+//              Bin 0 counts callbacks under 64 us, bin n counts callbacks from 64 * 2^(n-1) us to under 64 * 2^n us,
+//              and the last bin counts all longer callbacks.
+//
+// Arguments :  int : timerId : Index of timer
+//           :  unsigned long* : histogram : Array of TIMER_HISTOGRAM_BINS counts to fill
+// 
+// Return     : void
+//*********************************//
+template<int N, typename Payload>
+void LSTimer<N, Payload>::getHistogram(int timerId, unsigned long* histogram) {
+    if (timerId < 0 || timerId >= MAX_TIMERS) {
+        memset(histogram, 0, TIMER_HISTOGRAM_BINS * sizeof (unsigned long));
+        return;
+    }
+
+    memcpy(histogram, timer[timerId].executionTimeHistogram, TIMER_HISTOGRAM_BINS * sizeof (unsigned long));
+}
+
 #endif 
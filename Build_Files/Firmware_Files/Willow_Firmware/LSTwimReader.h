@@ -0,0 +1,313 @@
+/*
+* File: LSTwimReader.h
+* Firmware: Willow
+* Developed by: MakersMakingChange
+* Version: v1.0rc (April 4 2025)
+  License: GPL v3.0 or later
+
+  Copyright (C) 2024 - 2025 Neil Squire Society
+  This program is free software: you can redistribute it and/or modify it under the terms of
+  the GNU General Public License as published by the Free Software Foundation,
+  either version 3 of the License, or (at your option) any later version.
+  This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU General Public License for more details.
+  You should have received a copy of the GNU General Public License along with this program.
+  If not, see <http://www.gnu.org/licenses/>
+*/
+
+// Header definition
+#ifndef _LSTWIMREADER_H
+#define _LSTWIMREADER_H
+
+#include <Arduino.h>
+
+#define TWIM_READER_BUFFER_SIZE 10           // Largest read in bytes
+#define TWIM_READER_PERIPHERAL NRF_TWIM1     // Wire uses TWIM0 (and its interrupt), TWIM1 is free on the nRF52840
+#define TWIM_READER_WIRE_PERIPHERAL NRF_TWIM0
+#define TWIM_READER_IRQN SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQn
+#define TWIM_READER_IRQ_PRIORITY 3           // Lowest priority allowed to call FreeRTOS FromISR functions with the SoftDevice running
+#define TWIM_READER_STOP_TIMEOUT 2           // Longest wait for the STOPPED event after a read is stopped (ms)
+#define TWIM_READER_RECOVERY_CLOCKS 9        // SCL pulses that let a device finish the byte it is sending and release SDA
+#define TWIM_READER_RECOVERY_HALF_PERIOD 5   // SCL half period while clearing the bus (us, 100 kHz)
+
+// TWIM1 and its interrupt handler are shared with SPIM1/SPIS1/TWIS1 and with Wire1
+#if defined(WIRE_INTERFACES_COUNT) && (WIRE_INTERFACES_COUNT > 1)
+#error "LSTwimReader uses TWIM1, which Wire1 also uses. Build with a single Wire interface."
+#endif
+
+// Asynchronous I2C register reader using the TWIM peripheral with EasyDMA.
+// startRead() starts the transfer and waitForRead() blocks the calling task until it completes,
+// so the CPU is free for other tasks (or sleeps) while EasyDMA fills the buffer.
+// The reader shares the Wire pins: Wire's peripheral is disabled for the length of a transfer,
+// so the caller must hold the bus (g_i2cBusLock) from startRead() until waitForRead() returns.
+class LSTwimReader {
+  public:
+    LSTwimReader();
+    bool begin(uint8_t address, uint32_t frequency);   // Set up the peripheral for a device on the Wire pins
+    bool startRead(uint8_t length);                    // Start reading length bytes from the device
+    bool waitForRead(uint32_t timeout);                // Block the calling task until the read completes or times out (ms)
+    const uint8_t* getReadyBuffer();                   // Bytes of the last successful read
+    uint32_t getFrequency();                           // Bus frequency in Hz actually used
+    bool recoverBus();                                 // Clock out a device holding SDA low and send a STOP
+    static void readerInterrupt();                     // Called from the TWIM interrupt
+
+  private:
+    uint8_t _buffer[TWIM_READER_BUFFER_SIZE];          // Filled by EasyDMA
+    uint8_t _readLength;                               // Length of the transfer in progress
+    uint8_t _address;                                  // 7 bit device address
+    uint32_t _frequency;                               // Bus frequency in Hz
+    uint32_t _wireEnable;                              // Saved Wire peripheral state, restored after each transfer
+    volatile bool _readFailed;                         // Set by the interrupt on a bus error
+    bool _readActive;                                  // A transfer was started and not yet waited for
+    SemaphoreHandle_t _readDone;                       // Given by the interrupt when the transfer stops
+    static LSTwimReader* _activeReader;                // Reader that owns the interrupt
+};
+
+LSTwimReader* LSTwimReader::_activeReader = NULL;
+
+//*********************************//
+// Function   : LSTwimReader
+//
+// Description: Construct LSTwimReader
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+LSTwimReader::LSTwimReader() {
+  _readLength = 0;
+  _address = 0;
+  _frequency = 0;
+  _wireEnable = 0;
+  _readFailed = false;
+  _readActive = false;
+  _readDone = NULL;
+  memset(_buffer, 0, sizeof(_buffer));
+}
+
+//*********************************//
+// Function   : begin
+//
+// Description: Set up the TWIM peripheral for a device on the Wire pins.
+//              The nRF52840 TWIM supports 100, 250 and 400 kHz. Other frequencies use the fastest supported rate below them.
+//
+// Arguments :  address : uint8_t : 7 bit device address
+//              frequency : uint32_t : Bus frequency in Hz
+//
+// Return     : success : bool : False if the completion semaphore could not be created
+//*********************************//
+bool LSTwimReader::begin(uint8_t address, uint32_t frequency) {
+  if (_readDone == NULL) {
+    _readDone = xSemaphoreCreateBinary();
+  }
+  if (_readDone == NULL) {
+    return false;
+  }
+
+  _address = address;
+  if (frequency >= 400000) {
+    _frequency = 400000;
+  } else if (frequency >= 250000) {
+    _frequency = 250000;
+  } else {
+    _frequency = 100000;
+  }
+
+  TWIM_READER_PERIPHERAL->ENABLE = TWIM_ENABLE_ENABLE_Disabled;
+  TWIM_READER_PERIPHERAL->PSEL.SCL = g_ADigitalPinMap[PIN_WIRE_SCL];
+  TWIM_READER_PERIPHERAL->PSEL.SDA = g_ADigitalPinMap[PIN_WIRE_SDA];
+  TWIM_READER_PERIPHERAL->FREQUENCY = (_frequency == 400000) ? TWIM_FREQUENCY_FREQUENCY_K400 :
+                                      (_frequency == 250000) ? TWIM_FREQUENCY_FREQUENCY_K250 : TWIM_FREQUENCY_FREQUENCY_K100;
+  TWIM_READER_PERIPHERAL->ADDRESS = _address;
+  TWIM_READER_PERIPHERAL->SHORTS = TWIM_SHORTS_LASTRX_STOP_Msk;     // Send STOP after the last byte without CPU involvement
+
+  _activeReader = this;
+  NVIC_SetPriority(TWIM_READER_IRQN, TWIM_READER_IRQ_PRIORITY);
+  NVIC_ClearPendingIRQ(TWIM_READER_IRQN);
+  NVIC_EnableIRQ(TWIM_READER_IRQN);
+  return true;
+}
+
+//*********************************//
+// Function   : startRead
+//
+// Description: Start an EasyDMA read into the buffer. Returns as soon as the transfer has started.
+//              The caller must hold the bus until waitForRead() returns.
+//
+// Arguments :  length : uint8_t : Number of bytes to read (1 to TWIM_READER_BUFFER_SIZE)
+//
+// Return     : success : bool : False if the reader is not set up, a read is already active, or the length is invalid
+//*********************************//
+bool LSTwimReader::startRead(uint8_t length) {
+  if (_readDone == NULL || _readActive || length == 0 || length > TWIM_READER_BUFFER_SIZE) {
+    return false;
+  }
+
+  _readLength = length;
+  _readFailed = false;
+  _readActive = true;
+  xSemaphoreTake(_readDone, 0);                                      // Drop a completion left over from a timed out read
+
+  _wireEnable = TWIM_READER_WIRE_PERIPHERAL->ENABLE;                 // Only one peripheral may drive the pins at a time
+  TWIM_READER_WIRE_PERIPHERAL->ENABLE = TWIM_ENABLE_ENABLE_Disabled;
+
+  TWIM_READER_PERIPHERAL->RXD.PTR = (uintptr_t) _buffer;
+  TWIM_READER_PERIPHERAL->RXD.MAXCNT = _readLength;
+  TWIM_READER_PERIPHERAL->EVENTS_STOPPED = 0;
+  TWIM_READER_PERIPHERAL->EVENTS_ERROR = 0;
+  TWIM_READER_PERIPHERAL->ERRORSRC = TWIM_READER_PERIPHERAL->ERRORSRC;   // Write 1 to clear
+  TWIM_READER_PERIPHERAL->INTENSET = TWIM_INTENSET_STOPPED_Msk | TWIM_INTENSET_ERROR_Msk;
+  TWIM_READER_PERIPHERAL->ENABLE = TWIM_ENABLE_ENABLE_Enabled;
+  TWIM_READER_PERIPHERAL->TASKS_STARTRX = 1;
+  return true;
+}
+
+//*********************************//
+// Function   : waitForRead
+//
+// Description: Block the calling task until the active read completes. Other tasks and the idle task run meanwhile.
+//              On timeout the read is stopped and the peripheral is only disabled once it has stopped, for at most
+//              TWIM_READER_STOP_TIMEOUT. If it doesn't stop (the bus is held low) its interrupts are turned off, so a late
+//              event can't complete the next read. Gives the pins back to Wire.
+//
+// Arguments :  timeout : uint32_t : Maximum wait in ms
+//
+// Return     : success : bool : True if all bytes were read. getReadyBuffer() then points to them.
+//*********************************//
+bool LSTwimReader::waitForRead(uint32_t timeout) {
+  if (!_readActive) {
+    return false;
+  }
+
+  bool success = (xSemaphoreTake(_readDone, pdMS_TO_TICKS(timeout)) == pdTRUE) && !_readFailed;
+
+  if (!success && !_readFailed) {                                    // Timed out, a bus error has already stopped the read
+    TWIM_READER_PERIPHERAL->TASKS_STOP = 1;
+    if (xSemaphoreTake(_readDone, pdMS_TO_TICKS(TWIM_READER_STOP_TIMEOUT)) != pdTRUE) {   // Given by the interrupt on STOPPED
+      TWIM_READER_PERIPHERAL->INTENCLR = TWIM_INTENCLR_STOPPED_Msk | TWIM_INTENCLR_ERROR_Msk;
+    }
+  }
+  TWIM_READER_PERIPHERAL->ENABLE = TWIM_ENABLE_ENABLE_Disabled;
+  TWIM_READER_WIRE_PERIPHERAL->ENABLE = _wireEnable;
+  _readActive = false;
+  return success;
+}
+
+//*********************************//
+// Function   : getReadyBuffer
+//
+// Description: Get the bytes of the last read. Only valid after waitForRead() returned true, until the next startRead().
+//
+// Arguments :  void
+//
+// Return     : buffer : const uint8_t* : Bytes of the last read
+//*********************************//
+const uint8_t* LSTwimReader::getReadyBuffer() {
+  return _buffer;
+}
+
+//*********************************//
+// Function   : getFrequency
+//
+// Description: Get the bus frequency used for reads
+//
+// Arguments :  void
+//
+// Return     : frequency : uint32_t : Bus frequency in Hz
+//*********************************//
+uint32_t LSTwimReader::getFrequency() {
+  return _frequency;
+}
+
+//*********************************//
+// Function   : recoverBus
+//
+// Description: Clear the bus after a transfer was interrupted and a device holds SDA low waiting for more clocks.
+//              Both TWIM peripherals let go of the pins, SCL is pulsed up to TWIM_READER_RECOVERY_CLOCKS times until
+//              SDA is released, then a STOP is sent. The pins are driven open drain: low as an output, high by the pull-up.
+//              Wire's peripheral is enabled again afterwards, Wire.begin() sets its pin drive back up.
+//              The caller must hold the bus. Works without begin().
+//
+// Arguments :  void
+//
+// Return     : released : bool : True if SDA is high after the STOP
+//*********************************//
+bool LSTwimReader::recoverBus() {
+  uint32_t wireEnable = TWIM_READER_WIRE_PERIPHERAL->ENABLE;
+  TWIM_READER_WIRE_PERIPHERAL->ENABLE = TWIM_ENABLE_ENABLE_Disabled;
+  TWIM_READER_PERIPHERAL->ENABLE = TWIM_ENABLE_ENABLE_Disabled;
+
+  pinMode(PIN_WIRE_SDA, INPUT_PULLUP);
+  pinMode(PIN_WIRE_SCL, INPUT_PULLUP);
+  delayMicroseconds(TWIM_READER_RECOVERY_HALF_PERIOD);
+
+  for (int clock = 0; clock < TWIM_READER_RECOVERY_CLOCKS && digitalRead(PIN_WIRE_SDA) == LOW; clock++) {
+    digitalWrite(PIN_WIRE_SCL, LOW);
+    pinMode(PIN_WIRE_SCL, OUTPUT);
+    delayMicroseconds(TWIM_READER_RECOVERY_HALF_PERIOD);
+    pinMode(PIN_WIRE_SCL, INPUT_PULLUP);
+    delayMicroseconds(TWIM_READER_RECOVERY_HALF_PERIOD);
+  }
+
+  // STOP: SDA rises while SCL is high
+  digitalWrite(PIN_WIRE_SDA, LOW);
+  pinMode(PIN_WIRE_SDA, OUTPUT);
+  delayMicroseconds(TWIM_READER_RECOVERY_HALF_PERIOD);
+  pinMode(PIN_WIRE_SDA, INPUT_PULLUP);
+  delayMicroseconds(TWIM_READER_RECOVERY_HALF_PERIOD);
+  bool released = (digitalRead(PIN_WIRE_SDA) == HIGH);
+
+  TWIM_READER_WIRE_PERIPHERAL->ENABLE = wireEnable;
+  return released;
+}
+
+//*********************************//
+// Function   : readerInterrupt
+//
+// Description: Handle TWIM events. A stopped read is checked for length and wakes the waiting task.
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+void LSTwimReader::readerInterrupt() {
+  LSTwimReader* reader = _activeReader;
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+  if (TWIM_READER_PERIPHERAL->EVENTS_ERROR) {
+    TWIM_READER_PERIPHERAL->EVENTS_ERROR = 0;
+    TWIM_READER_PERIPHERAL->TASKS_STOP = 1;                          // STOPPED follows and completes the read
+    if (reader != NULL) {
+      reader->_readFailed = true;
+    }
+  }
+
+  if (TWIM_READER_PERIPHERAL->EVENTS_STOPPED) {
+    TWIM_READER_PERIPHERAL->EVENTS_STOPPED = 0;
+    (void) TWIM_READER_PERIPHERAL->EVENTS_STOPPED;                   // Read back so the event is cleared before returning
+    if (reader != NULL) {
+      if (TWIM_READER_PERIPHERAL->RXD.AMOUNT != reader->_readLength) {
+        reader->_readFailed = true;
+      }
+      xSemaphoreGiveFromISR(reader->_readDone, &higherPriorityTaskWoken);
+    }
+  }
+
+  portYIELD_FROM_ISR(higherPriorityTaskWoken);
+}
+
+//*********************************//
+// Function   : SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler
+//
+// Description: TWIM_READER_PERIPHERAL interrupt
+//
+// Arguments :  void
+//
+// Return     : void
+//*********************************//
+extern "C" void SPIM1_SPIS1_TWIM1_TWIS1_SPI1_TWI1_IRQHandler(void) {
+  LSTwimReader::readerInterrupt();
+}
+
+#endif
@@ -70,6 +70,8 @@ class LSUSBMouse {
     bool timedOut = false;
   protected:
     uint8_t _buttons;
+    uint8_t _lastReportButtons;                    // Buttons of the last report the host accepted
+    bool _lastReportIdle;                          // True if the last report the host accepted had no motion
     void buttons(uint8_t b);
     Adafruit_USBD_HID usb_hid;
 };
@@ -144,9 +146,7 @@ class LSUSBGamepad {
     inline void end(void);
 	  inline void wakeup(void);
     inline void send(void);
-    inline bool GamepadReport(void* data, size_t length) {
-        return this->usb_hid.sendReport(0, data, (uint8_t)length);
-    };
+    inline bool GamepadReport(void* data, size_t length);
     inline void write(void);
     inline void write(void *report);
     inline void press(uint8_t b);
@@ -161,6 +161,9 @@ class LSUSBGamepad {
     bool usbRetrying = false;
   protected:
     HID_GamepadReport_Data_t _report;
+    HID_GamepadReport_Data_t _lastReport;          // Last report the host accepted
+    bool _lastReportSent;
+    uint32_t _lastReportMillis;
     uint32_t startMillis;
     Adafruit_USBD_HID usb_hid;
 };
@@ -180,6 +183,8 @@ LSUSBMouse::LSUSBMouse(void)
 void LSUSBMouse::begin(void)
 {
   _buttons = 0;
+  _lastReportButtons = 0;
+  _lastReportIdle = false;                      // Always send the first report
   this->usb_hid.setPollInterval(1);
   this->usb_hid.setReportDescriptor(mouse_desc_hid_report, sizeof(mouse_desc_hid_report));
   //this->usb_hid.setStringDescriptor(MOUSE_DESCRIPTOR); // TODO this causes TinyUSB to crash 2025-Jan-20
@@ -233,6 +238,12 @@ void LSUSBMouse::wakeup(void)
 
 void LSUSBMouse::mouseReport(int8_t b, int8_t x, int8_t y, int8_t wheel, int8_t pan) 
 {
+  // A report with no motion only matters if the buttons changed or the previous report moved
+  bool isIdleReport = (x == 0 && y == 0 && wheel == 0 && pan == 0);
+  if (isIdleReport && _lastReportIdle && b == _lastReportButtons) {
+    return;
+  }
+
 	wakeup();
   unsigned long timerTimeoutBegin = millis();
     
@@ -245,8 +256,10 @@ void LSUSBMouse::mouseReport(int8_t b, int8_t x, int8_t y, int8_t wheel, int8_t
         break;
       }
     }
+    _lastReportIdle = false;                    // Resend next time unless the host accepts this report
     if (isReady()){
-      usb_hid.mouseReport(RID_MOUSE,b,x,y,wheel,pan);
+      _lastReportIdle = usb_hid.mouseReport(RID_MOUSE,b,x,y,wheel,pan) && isIdleReport;
+      _lastReportButtons = b;
       timedOut = false;
     }
     
@@ -479,12 +492,20 @@ void LSUSBGamepad::begin(void)
   }
   
   // Release all the buttons and center joystick
+  _lastReportSent = false;
   end();
   startMillis = millis();
 }
 
 void LSUSBGamepad::send(void)
 {
+  // Skip reports the host already has, apart from a periodic keep-alive that never wakes a suspended host
+  if (_lastReportSent && memcmp(&_report, &_lastReport, sizeof(_report)) == 0) {
+    if (USBDevice.suspended() || (millis() - _lastReportMillis) < CONF_HID_KEEP_ALIVE_PERIOD) {
+      return;
+    }
+  }
+
   if (startMillis != millis()) {
   wakeup();
   unsigned long timerTimeoutBegin = millis();
@@ -515,6 +536,16 @@ void LSUSBGamepad::wakeup(void)
     }
 }
 
+bool LSUSBGamepad::GamepadReport(void* data, size_t length)
+{
+  _lastReportSent = this->usb_hid.sendReport(0, data, (uint8_t)length);
+  if (_lastReportSent) {
+    memcpy(&_lastReport, data, sizeof(_lastReport));
+    _lastReportMillis = millis();
+  }
+  return _lastReportSent;
+}
+
 void LSUSBGamepad::write(void)
 {
   wakeup();
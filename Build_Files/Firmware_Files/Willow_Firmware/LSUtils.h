@@ -82,4 +82,32 @@ typedef struct
   uint8_t accEndSpeed;
 } accStruct;
 
+// Settings structure ( RAM copy of the settings file, one field per settings key )
+typedef struct
+{
+  int modelNumber;                   // MN
+  int versionMajor;                  // VN1
+  int versionMinor;                  // VN2
+  int versionRevision;               // VN3
+  char deviceID[12];                 // ID
+  int operatingMode;                 // OM
+  int communicationMode;             // CM
+  int cursorSpeedLevel;              // SS
+  int scrollLevel;                   // SL
+  int pressureMode;                  // PM
+  float sipThreshold;                // ST
+  float puffThreshold;               // PT
+  int accelerationLevel;             // AV
+  float innerDeadzone;               // IZ
+  float outerDeadzone;               // OZ
+  pointFloatType calibration[5];     // CA0 - CA4
+  int soundMode;                     // SM
+  int lightMode;                     // LM
+  int lightBrightnessLevel;          // LL
+  int debugMode;                     // DM
+  float filterCutoff;                // FC
+  float filterBeta;                  // FB
+  uint8_t rangeMap[64];              // CR
+} settingsStruct;
+
 #endif
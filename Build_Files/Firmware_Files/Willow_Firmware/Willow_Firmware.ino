@@ -26,6 +26,7 @@
 #include "LSUSB.h"
 #include "LSBLE.h"
 #include "LSCircularBuffer.h"
+#include "LSBusLock.h"
 #include "LSInput.h"
 #include "LSJoystick.h"
 #include "LSMemory.h"
@@ -34,7 +35,7 @@
 #include "LSWatchdog.h"
 
 // Unique ID
-String g_deviceUID = "";  // Global variable for storing unique identifier for board
+const char* g_deviceUID = "";  // Global variable for storing unique identifier for board
 
 // Communication mode and debug mode variables
 int g_comMode;        // 0 = None , 1 = USB , 2 = Wireless
@@ -61,6 +62,8 @@ bool g_usbIsConnected = false;  // USB Connection state
 bool g_displayConnected = false;                   // Display connection state
 bool g_joystickSensorConnected = false;            // Joystick sensor connection state
 
+LSBusLock g_i2cBusLock;                            // Shared by the display and the joystick sampling task
+
 // LED module variables
 ledStateStruct* ledCurrentState = new ledStateStruct;  // pointer to LED current state structure
 bool ledActionEnabled = false;
@@ -79,19 +82,19 @@ LSInput is(inputSwitchPinArray, CONF_SWITCH_NUMBER);  // Create an instance of t
 
 // Timer related variables
 int actionTimerId[1];  // 1 action timer
-LSTimer<int> actionTimer;
+LSTimer<CONF_ACTION_TIMER_SIZE, int> actionTimer;
 
-int calibrationTimerId[2];  // 2 calibration timers: 0 - , 1-
-LSTimer<int> calibrationTimer;
+int calibrationTimerId;  // Timer of the current calibration state
+LSTimer<CONF_CALIBRATION_TIMER_SIZE, int> calibrationTimer;
 
-int pollTimerId[10];  // 9 poll timers
-LSTimer<void> pollTimer;
+int pollTimerId[CONF_POLL_TIMER_SIZE];  // One per polling timer ID (CONF_TIMER_*)
+LSTimer<CONF_POLL_TIMER_SIZE> pollTimer;
 
-int ledTimerId[5];  // 3 LED timers 0 - startup feedback, 1 - IBM, 2- normal blinks, 3 - Bluetooth Status, 4 - error
-LSTimer<ledStateStruct> ledStateTimer;
+int ledTimerId[CONF_TIMER_LED_MAX + 1];  // LED timers 0 - startup feedback, 1 - IBM, 2- normal blinks, 3 - Bluetooth Status, 4 - error
+LSTimer<CONF_LED_TIMER_SIZE, ledStateStruct> ledStateTimer;
 
 int usbConnectTimerId[1];
-LSTimer<int> usbConnectTimer;
+LSTimer<CONF_USB_TIMER_SIZE> usbConnectTimer;
 
 unsigned int g_usbAttempt = 0;
 unsigned int g_usbConnectDelay = CONF_USB_HID_INIT_DELAY;
@@ -106,6 +109,10 @@ bool canOutputAction = true;
 bool g_startupCenterReset = true;
 bool g_resetCenterComplete = false;  // global variable for center reset status
 bool g_calibrationError = false;     // Global variable for error in full calibration
+int g_calibrationState = CONF_CALIB_STATE_IDLE;  // Current state of the joystick calibration state machine
+int g_calibrationCorner = 0;                     // Corner measured by the full calibration (1-4)
+int g_calibrationReadingCount = 0;               // Readings taken in the current calibration state
+bool g_calibrationFull = false;                  // Is the center measured as part of the full calibration?
 
 bool settingsEnabled = false;  // Serial input settings command mode enabled or disabled
 
@@ -114,6 +121,12 @@ unsigned long beginMillis;
 unsigned long beforeComOpMillis;
 unsigned long afterComOpMillis;
 
+// Idle statistics since the last TI,0 request
+unsigned long g_idleStartTime = 0;    // micros() when the statistics were cleared
+unsigned long g_idleStartCycles = 0;  // DWT cycle count when the statistics were cleared, the counter stops while the core sleeps
+unsigned long g_idleDelayTime = 0;    // Time the loop task spent in the idle delay (us)
+unsigned long g_idleLoopCount = 0;    // Number of loop passes
+
 
 // Create instances of classes
 LSMemory mem;     // Create an instance of LSMemory for managing flash memory.
@@ -166,6 +179,7 @@ void setup() {
 
   checkSafeMode();  // Check to see if we need to boot in safe mode.
 
+  g_i2cBusLock.begin();  // Create the I2C bus lock before any device is started
   checkI2C();  // Check that I2C devices are connected
 
   if (g_displayConnected) {
@@ -198,9 +212,12 @@ void setup() {
 
   if (g_joystickSensorConnected) {
     initJoystick();  // Initialize Joystick
+    if (CONF_JOY_SAMPLE_RATE > 0) {
+      js.beginSampling(CONF_JOY_SAMPLE_RATE);  // Read the sensor at a fixed rate, joystickLoop processes the queued samples
+    }
   }
 
-  //initAcceleration();  // Initialize Cursor Acceleration // TODO Implement acceleration
+  initAcceleration();  // Initialize Cursor Acceleration
 
   initDebug();  // Initialize Debug Mode operation
 
@@ -216,6 +233,13 @@ void setup() {
   pollTimerId[CONF_TIMER_SCREEN] = pollTimer.setInterval(CONF_SCREEN_POLL_RATE, 0, screenLoop);
   pollTimerId[CONF_TIMER_USB] = pollTimer.setInterval(CONF_USB_POLL_RATE, 0, usbConnectionLoop);
   pollTimerId[CONF_TIMER_WATCHDOG] = pollTimer.setInterval(CONF_WATCHDOG_POLL_RATE, 0, watchdogLoop);
+  pollTimerId[CONF_TIMER_MEMORY] = pollTimer.setInterval(CONF_MEMORY_POLL_RATE, 0, memoryLoop);
+
+  // Polling loops read the current state, so a late poll runs once instead of repeating for every missed period
+  for (int timerIndex = 0; timerIndex <= CONF_TIMER_MAX; timerIndex++) {
+    pollTimer.setCatchupPolicy(pollTimerId[timerIndex], TIMER_CATCHUP_COALESCE);
+  }
+  pollTimer.setCatchupPolicy(pollTimerId[CONF_TIMER_SCREEN], TIMER_CATCHUP_SKIP);  // Late frames are out of date, wait for the next one
 
 
   pollTimer.disable(CONF_TIMER_USB); // TODO 2025-Feb-21 Disable usbConnectionLoop until implemented
@@ -225,6 +249,8 @@ void setup() {
   }
 
 
+  resetIdleStats();
+
   //enablePoll(true);
 
   ledActionEnabled = true;
@@ -290,9 +316,72 @@ void loop() {
 
   pollTimer.run();  // Timer for normal joystick functions
   
+  buzzerLoop();  // Later notes of the buzzer sounds
+
 
   settingsEnabled = serialSettings(settingsEnabled);  // Process Serial API commands
-  //yield();
+
+  if (CONF_ENABLE_IDLE) {
+    idleLoop();  // Sleep until the next timer is due
+  }
+  g_idleLoopCount++;
+}
+
+
+//***IDLE LOOP FUNCTION***//
+// Function   : idleLoop
+//
+// Description: This function sleeps until the earliest timer deadline of the timers run in loop().
+//              The delay blocks the loop task so the FreeRTOS idle task can put the core in WFE until
+//              the tick interrupt or another event wakes it. The sleep is capped by CONF_IDLE_MAX_TIME
+//              so serial commands are still read promptly, and skipped when serial input is waiting.
+//              Disabled timers don't count (LSTimer::nextDeadline). The joystick sampling task still wakes
+//              the core every 1000 / CONF_JOY_SAMPLE_RATE ms (5 ms at 200 Hz), so that is the longest the core
+//              sleeps at a time while the loop task waits. The time spent here is reported by TI,0.
+//
+// Parameters :  void
+//
+// Return     : void
+//*********************************//
+void idleLoop() {
+  unsigned long idleTime = CONF_IDLE_MAX_TIME;
+
+  idleTime = min(idleTime, ledStateTimer.nextDeadline());
+  idleTime = min(idleTime, usbConnectTimer.nextDeadline());
+  if (g_joystickSensorConnected) {
+    idleTime = min(idleTime, calibrationTimer.nextDeadline());
+  }
+  if (g_operatingMode == CONF_OPERATING_MODE_GAMEPAD) {
+    idleTime = min(idleTime, actionTimer.nextDeadline());
+  }
+  idleTime = min(idleTime, pollTimer.nextDeadline());
+  idleTime = min(idleTime, buzzer.nextDeadline());
+
+  if (idleTime > 0 && !Serial.available()) {
+    unsigned long delayStart = micros();
+    delay(idleTime);
+    g_idleDelayTime += micros() - delayStart;
+  }
+}
+
+
+//***RESET IDLE STATISTICS FUNCTION***//
+// Function   : resetIdleStats
+//
+// Description: This function clears the idle statistics and starts the DWT cycle counter they use.
+//
+// Parameters :  void
+//
+// Return     : void
+//*********************************//
+void resetIdleStats() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;  // Enable the trace unit and start the DWT cycle counter
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  g_idleStartTime = micros();
+  g_idleStartCycles = DWT->CYCCNT;
+  g_idleDelayTime = 0;
+  g_idleLoopCount = 0;
 }
 
 
@@ -608,7 +697,21 @@ void initMemory() {
   if (USB_DEBUG) { Serial.println("USBDEBUG: initMemory()"); }
   mem.begin();  // Begin memory
   //mem.format();    // DON'T UNCOMMENT - use a factory reset through the serial if need to wipe memory (FR,1:1)
-  mem.initialize(CONF_SETTINGS_FILE, CONF_SETTINGS_JSON);  // Initialize flash memory to store settings
+  mem.initialize(CONF_SETTINGS_FILE, CONF_SETTINGS_JSON, CONF_SETTINGS_JSON_FILE);  // Load settings record, migrating the json settings file if needed
+  if (USB_DEBUG) { Serial.print("USBDEBUG: settings record status: "); Serial.println(mem.getRecordStatus()); }
+}
+
+//***MEMORY LOOP FUNCTION***//
+// Function   : memoryLoop
+//
+// Description: This function writes settings changes to flash once they have settled
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void memoryLoop() {
+  mem.update();
 }
 
 //***RESET MEMORY FUNCTION***//
@@ -624,7 +727,7 @@ void initMemory() {
 void resetMemory() {
   if (USB_DEBUG) { Serial.println("USBDEBUG: resetMemory()"); }
   mem.format();                                            // Format and remove existing text files in flash memory
-  mem.initialize(CONF_SETTINGS_FILE, CONF_SETTINGS_JSON);  // Initialize flash memory to store settings
+  mem.initialize(CONF_SETTINGS_FILE, CONF_SETTINGS_JSON, CONF_SETTINGS_JSON_FILE);  // Initialize flash memory to store settings
 }
 
 //***Read UID FUNCTION***//
@@ -811,7 +914,7 @@ void buzzerSoundOff() {
 //****************************************//
 void initAcceleration() {
   if (USB_DEBUG) { Serial.println("USBDEBUG: initAcceleration()"); }
-  //  acceleration=getJoystickAcceleration(false,false);
+  acceleration = getJoystickAcceleration(false, false);  // Get acceleration level stored in flash memory and apply the response curve
 }
 
 //*********************************//
@@ -1069,9 +1172,12 @@ void inputLoop() {
   buttonState = ib.getInputState();
   switchState = is.getInputState();
 
-  // Evaluate Output Actions
-  evaluateOutputAction(buttonState, buttonActionMaxTime, buttonActionSize, buttonActionProperty);
-  evaluateOutputAction(switchState, switchActionMaxTime, switchActionSize, switchActionProperty);
+  // Evaluate Output Actions. Inputs are still read during a calibration but not evaluated, so they don't change its LEDs:
+  // startCalibration released any held action, and endCalibration selects the joystick poll timer an input would have selected
+  if (g_calibrationState == CONF_CALIB_STATE_IDLE) {
+    evaluateOutputAction(buttonState, buttonActionMaxTime, buttonActionSize, buttonActionProperty);
+    evaluateOutputAction(switchState, switchActionMaxTime, switchActionSize, switchActionProperty);
+  }
 
 }
 
@@ -1120,6 +1226,28 @@ void releaseOutputAction() {
   canOutputAction = true;
 }
 
+//***SELECT JOYSTICK POLL TIMER FUNCTION***//
+// Function   : selectJoystickPollTimer
+//
+// Description: This function runs joystickLoop at the scroll poll rate while the scroll action is on, and at the
+//              joystick poll rate otherwise.
+//
+// Parameters : void
+//
+// Return     : void
+//****************************************//
+void selectJoystickPollTimer() {
+  if(g_joystickSensorConnected){
+    if (outputAction == CONF_ACTION_SCROLL) {
+      pollTimer.enable(CONF_TIMER_SCROLL);
+      pollTimer.disable(CONF_TIMER_JOYSTICK);
+    } else {
+      pollTimer.enable(CONF_TIMER_JOYSTICK);
+      pollTimer.disable(CONF_TIMER_SCROLL);
+    }
+  }
+}
+
 //***EVALUATE OUTPUT ACTION FUNCTION***//
 // Function   : evaluateOutputAction
 //
@@ -1150,16 +1278,7 @@ void evaluateOutputAction(inputStateStruct actionState, unsigned long actionMaxE
     setLedDefault();
   }
 
-  // Code to switch between joystick controlled scroll and joystick controlled cursor movement
-  if(g_joystickSensorConnected){
-    if (outputAction == CONF_ACTION_SCROLL) {
-      pollTimer.enable(CONF_TIMER_SCROLL);
-      pollTimer.disable(CONF_TIMER_JOYSTICK);
-    } else if (outputAction != CONF_ACTION_SCROLL) {
-      pollTimer.enable(CONF_TIMER_JOYSTICK);
-      pollTimer.disable(CONF_TIMER_SCROLL);
-    }
-  }
+  selectJoystickPollTimer();  // Switch between joystick controlled scroll and joystick controlled cursor movement
 
   // Loop over all possible outputs
   for (int actionIndex = 0; actionIndex < actionSize && canEvaluateAction && canOutputAction; actionIndex++) {
@@ -1519,7 +1638,7 @@ void gamepadButtonClick(int buttonNumber) {
   if (buttonNumber > 0 && buttonNumber <= 8) {
     gamepad.press(buttonNumber - 1);
     gamepad.send();
-    actionTimerId[0] = actionTimer.setTimeout(CONF_BUTTON_PRESS_DELAY, gamepadButtonRelease, (int*)buttonNumber);
+    actionTimerId[0] = actionTimer.setTimeout(CONF_BUTTON_PRESS_DELAY, gamepadButtonRelease, buttonNumber);
   }
 }
 
@@ -1528,12 +1647,12 @@ void gamepadButtonClick(int buttonNumber) {
 //
 // Description: This function performs button release action.
 //
-// Parameters : int* : args
+// Parameters : args : int* : button number stored in the timer
 //
 // Return     : void
 //****************************************//
 void gamepadButtonRelease(int* args) {
-  int buttonNumber = (int)args;
+  int buttonNumber = *args;
   if (buttonNumber > 0 && buttonNumber <= 8) {
     gamepad.release(buttonNumber - 1);
     gamepad.send();
@@ -1576,192 +1695,273 @@ void initJoystick() {
   js.setMagnetDirection(JOY_DIRECTION_DEFAULT, JOY_DIRECTION_INVERSE);  // Set x and y magnet direction
   getJoystickInnerDeadzone(true, false);                               // Get joystick deadzone stored in flash memory
   getJoystickOuterDeadzone(true, false);                                     // Get joystick deadzone stored in flash memory
+  getJoystickFilterCutoff(true, false);                                 // Get joystick smoothing filter settings stored in flash memory
+  getJoystickFilterBeta(true, false);
   getCursorSpeed(true, false);                                          // Get joystick cursor speed stored in flash memory
   g_scrollLevel = getScrollLevel(true, false);                            // Get scroll level stored in flash memory
   setJoystickInitialization(true, false);                               // Perform joystick center initialization
   getJoystickCalibration(true, false);                                  // Get joystick calibration points stored in flash memory
+  getJoystickRangeMap(true, false);                                     // Get joystick range map stored in flash memory
+}
+
+//***START CALIBRATION FUNCTION***//
+// Function   : startCalibration
+//
+// Description: This function starts a process of the joystick calibration state machine.
+//              Center initialization, full calibration and range sweep share the state machine, so only one runs at a time.
+//              Every state is entered from a calibrationTimer callback and never waits, so loop() keeps running
+//              the watchdog, USB, BLE, serial API and screen during the whole process. Joystick sampling and
+//              joystickLoop keep running too: the calibration reads the samples they process, and no movement is output.
+//
+// Parameters : firstState : int : State to enter (CONF_CALIB_STATE_CENTER_READING, CONF_CALIB_STATE_FULL_START or CONF_CALIB_STATE_SWEEP_READING)
+//              startDelay : unsigned long : Number of milliseconds until the first state is entered
+//
+// Return     : started : bool : False if a calibration process is already running
+//****************************************//
+bool startCalibration(int firstState, unsigned long startDelay) {
+  if (g_calibrationState != CONF_CALIB_STATE_IDLE) {
+    return false;
+  }
+  g_calibrationState = CONF_CALIB_STATE_START;
+  g_calibrationFull = (firstState == CONF_CALIB_STATE_FULL_START);
+  releaseOutputAction();         // Don't keep a drag or scroll on through the calibration
+  canOutputAction = false;
+  js.setCalibrationMode(true);   // The calibration moves the joystick, don't learn drift from it
+  calibrationTimerId = calibrationTimer.setTimeout(startDelay, performCalibrationState, firstState);
+  return true;
 }
 
-//***PERFORM JOYSTICK CENTER FUNCTION***//
-// Function   : performJoystickCenter
+//***END CALIBRATION FUNCTION***//
+// Function   : endCalibration
 //
-// Description: This function performs joystick center point initialization.
+// Description: This function returns the calibration state machine to idle and resumes the output actions.
+//              No input was evaluated during the calibration, so the joystick poll timer is selected here. This also
+//              leaves the startup center reset with one joystick poll timer running instead of both.
 //
-// Parameters : * args : int : pointer of step number
+// Parameters : void
 //
 // Return     : void
 //****************************************//
-void performJoystickCenter(int* args) {
-  int stepNumber = (int)args;
-  if (USB_DEBUG) { Serial.print("USBDEBUG: performJoystickCenter("); Serial.print(stepNumber); Serial.println(")"); }
+void endCalibration() {
+  g_calibrationState = CONF_CALIB_STATE_IDLE;
+  canOutputAction = true;
+  js.setCalibrationMode(false);
+  selectJoystickPollTimer();
+}
 
-  g_resetCenterComplete = false;  // Reset the global flag
+//***PERFORM CALIBRATION STATE FUNCTION***//
+// Function   : performCalibrationState
+//
+// Description: This function enters the calibration state stored in the timer once its delay has passed.
+//
+// Parameters : args : int* : state stored in the timer
+//
+// Return     : void
+//****************************************//
+void performCalibrationState(int* args) {
+  setCalibrationState(*args);
+}
 
-  
+//***SET CALIBRATION STATE FUNCTION***//
+// Function   : setCalibrationState
+//
+// Description: This function enters a state of the joystick calibration state machine and performs its entry actions.
+//              A state ends when its readings are complete (performJoystick*Step) or its timeout fires (performCalibrationState).
+//              The range sweep records every sample update() processes until its timeout.
+//
+//              Center :    CENTER_READING -> CENTER_DONE -> IDLE
+//              Full :      FULL_START -> CORNER_READING -> CORNER_DONE ( x4 ) -> CENTER_RELEASE -> CENTER_READING -> CENTER_DONE -> FULL_DONE -> IDLE
+//              Sweep :     SWEEP_READING -> SWEEP_DONE -> IDLE
+//
+// Parameters : nextState : int : The state to enter
+//
+// Return     : void
+//****************************************//
+void setCalibrationState(int nextState) {
+  if (USB_DEBUG) { Serial.print("USBDEBUG: setCalibrationState("); Serial.print(nextState); Serial.println(")"); }
 
-  // Duration of the center point readings (500 milliseconds)
-  unsigned long readingDuration = CONF_JOY_INIT_READING_DELAY * CONF_JOY_INIT_READING_NUMBER;
+  // Time from the start of a step until its first reading, while the LEDs blink ( 500 + 150*3 milliseconds )
+  unsigned long centerReadingStart = CONF_JOY_INIT_START_DELAY + (CONF_JOY_INIT_STEP_BLINK_DELAY * ((CONF_JOY_INIT_STEP_BLINK * 2) + 1));
+  unsigned long cornerReadingStart = CONF_JOY_CALIB_STEP_DELAY + (CONF_JOY_CALIB_STEP_BLINK_DELAY * ((CONF_JOY_CALIB_STEP_BLINK * 2) + 1));
+  bool isValid = false;
+  uint8_t rangeMap[JOY_RANGE_MAP_SIZE];
+  pointFloatType centerPoint;
 
-  // (500 + 150*3) - time until start of current reading.
-  unsigned long currentReadingStart = CONF_JOY_INIT_START_DELAY + (CONF_JOY_INIT_STEP_BLINK_DELAY * ((CONF_JOY_INIT_STEP_BLINK * 2) + 1));
+  g_calibrationState = nextState;
+  g_calibrationReadingCount = 0;
 
-  // Time until start of next step. (1450 seconds )
-  unsigned long nextStepStart = currentReadingStart + readingDuration;
+  switch (nextState) {
+    case CONF_CALIB_STATE_CENTER_READING:  // Blink, then take the center readings with the joystick released
+      g_resetCenterComplete = false;
+      if (ledActionEnabled) {
+        setLedState(LED_ACTION_BLINK, CONF_JOY_INIT_STEP_BLINK_COLOR, CONF_JOY_INIT_LED_NUMBER, CONF_JOY_INIT_STEP_BLINK, CONF_JOY_INIT_STEP_BLINK_DELAY, led.getLedBrightness());
+        performLedAction(ledCurrentState);  // LED Feedback to show start of performJoystickCenterStep
+      }
+      calibrationTimerId = calibrationTimer.setTimer(CONF_JOY_INIT_READING_DELAY, centerReadingStart, CONF_JOY_INIT_READING_NUMBER, performJoystickCenterStep, nextState);
+      break;
 
-  pointFloatType centerPoint;
+    case CONF_CALIB_STATE_CENTER_DONE:  // Evaluate the center point using values in the buffer
+      js.evaluateInputCenter();
+      js.setMinimumRadius();              // Update minimum radius of operation
+      centerPoint = js.getInputCenter();  // Get the new center for API output
+      printResponseFloatPoint(true, true, true, 0, "IN,1", true, centerPoint);
+      if (g_calibrationFull) {
+        setCalibrationState(CONF_CALIB_STATE_FULL_DONE);
+        break;
+      }
+      setLedDefault();  // Set default led feedback
+      g_resetCenterComplete = true;
+      endCalibration();
 
-  if (stepNumber == 0)  // STEP 0: Joystick Compensation Center Point
-  {
-    if (ledActionEnabled) {
-      setLedState(LED_ACTION_BLINK, CONF_JOY_INIT_STEP_BLINK_COLOR, CONF_JOY_INIT_LED_NUMBER, CONF_JOY_INIT_STEP_BLINK, CONF_JOY_INIT_STEP_BLINK_DELAY, led.getLedBrightness());
-      performLedAction(ledCurrentState);  // LED Feedback to show start of performJoystickCalibrationStep
-    }
-    // Start timer to get 5 reading every 100 ms
-    calibrationTimerId[1] = calibrationTimer.setTimer(CONF_JOY_INIT_READING_DELAY, currentReadingStart, CONF_JOY_INIT_READING_NUMBER, performJoystickCenterStep, (int*)stepNumber);
-    ++stepNumber;
-    // Start exit step
-    calibrationTimerId[0] = calibrationTimer.setTimeout(nextStepStart, performJoystickCenter, (int*)stepNumber);
-  } else {
-    js.evaluateInputCenter();           // Evaluate the center point using values in the buffer
-    js.setMinimumRadius();              // Update minimum radius of operation
-    centerPoint = js.getInputCenter();  // Get the new center for API output
-    printResponseFloatPoint(true, true, true, 0, "IN,1", true, centerPoint);
-    calibrationTimer.deleteTimer(0);  // Delete timer
-    setLedDefault();                  // Set default led feedback
-    canOutputAction = true;
-    g_resetCenterComplete = true;
+      if (g_startupCenterReset) {  // Checks variable to only play sound and show splash screen on startup
+        readyToUse();              // TODO JDMc 2025-Jan-24 Probably want sound to play after every calibration to indicate joystick is ready to be used again.
+      }
+      if (screen.showCenterResetComplete) {  // Checks variable so center reset complete page only shows if accessed from menu, not on startup or during full calibration
+        screen.centerResetCompletePage();
+      }
+      g_startupCenterReset = false;
+      break;
 
-    if (g_startupCenterReset) {  // Checks variable to only play sound and show splash screen on startup
-      readyToUse();              // TODO JDMc 2025-Jan-24 Probably want sound to play after every calibration to indicate joystick is ready to be used again.
-    }
-    if (screen.showCenterResetComplete) {  // Checks variable so center reset complete page only shows if accessed from menu, not on startup or during full calibration
-      screen.centerResetCompletePage();
-    }
-    g_startupCenterReset = false;
+    case CONF_CALIB_STATE_FULL_START:  // Full calibration started
+      g_resetCenterComplete = false;
+      g_calibrationError = false;
+      js.clear();                              // Clear previous calibration values
+      setLedState(LED_ACTION_BLINK, CONF_JOY_CALIB_START_LED_COLOR, CONF_JOY_CALIB_LED_NUMBER, CONF_JOY_CALIB_STEP_BLINK, CONF_JOY_CALIB_STEP_BLINK_DELAY, led.getLedBrightness());
+      performLedAction(ledCurrentState);
+      g_calibrationCorner = 1;
+      calibrationTimerId = calibrationTimer.setTimeout(cornerReadingStart, performCalibrationState, CONF_CALIB_STATE_CORNER_READING);
+      break;
+
+    case CONF_CALIB_STATE_CORNER_READING:  // Prompt, then take the readings of g_calibrationCorner with the joystick held in the corner
+      g_calibrationError = false;
+      screen.fullCalibrationPrompt(g_calibrationCorner);
+      buzzer.calibCornerTone();
+      setLedState(LED_ACTION_BLINK, CONF_JOY_CALIB_STEP_BLINK_COLOR, CONF_JOY_CALIB_LED_NUMBER, CONF_JOY_CALIB_STEP_BLINK, CONF_JOY_CALIB_STEP_BLINK_DELAY, led.getLedBrightness());
+      performLedAction(ledCurrentState);   // LED Feedback to show start of performJoystickCalibrationStep
+      js.zeroInputMax(g_calibrationCorner);  // Clear the existing calibration value
+      calibrationTimerId = calibrationTimer.setTimer(CONF_JOY_CALIB_READING_DELAY, cornerReadingStart, CONF_JOY_CALIB_READING_NUMBER, performJoystickCalibrationStep, nextState);
+      break;
+
+    case CONF_CALIB_STATE_CORNER_DONE:  // Pause before the next corner, long enough to read the error message if the corner was too small
+      if (g_calibrationError) {
+        screen.fullCalibrationPrompt(CONF_JOY_CALIB_ERROR);
+      }
+      if (g_calibrationCorner < 4) {  // Corners 1-4
+        ++g_calibrationCorner;
+        calibrationTimerId = calibrationTimer.setTimeout(g_calibrationError ? CONF_JOY_CALIB_ERROR_DELAY : CONF_JOY_CALIB_START_DELAY, performCalibrationState, CONF_CALIB_STATE_CORNER_READING);
+      } else {
+        calibrationTimerId = calibrationTimer.setTimeout(g_calibrationError ? CONF_JOY_CALIB_ERROR_DELAY : CONF_JOY_CALIB_START_DELAY, performCalibrationState, CONF_CALIB_STATE_CENTER_RELEASE);
+      }
+      break;
+
+    case CONF_CALIB_STATE_CENTER_RELEASE:  // Ask to release the joystick before the center readings
+      g_calibrationError = false;
+      screen.fullCalibrationPrompt(5);  // Center prompt
+      buzzer.calibCenterTone();
+      calibrationTimerId = calibrationTimer.setTimeout(CONF_JOY_INIT_START_DELAY, performCalibrationState, CONF_CALIB_STATE_CENTER_READING);
+      break;
+
+    case CONF_CALIB_STATE_FULL_DONE:  // Full calibration ended
+      setLedState(LED_ACTION_BLINK, CONF_JOY_CALIB_START_LED_COLOR, CONF_JOY_CALIB_LED_NUMBER, CONF_JOY_CALIB_STEP_BLINK, CONF_JOY_CALIB_STEP_BLINK_DELAY, led.getLedBrightness());  // Turn off Led's
+      performLedAction(ledCurrentState);
+      js.setMinimumRadius();  // Update the minimum cursor operating radius
+      setLedDefault();
+      g_resetCenterComplete = true;
+      g_calibrationFull = false;
+      endCalibration();
+      screen.fullCalibrationPrompt(6);  // Complete prompt
+      break;
+
+    case CONF_CALIB_STATE_SWEEP_READING:  // Record the samples while the joystick is circled along the edge of its range
+      setLedState(LED_ACTION_ON, CONF_JOY_SWEEP_LED_COLOR, CONF_JOY_SWEEP_LED_NUMBER, 0, 0, led.getLedBrightness());
+      performLedAction(ledCurrentState);
+      buzzer.calibCornerTone();
+      js.beginRangeSweep();
+      calibrationTimerId = calibrationTimer.setTimeout(CONF_JOY_SWEEP_DURATION, performCalibrationState, CONF_CALIB_STATE_SWEEP_DONE);
+      break;
+
+    case CONF_CALIB_STATE_SWEEP_DONE:  // Range sweep ended
+      js.update();                     // Record the samples still queued
+      isValid = js.endRangeSweep();    // Keep the previous range map if the sweep missed too many directions
+      if (isValid) {
+        js.getRangeMap(rangeMap);
+        mem.writeBytes(CONF_SETTINGS_FILE, "CR", rangeMap, JOY_RANGE_MAP_SIZE);  // Store the range map in Flash Memory
+      }
+      buzzer.calibCenterTone();
+      setLedDefault();
+      endCalibration();
+      printResponseInt(true, true, isValid, isValid ? 0 : 3, "CR,1", true, 1);
+      break;
+
+    default:
+      endCalibration();
+      break;
   }
 }
 
 //***PERFORM JOYSTICK CENTER STEP FUNCTION***//
 // Function   : performJoystickCenterStep
 //
-// Description: This function performs the actual joystick center point initialization step.
+// Description: This function takes one joystick center point reading. The last reading ends the CONF_CALIB_STATE_CENTER_READING state.
 //
-// Parameters : * args : int : pointer of step number
+// Parameters : args : int* : state stored in the timer
 //
 // Return     : void
 //****************************************//
 void performJoystickCenterStep(int* args) {
+  ++g_calibrationReadingCount;
 
   // Turn on and set the second led to orange to indicate start of the process
-  if (calibrationTimer.getNumRuns(calibrationTimerId[1]) == 1 && ledActionEnabled) {  // Turn LED's ON when timer is running for first time
+  if (g_calibrationReadingCount == 1 && ledActionEnabled) {  // Turn LED's ON for the first reading
     setLedState(LED_ACTION_ON, CONF_JOY_INIT_LED_COLOR, CONF_JOY_INIT_LED_NUMBER, 0, 0, led.getLedBrightness());
     performLedAction(ledCurrentState);
   }
   // Push new center values to be evaluated at the end of the process
+  js.update();  // Process the queued samples so the reading is current
   js.updateInputCenterBuffer();
 
-  // Turn off the second led to orange to indicate end of the process
-  if (calibrationTimer.getNumRuns(calibrationTimerId[1]) == CONF_JOY_INIT_READING_NUMBER && ledActionEnabled) {  // Turn LED's OFF when timer is running for last time
-    setLedState(LED_ACTION_OFF, LED_CLR_NONE, CONF_JOY_INIT_LED_NUMBER, 0, 0, led.getLedBrightness());
-    performLedAction(ledCurrentState);
+  if (g_calibrationReadingCount == CONF_JOY_INIT_READING_NUMBER) {  // Turn LED's OFF after the last reading
+    if (ledActionEnabled) {
+      setLedState(LED_ACTION_OFF, LED_CLR_NONE, CONF_JOY_INIT_LED_NUMBER, 0, 0, led.getLedBrightness());
+      performLedAction(ledCurrentState);
+    }
+    setCalibrationState(CONF_CALIB_STATE_CENTER_DONE);
   }
 }
 
-//***PERFORM JOYSTICK CALIBRATION FUNCTION***//
-// Function   : performJoystickCalibration
-//
-// Description: This function performs joystick maximum point calibration in a recursive fashion.
-//
-// Parameters : * args : int : pointer of step number
-//
-// Return     : void
-//****************************************//
-void performJoystickCalibration(int* args) {
-  g_resetCenterComplete = false;
-  g_calibrationError = false;
-  int stepNumber = (int)args;
-
-  // Duration of the max corner reading ( 2 seconds )
-  unsigned long readingDuration = CONF_JOY_CALIB_READING_DELAY * CONF_JOY_CALIB_READING_NUMBER;
-
-  // Time until start of current reading
-  unsigned long currentReadingStart = CONF_JOY_CALIB_STEP_DELAY + (CONF_JOY_CALIB_STEP_BLINK_DELAY * ((CONF_JOY_CALIB_STEP_BLINK * 2) + 1));
-
-  // Time until start of next step. (1.5 + (3*300) seconds )
-  unsigned long nextStepStart = currentReadingStart + readingDuration + CONF_JOY_CALIB_START_DELAY;  // Time until start of next step. ( 2.4 + 2 + 1 seconds )
-
-  if (stepNumber == 0) {                     // STEP 0: Calibration started
-    pollTimer.disable(CONF_TIMER_JOYSTICK);  // Temporarily disable joystick data polling timer
-    pollTimer.disable(CONF_TIMER_INPUT);
-    setLedState(LED_ACTION_BLINK, CONF_JOY_CALIB_START_LED_COLOR, CONF_JOY_CALIB_LED_NUMBER, CONF_JOY_CALIB_STEP_BLINK, CONF_JOY_CALIB_STEP_BLINK_DELAY, led.getLedBrightness());
-    performLedAction(ledCurrentState);
-    ++stepNumber;
-    calibrationTimerId[0] = calibrationTimer.setTimeout(currentReadingStart, performJoystickCalibration, (int*)stepNumber);  // Start next step
-  } else if (stepNumber < 5) {                                                                                               // STEP 1-4: Joystick Calibration Corner Points
-    screen.fullCalibrationPrompt(stepNumber);
-    buzzer.calibCornerTone();
-    setLedState(LED_ACTION_BLINK, CONF_JOY_CALIB_STEP_BLINK_COLOR, CONF_JOY_CALIB_LED_NUMBER, CONF_JOY_CALIB_STEP_BLINK, CONF_JOY_CALIB_STEP_BLINK_DELAY, led.getLedBrightness());
-    performLedAction(ledCurrentState);  // LED Feedback to show start of performJoystickCalibrationStep
-    js.zeroInputMax(stepNumber);        // Clear the existing calibration value
-
-    calibrationTimerId[1] = calibrationTimer.setTimer(CONF_JOY_CALIB_READING_DELAY, currentReadingStart, CONF_JOY_CALIB_READING_NUMBER, performJoystickCalibrationStep, (int*)stepNumber);
-    ++stepNumber;
-    // Set LED's feedback to show step is already started and get the max reading for the quadrant/step
-
-    calibrationTimerId[0] = calibrationTimer.setTimeout(nextStepStart, performJoystickCalibration, (int*)stepNumber);  // Start next step
-  } else if (stepNumber == 5) {                                                                                        // STEP 5 : Joystick center point initialization
-    screen.fullCalibrationPrompt(stepNumber);
-    buzzer.calibCenterTone();
-    setJoystickInitialization(false, false);
-    ++stepNumber;
-    calibrationTimerId[0] = calibrationTimer.setTimeout(nextStepStart, performJoystickCalibration, (int*)stepNumber);  // Start next step
-  }
-
-  else  // STEP 6: Calibration ended
-  {
-    setLedState(LED_ACTION_BLINK, CONF_JOY_CALIB_START_LED_COLOR, CONF_JOY_CALIB_LED_NUMBER, CONF_JOY_CALIB_STEP_BLINK, CONF_JOY_CALIB_STEP_BLINK_DELAY, led.getLedBrightness());  // Turn off Led's
-    performLedAction(ledCurrentState);
-    js.setMinimumRadius();  // Update the minimum cursor operating radius
-    setLedDefault();
-    canOutputAction = true;
-    g_resetCenterComplete = true;
-    pollTimer.enable(CONF_TIMER_JOYSTICK);     // Re-Enable joystick data polling
-    pollTimer.enable(CONF_TIMER_SCROLL);       // Re-enable scroll data polling
-    pollTimer.enable(CONF_TIMER_INPUT);
-    screen.fullCalibrationPrompt(stepNumber);  // update
-    g_calibrationError = false;
-  }
-}
 //***PERFORM JOYSTICK CALIBRATION STEP FUNCTION***//
 // Function   : performJoystickCalibrationStep
 //
-// Description: This function performs the actual joystick maximum point calibration step in a recursive fashion.
+// Description: This function takes one joystick corner reading of g_calibrationCorner and keeps the largest.
+//              After the last reading the corner is checked, stored and the CONF_CALIB_STATE_CORNER_READING state ends.
 //
-// Parameters : * args : int : pointer of step number
+// Parameters : args : int* : state stored in the timer
 //
 // Return     : void
 //****************************************//
 void performJoystickCalibrationStep(int* args) {
-  int stepNumber = (int)args;
-  String stepKey = "CA" + String(stepNumber);       // Key to write new calibration point to Flash memory
-  String stepCommand = "CA," + String(stepNumber);  // Command to output calibration point via serial
+  int stepNumber = g_calibrationCorner;
+  char stepKey[4];                                  // Key to write new calibration point to Flash memory
+  char stepCommand[5];                              // Command to output calibration point via serial
   pointFloatType maxPoint;
   int magnetZDirection = js.getMagnetZDirection();
 
-  //Serial.print("Step started: ");   // TODO: Remove these print statements
-  //Serial.print(stepNumber);
-  //Serial.print(" numRuns: ");
-  //Serial.println(calibrationTimer.getNumRuns(calibrationTimerId[1]));
+  ++g_calibrationReadingCount;
 
   // Turn on and set all leds to orange to indicate start of the process // TODO Jake update to non-neopixel LEDS
-  if (calibrationTimer.getNumRuns(calibrationTimerId[1]) == 1) {  // Turn LLED's ON when timer is running for first time
+  if (g_calibrationReadingCount == 1) {  // Turn LED's ON for the first reading
     setLedState(LED_ACTION_ON, CONF_JOY_CALIB_LED_COLOR, CONF_JOY_CALIB_LED_NUMBER, 0, 0, led.getLedBrightness());
     performLedAction(ledCurrentState);
   }
 
+  js.update();                            // Process the queued samples so the reading is current
   maxPoint = js.getInputMax(stepNumber);  // Get maximum x and y for the step number
 
-  // Check for calibration errors
+  if (g_calibrationReadingCount < CONF_JOY_CALIB_READING_NUMBER) {
+    return;
+  }
+
+  // Check for calibration errors once the user had all readings to reach the corner
   if ((abs(maxPoint.x) < CONF_JOY_CALIB_CORNER_MIN) || (abs(maxPoint.y) < CONF_JOY_CALIB_CORNER_MIN)) {
     pointFloatType tempDefaultPoint = { 0, 0 };
     switch (stepNumber) {
@@ -1783,18 +1983,14 @@ void performJoystickCalibrationStep(int* args) {
     g_calibrationError = true;
   }
 
-  // Turn off all the LEDs to orange to indicate end of the process
-  if (calibrationTimer.getNumRuns(calibrationTimerId[1]) == CONF_JOY_CALIB_READING_NUMBER) {  // Turn LED's OFF when timer is running for last time
-    mem.writePoint(CONF_SETTINGS_FILE, stepKey, maxPoint);                                    // Store the point in Flash Memory
-    setLedState(LED_ACTION_OFF, LED_CLR_NONE, CONF_JOY_CALIB_LED_NUMBER, 0, 0, led.getLedBrightness());
-    performLedAction(ledCurrentState);
-    printResponseFloatPoint(true, true, true, 0, stepCommand, true, maxPoint);
-    if (g_calibrationError) {
-      screen.fullCalibrationPrompt(CONF_JOY_CALIB_ERROR);
-      delay(3000);  // TODO 2025-Feb-02 Why the delay?
-      g_calibrationError = false;
-    }
-  }
+  // Turn off all the LEDs to indicate end of the process
+  snprintf(stepKey, sizeof(stepKey), "CA%d", stepNumber);
+  snprintf(stepCommand, sizeof(stepCommand), "CA,%d", stepNumber);
+  mem.writePoint(CONF_SETTINGS_FILE, stepKey, maxPoint);  // Store the point in Flash Memory
+  setLedState(LED_ACTION_OFF, LED_CLR_NONE, CONF_JOY_CALIB_LED_NUMBER, 0, 0, led.getLedBrightness());
+  performLedAction(ledCurrentState);
+  printResponseFloatPoint(true, true, true, 0, stepCommand, true, maxPoint);
+  setCalibrationState(CONF_CALIB_STATE_CORNER_DONE);
 }
 
 //***JOYSTICK LOOP FUNCTION***//
@@ -1812,7 +2008,8 @@ void joystickLoop() {
 
   pointIntType joyOutPoint = js.getXYOut();  // Read the filtered values
 
-  if (g_resetCenterComplete) {     // Don't output joystick movement until the center position has been reset
+  // Don't output joystick movement until the center position has been reset, or while a calibration reads the samples
+  if (g_resetCenterComplete && g_calibrationState == CONF_CALIB_STATE_IDLE) {
     performJoystick(joyOutPoint);  // Perform joystick move action
   }
 
@@ -2114,7 +2311,7 @@ void ledReadyFeedback() {
 //****************************************//
 void startupFeedback() {
   if (USB_DEBUG) { Serial.println("USBDEBUG: startupFeedback"); }
-  ledTimerId[CONF_TIMER_LED_STARTUP] = ledStateTimer.setTimeout(ledCurrentState->ledBlinkTime, ledStartupEffect, ledCurrentState);
+  ledTimerId[CONF_TIMER_LED_STARTUP] = ledStateTimer.setTimeout(ledCurrentState->ledBlinkTime, ledStartupEffect, *ledCurrentState);
 
   //ledTimerId[CONF_TIMER_LED_ERROR] = ledStateTimer.setTimer(CONF_ERROR_LED_BLINK_DELAY, blinkStartDelay, ((errorBlinks * 2) + 1), ledErrorEffect);
 }
@@ -2170,7 +2367,7 @@ void ledStartupEffect(ledStateStruct* args) {
   // if (args->ledColorNumber < MAX_LED_COLORS) {
   //   led.setLedColor(args->ledNumber, args->ledColorNumber, args->ledBrightness);
   //   setLedState(args->ledAction, (args->ledColorNumber) + 1, args->ledNumber, args->ledBlinkNumber, (args->ledBlinkTime), args->ledBrightness);
-  //   ledTimerId[CONF_TIMER_LED_STARTUP] = ledStateTimer.setTimeout(ledCurrentState->ledBlinkTime, ledStartupEffect, ledCurrentState);
+  //   ledTimerId[CONF_TIMER_LED_STARTUP] = ledStateTimer.setTimeout(ledCurrentState->ledBlinkTime, ledStartupEffect, *ledCurrentState);
   // } else if (args->ledColorNumber == MAX_LED_COLORS) {
   //   ledActionEnabled = true;
   //   enablePoll(true);
@@ -2191,7 +2388,7 @@ void ledIBMEffect(ledStateStruct* args) {
   if (args->ledColorNumber < MAX_LED_COLORS) {
     led.setLedColor(args->ledNumber, args->ledColorNumber, args->ledBrightness);
     setLedState(args->ledAction, (args->ledColorNumber) + 1, args->ledNumber, args->ledBlinkNumber, (args->ledBlinkTime), args->ledBrightness);
-    ledTimerId[CONF_TIMER_LED_IBM] = ledStateTimer.setTimeout(ledCurrentState->ledBlinkTime, ledIBMEffect, ledCurrentState);
+    ledTimerId[CONF_TIMER_LED_IBM] = ledStateTimer.setTimeout(ledCurrentState->ledBlinkTime, ledIBMEffect, *ledCurrentState);
   } else if (args->ledColorNumber == MAX_LED_COLORS) {
     ledActionEnabled = true;
     enablePoll(true);
@@ -2314,7 +2511,7 @@ void turnLedOn(ledStateStruct* args) {
 //****************************************//
 void blinkLed(ledStateStruct* args) {
   int blinkOffset = 0;  // number of milliseconds to delay start of blink
-  ledTimerId[CONF_TIMER_LED_BLINK] = ledStateTimer.setTimer(args->ledBlinkTime, blinkOffset, ((args->ledBlinkNumber) * 2) + 1, ledBlinkEffect, ledCurrentState);
+  ledTimerId[CONF_TIMER_LED_BLINK] = ledStateTimer.setTimer(args->ledBlinkTime, blinkOffset, ((args->ledBlinkNumber) * 2) + 1, ledBlinkEffect, *ledCurrentState);
 }
 
 //***SET DEFAULT LED EFFECT FUNCTION***//
@@ -2446,6 +2643,9 @@ void softwareReset() {
   gamepad.end();
   btmouse.end();
 
+  mem.commit();  // Write any pending settings changes before reset
+
+  buzzer.finish();  // loop() stops here, play the rest of the shutdown sound
   delay(3000);
   screen.clear();
   